@@ -0,0 +1,200 @@
+/**
+ * \file acompanhamento.cpp
+ * \brief Implementação do acompanhamento incremental de um arquivo que cresce.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "acompanhamento.hpp"
+
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <ios>
+#include <iostream>
+#include <string>
+
+/**
+ * \brief Tamanho do buffer usado para ler os bytes acrescentados, em bytes.
+ */
+static const std::size_t TAMANHO_BUFFER_ACOMPANHAMENTO = 64 * 1024;
+
+/**
+ * \brief Abre o arquivo e começa a observá-lo.
+ *
+ * \param nome_arquivo O nome do arquivo a ser acompanhado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto.
+ */
+AcompanhadorArquivo::AcompanhadorArquivo(const std::string& nome_arquivo, std::uint32_t configuracao)
+    : nome_(nome_arquivo), arquivo_(nome_arquivo), contador_(configuracao), buffer_(TAMANHO_BUFFER_ACOMPANHAMENTO),
+      posicao_(0), inotify_(-1), observacao_(-1) {
+#ifdef __linux__
+    inotify_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    observar();
+}
+
+AcompanhadorArquivo::~AcompanhadorArquivo() {
+    if (inotify_ >= 0) {
+        ::close(inotify_);
+    }
+}
+
+/**
+ * \brief Passa a observar o arquivo aberto no momento, deixando de observar o anterior.
+ */
+void AcompanhadorArquivo::observar() {
+#ifdef __linux__
+    if (inotify_ < 0) {
+        return;
+    }
+    if (observacao_ >= 0) {
+        ::inotify_rm_watch(inotify_, observacao_);
+    }
+    observacao_ = ::inotify_add_watch(inotify_, nome_.c_str(),
+                                      IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF);
+#endif
+}
+
+/**
+ * \brief Lê e conta os bytes acrescentados desde a última atualização.
+ *
+ * O descritor permanece aberto entre as atualizações, então cada leitura continua exatamente de
+ * onde a anterior parou. Depois de ler até o fim, verifica se o nome ainda aponta para o mesmo
+ * arquivo; se não, o arquivo novo é aberto e lido desde o início.
+ *
+ * \return Verdadeiro se a contagem mudou.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+ */
+bool AcompanhadorArquivo::atualizar() {
+    bool mudou = false;
+    for (;;) {
+        struct stat aberto;
+        if (::fstat(arquivo_.descritor(), &aberto) != 0) {
+            throw std::ios_base::failure("Erro ao ler o arquivo.");
+        }
+        if (S_ISREG(aberto.st_mode) && static_cast<std::uint64_t>(aberto.st_size) < posicao_) {
+            // Arquivo truncado: o conteúdo contado não existe mais
+            contador_ = ContadorIncremental(contador_.configuracao());
+            posicao_ = 0;
+            ::lseek(arquivo_.descritor(), 0, SEEK_SET);
+            mudou = true;
+        }
+
+        for (;;) {
+            ssize_t lidos = ::read(arquivo_.descritor(), buffer_.data(), buffer_.size());
+            if (lidos < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::ios_base::failure("Erro ao ler o arquivo.");
+            }
+            if (lidos == 0) {
+                break;
+            }
+            contador_.alimentar(buffer_.data(), static_cast<std::size_t>(lidos));
+            posicao_ += static_cast<std::uint64_t>(lidos);
+            mudou = true;
+        }
+
+        struct stat pelo_nome;
+        if (::stat(nome_.c_str(), &pelo_nome) != 0 ||
+            (pelo_nome.st_ino == aberto.st_ino && pelo_nome.st_dev == aberto.st_dev)) {
+            return mudou;
+        }
+        // Rotação: o arquivo antigo foi lido até o fim e a contagem continua no novo
+        contador_.finalizar();
+        arquivo_ = Arquivo(nome_);
+        posicao_ = 0;
+        observar();
+        mudou = true;
+    }
+}
+
+/**
+ * \brief Espera uma modificação no arquivo.
+ *
+ * \param tempo_ms O tempo máximo de espera, em milissegundos.
+ * \return Verdadeiro se o arquivo foi modificado antes do fim do tempo.
+ */
+bool AcompanhadorArquivo::aguardar(int tempo_ms) {
+#ifdef __linux__
+    if (inotify_ >= 0) {
+        struct pollfd espera = {inotify_, POLLIN, 0};
+        if (::poll(&espera, 1, tempo_ms) <= 0) {
+            return false;
+        }
+        // Descarta os eventos: o que importa é apenas que houve modificação
+        alignas(struct inotify_event) char eventos[4096];
+        while (::read(inotify_, eventos, sizeof(eventos)) > 0) {
+        }
+        return true;
+    }
+#endif
+    ::usleep(static_cast<useconds_t>(tempo_ms) * 1000);
+    return true;
+}
+
+/**
+ * \brief Exibe a contagem atual, completa ou apenas as palavras mais frequentes.
+ *
+ * \param contagem O mapa que contém as palavras e suas contagens.
+ * \param top_k O número de palavras a exibir; zero exibe todas, em ordem alfabética.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+ */
+static void exibir_atualizacao(const std::map<std::wstring, int>& contagem, std::size_t top_k,
+                               std::uint32_t configuracao) {
+    if (top_k == 0) {
+        imprimir_contagem(contagem, configuracao);
+    } else {
+        imprimir_mais_frequentes(contagem, top_k);
+    }
+    std::wcout << std::endl;
+}
+
+/**
+ * \brief Função para acompanhar um arquivo e exibir a contagem sempre que ele mudar.
+ *
+ * Modificações que chegam antes do fim do intervalo são contadas imediatamente, mas a exibição
+ * é adiada até o intervalo terminar, para que um log muito ativo não gere uma exibição por
+ * escrita.
+ *
+ * \param nome_arquivo O nome do arquivo a ser acompanhado.
+ * \param intervalo_ms O intervalo mínimo entre duas exibições, em milissegundos.
+ * \param top_k Se diferente de zero, exibe apenas as `top_k` palavras mais frequentes.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto ou lido.
+ */
+void acompanhar_arquivo(const std::string& nome_arquivo, int intervalo_ms, std::size_t top_k,
+                        std::uint32_t configuracao) {
+    typedef std::chrono::steady_clock Relogio;
+    AcompanhadorArquivo acompanhador(nome_arquivo, configuracao);
+    acompanhador.atualizar();
+    exibir_atualizacao(acompanhador.contagem(), top_k, configuracao);
+
+    Relogio::time_point ultima_exibicao = Relogio::now();
+    bool pendente = false;
+    for (;;) {
+        int decorrido = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            Relogio::now() - ultima_exibicao).count());
+        int espera = pendente ? std::max(0, intervalo_ms - decorrido) : intervalo_ms;
+        acompanhador.aguardar(espera);
+        // Também atualiza sem evento, para perceber rotações em que o arquivo novo surgiu depois
+        if (acompanhador.atualizar()) {
+            pendente = true;
+        }
+        if (pendente && Relogio::now() - ultima_exibicao >= std::chrono::milliseconds(intervalo_ms)) {
+            exibir_atualizacao(acompanhador.contagem(), top_k, configuracao);
+            ultima_exibicao = Relogio::now();
+            pendente = false;
+        }
+    }
+}
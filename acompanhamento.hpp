@@ -0,0 +1,106 @@
+/**
+ * \file acompanhamento.hpp
+ * \brief Definições para acompanhar um arquivo que cresce, como um log, atualizando a contagem.
+ *
+ * Este arquivo contém as declarações do acompanhador de arquivo, que mantém a contagem de palavras
+ * na memória e lê apenas os bytes acrescentados ao arquivo desde a última leitura, e da função
+ * usada pelo modo `--follow` do programa.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef ACOMPANHAMENTO_HPP_
+#define ACOMPANHAMENTO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "conta_palavras.hpp"
+#include "fluxo.hpp"
+
+/**
+ * \brief Acompanha um arquivo e atualiza a contagem de palavras de forma incremental.
+ *
+ * A contagem fica residente e cada chamada a `atualizar` lê somente o que foi acrescentado ao
+ * arquivo. Se o arquivo for truncado, a contagem recomeça do início; se o nome passar a apontar
+ * para outro arquivo (rotação de log), o restante do arquivo antigo é lido e a contagem continua
+ * no novo. No Linux, as modificações são esperadas com inotify; nos demais sistemas, por
+ * consulta periódica.
+ */
+class AcompanhadorArquivo {
+ public:
+    /**
+     * \brief Abre o arquivo e começa a observá-lo.
+     *
+     * \param nome_arquivo O nome do arquivo a ser acompanhado.
+     * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+     * \throws std::ios_base::failure Se o arquivo não puder ser aberto.
+     */
+    explicit AcompanhadorArquivo(const std::string& nome_arquivo,
+                                 std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+    ~AcompanhadorArquivo();
+
+    AcompanhadorArquivo(const AcompanhadorArquivo&) = delete;
+    AcompanhadorArquivo& operator=(const AcompanhadorArquivo&) = delete;
+
+    /**
+     * \brief Lê e conta os bytes acrescentados desde a última atualização.
+     *
+     * A palavra no fim do arquivo só é contada quando for seguida de um espaço, pois ela ainda
+     * pode estar sendo escrita.
+     *
+     * \return Verdadeiro se a contagem mudou.
+     * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+     */
+    bool atualizar();
+
+    /**
+     * \brief Espera uma modificação no arquivo.
+     *
+     * \param tempo_ms O tempo máximo de espera, em milissegundos.
+     * \return Verdadeiro se o arquivo foi modificado antes do fim do tempo.
+     */
+    bool aguardar(int tempo_ms);
+
+    /**
+     * \brief Retorna a contagem atual.
+     */
+    const std::map<std::wstring, int>& contagem() const { return contador_.contagem(); }
+
+    /**
+     * \brief Retorna o número de bytes já lidos do arquivo atual.
+     */
+    std::uint64_t posicao() const { return posicao_; }
+
+ private:
+    void observar();
+
+    std::string nome_;
+    Arquivo arquivo_;
+    ContadorIncremental contador_;
+    std::vector<char> buffer_;
+    std::uint64_t posicao_;
+    int inotify_;
+    int observacao_;
+};
+
+/**
+ * \brief Função para acompanhar um arquivo e exibir a contagem sempre que ele mudar.
+ *
+ * Exibe a contagem inicial e, a cada modificação do arquivo, a contagem atualizada, no máximo
+ * uma vez por intervalo. Cada exibição é seguida de uma linha em branco. A função só retorna
+ * em caso de erro.
+ *
+ * \param nome_arquivo O nome do arquivo a ser acompanhado.
+ * \param intervalo_ms O intervalo mínimo entre duas exibições, em milissegundos.
+ * \param top_k Se diferente de zero, exibe apenas as `top_k` palavras mais frequentes.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto ou lido.
+ */
+void acompanhar_arquivo(const std::string& nome_arquivo, int intervalo_ms, std::size_t top_k,
+                        std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+#endif  // ACOMPANHAMENTO_HPP_
@@ -0,0 +1,112 @@
+/**
+ * \file agregacao.cpp
+ * \brief Implementação da contagem em memória limitada, com descarga em disco.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "agregacao.hpp"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ios>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "fluxo.hpp"
+#include "vocabulario.hpp"
+
+/**
+ * \brief Cria um agregador cujo contador descarrega rodadas ao atingir o limite de memória.
+ *
+ * \param limite_memoria O limite, em bytes, da tabela de contagem em memória.
+ * \param diretorio O diretório das rodadas temporárias; vazio usa `TMPDIR` ou `/tmp`.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`, gravados também nas rodadas.
+ */
+AgregadorExterno::AgregadorExterno(std::size_t limite_memoria, const std::string& diretorio,
+                                   std::uint32_t configuracao)
+    : contador_(configuracao), diretorio_(diretorio) {
+    if (diretorio_.empty()) {
+        const char* temporario = std::getenv("TMPDIR");
+        diretorio_ = temporario != nullptr && *temporario != '\0' ? temporario : "/tmp";
+    }
+    contador_.limitar_memoria(limite_memoria, [this](const std::map<std::wstring, int>& contagem) {
+        descarregar(contagem);
+    });
+}
+
+AgregadorExterno::~AgregadorExterno() {
+    apagar_rodadas();
+}
+
+/**
+ * \brief Grava uma contagem parcial como uma nova rodada ordenada.
+ *
+ * O nome da rodada é reservado com `mkstemp`, e o instantâneo é gravado por cima dele.
+ *
+ * \param contagem A contagem parcial.
+ * \throws std::ios_base::failure Se a rodada não puder ser gravada.
+ */
+void AgregadorExterno::descarregar(const std::map<std::wstring, int>& contagem) {
+    std::string modelo = diretorio_ + "/conta_palavras.XXXXXX";
+    int descritor = ::mkstemp(&modelo[0]);
+    if (descritor < 0) {
+        throw std::ios_base::failure("Nao foi possivel criar o arquivo temporario.");
+    }
+    ::close(descritor);
+    rodadas_.push_back(modelo);
+    gravar_vocabulario(contagem, modelo, contador_.configuracao());
+}
+
+/**
+ * \brief Apaga as rodadas temporárias gravadas até o momento.
+ */
+void AgregadorExterno::apagar_rodadas() {
+    for (const auto& rodada : rodadas_) {
+        std::remove(rodada.c_str());
+    }
+    rodadas_.clear();
+}
+
+/**
+ * \brief Finaliza a contagem e grava o resultado como instantâneo de vocabulário.
+ *
+ * \param nome_arquivo O nome do instantâneo a ser gravado.
+ * \return O número de palavras distintas.
+ * \throws std::ios_base::failure Se ocorrer um erro de escrita.
+ */
+std::uint64_t AgregadorExterno::concluir(const std::string& nome_arquivo) {
+    contador_.finalizar();
+    std::map<std::wstring, int> restante = contador_.extrair_contagem();
+    if (rodadas_.empty()) {
+        gravar_vocabulario(restante, nome_arquivo, contador_.configuracao());
+        return restante.size();
+    }
+    if (!restante.empty()) {
+        descarregar(restante);
+        restante.clear();
+    }
+    std::uint64_t palavras = mesclar_vocabularios(rodadas_, nome_arquivo);
+    apagar_rodadas();
+    return palavras;
+}
+
+/**
+ * \brief Função para contar as palavras lidas de um descritor em memória limitada.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param limite_memoria O limite, em bytes, da tabela de contagem em memória.
+ * \param nome_arquivo O nome do instantâneo de vocabulário a ser gravado com o resultado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return O número de palavras distintas.
+ * \throws std::ios_base::failure Se ocorrer um erro de leitura, de descompressão ou de escrita.
+ */
+std::uint64_t contar_palavras_limitado(int descritor, std::size_t limite_memoria,
+                                       const std::string& nome_arquivo, std::uint32_t configuracao) {
+    AgregadorExterno agregador(limite_memoria, "", configuracao);
+    alimentar_contador(descritor, agregador.contador());
+    return agregador.concluir(nome_arquivo);
+}
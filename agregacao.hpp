@@ -0,0 +1,93 @@
+/**
+ * \file agregacao.hpp
+ * \brief Definições para contar palavras em memória limitada, com descarga em disco.
+ *
+ * Este arquivo contém as declarações do agregador externo: a contagem é feita em memória até um
+ * limite configurado; ao atingi-lo, a contagem parcial é gravada em disco como um instantâneo
+ * ordenado (uma rodada) e a memória é liberada. Ao final, as rodadas são intercaladas em um único
+ * instantâneo, de forma que a contagem termina em memória fixa, qualquer que seja o tamanho do
+ * vocabulário.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef AGREGACAO_HPP_
+#define AGREGACAO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "fluxo.hpp"
+
+/**
+ * \brief Contagem com limite de memória, descarregada em rodadas ordenadas no disco.
+ *
+ * O agregador é dono de um `ContadorIncremental` com limite de memória; o texto é entregue a
+ * `contador()` e o resultado é gravado como instantâneo de vocabulário em `concluir`. As rodadas
+ * temporárias são apagadas em `concluir` ou na destruição do agregador.
+ */
+class AgregadorExterno {
+ public:
+    /**
+     * \brief Cria um agregador.
+     *
+     * \param limite_memoria O limite, em bytes, da tabela de contagem em memória.
+     * \param diretorio O diretório das rodadas temporárias; vazio usa `TMPDIR` ou `/tmp`.
+     * \param configuracao Os bits de `ConfiguracaoTokenizador`, gravados também nas rodadas.
+     */
+    explicit AgregadorExterno(std::size_t limite_memoria, const std::string& diretorio = "",
+                              std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+    ~AgregadorExterno();
+
+    AgregadorExterno(const AgregadorExterno&) = delete;
+    AgregadorExterno& operator=(const AgregadorExterno&) = delete;
+
+    /**
+     * \brief Retorna o contador que deve receber o texto.
+     */
+    ContadorIncremental& contador() { return contador_; }
+
+    /**
+     * \brief Retorna o número de rodadas gravadas em disco até o momento.
+     */
+    std::size_t rodadas() const { return rodadas_.size(); }
+
+    /**
+     * \brief Finaliza a contagem e grava o resultado como instantâneo de vocabulário.
+     *
+     * Se nenhuma rodada foi descarregada, a contagem em memória é gravada diretamente; caso
+     * contrário, o restante da memória vira a última rodada e todas são intercaladas.
+     *
+     * \param nome_arquivo O nome do instantâneo a ser gravado.
+     * \return O número de palavras distintas.
+     * \throws std::ios_base::failure Se ocorrer um erro de escrita.
+     */
+    std::uint64_t concluir(const std::string& nome_arquivo);
+
+ private:
+    void descarregar(const std::map<std::wstring, int>& contagem);
+    void apagar_rodadas();
+
+    ContadorIncremental contador_;
+    std::string diretorio_;
+    std::vector<std::string> rodadas_;
+};
+
+/**
+ * \brief Função para contar as palavras lidas de um descritor em memória limitada.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param limite_memoria O limite, em bytes, da tabela de contagem em memória.
+ * \param nome_arquivo O nome do instantâneo de vocabulário a ser gravado com o resultado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return O número de palavras distintas.
+ * \throws std::ios_base::failure Se ocorrer um erro de leitura, de descompressão ou de escrita.
+ */
+std::uint64_t contar_palavras_limitado(int descritor, std::size_t limite_memoria,
+                                       const std::string& nome_arquivo,
+                                       std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+#endif  // AGREGACAO_HPP_
@@ -0,0 +1,40 @@
+/**
+ * \file alocacoes.cpp
+ * \brief Substituição do operador `new` global que conta as alocações de cada thread.
+ *
+ * Só é ligada aos programas que exibem as alocações (`conta_palavras` e `benchmark`); os demais,
+ * como os testes, usam o operador padrão, e os contadores de `estatisticas.hpp` ficam em zero.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "estatisticas.hpp"
+
+#ifndef CONTA_PALAVRAS_SEM_ESTATISTICAS
+
+void* operator new(std::size_t tamanho) {
+    ++alocacoes_thread;
+    bytes_alocados_thread += tamanho;
+    void* bloco = std::malloc(tamanho == 0 ? 1 : tamanho);
+    if (bloco == nullptr) {
+        throw std::bad_alloc();
+    }
+    return bloco;
+}
+
+void* operator new[](std::size_t tamanho) {
+    return operator new(tamanho);
+}
+
+void operator delete(void* bloco) noexcept {
+    std::free(bloco);
+}
+
+void operator delete[](void* bloco) noexcept {
+    std::free(bloco);
+}
+
+#endif  // CONTA_PALAVRAS_SEM_ESTATISTICAS
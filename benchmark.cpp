@@ -0,0 +1,510 @@
+/**
+ * \file benchmark.cpp
+ * \brief Medição de desempenho de cada etapa da contagem de palavras.
+ *
+ * Uso: `benchmark [--repeticoes N] [--tamanhos MB,MB,...] [--contadores] [arquivo...]`. Para cada tamanho, mede
+ * um corpus sintético (palavras ASCII sorteadas uniformemente) e um corpus realista (vocabulário
+ * com acentos sorteado segundo a lei de Zipf, com pontuação e linhas de tamanho variado), ambos
+ * produzidos por `GeradorCorpus` com semente fixa; cada arquivo dado é medido como um corpus
+ * adicional.
+ *
+ * Cada etapa é executada uma vez para aquecimento e depois N vezes (padrão: 7). São exibidos a
+ * mediana, o desvio padrão e a meia largura do intervalo de 95% (distribuição t de Student) do
+ * tempo, a vazão em MB/s e em palavras/s calculadas sobre a mediana, o número de alocações e de
+ * bytes alocados por execução (contados pela instrumentação de `estatisticas.hpp`, na thread que
+ * executa a etapa) e o pico de memória residente durante a etapa.
+ *
+ * Com `--contadores`, cada execução medida também lê os contadores de hardware do Linux
+ * (`perf_event_open`: ciclos, instruções, falhas de cache e falhas de previsão de desvio) e são
+ * exibidos, pela mediana das execuções, os ciclos por palavra, as instruções por ciclo (IPC) e as
+ * falhas de cache e de desvio por palavra. Se o sistema não permitir os contadores (por exemplo,
+ * com `kernel.perf_event_paranoid` acima de 2 ou em uma máquina virtual sem PMU), o motivo é
+ * exibido e a medição continua sem eles.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include <linux/perf_event.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <codecvt>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <locale>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "conta_palavras.hpp"
+#include "estatisticas.hpp"
+#include "gerador_corpus.hpp"
+
+/**
+ * \brief Fluxo largo que descarta tudo o que recebe, para medir `processar_arquivo` sem terminal.
+ */
+class DescarteLargo : public std::wstreambuf {
+ protected:
+    int_type overflow(int_type caractere) override { return traits_type::not_eof(caractere); }
+    std::streamsize xsputn(const wchar_t*, std::streamsize quantidade) override { return quantidade; }
+};
+
+/**
+ * \brief Contadores de hardware do Linux, lidos em volta de cada execução medida.
+ *
+ * Cada evento é aberto separadamente e apenas para o espaço de usuário (o que basta com
+ * `perf_event_paranoid` até 2), de forma que um evento sem suporte não impede a leitura dos
+ * demais. Quando o núcleo multiplexa os contadores, os valores são escalados pela fração do tempo
+ * em que cada um esteve ativo.
+ */
+class ContadoresHardware {
+ public:
+    enum Evento { CICLOS, INSTRUCOES, FALHAS_CACHE, FALHAS_DESVIO, NUMERO_EVENTOS };
+
+    ContadoresHardware() : abertos_(0) {
+        static const std::uint64_t configuracoes[NUMERO_EVENTOS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < NUMERO_EVENTOS; ++i) {
+            struct perf_event_attr atributos;
+            std::memset(&atributos, 0, sizeof(atributos));
+            atributos.type = PERF_TYPE_HARDWARE;
+            atributos.size = sizeof(atributos);
+            atributos.config = configuracoes[i];
+            atributos.disabled = 1;
+            atributos.exclude_kernel = 1;
+            atributos.exclude_hv = 1;
+            atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            descritores_[i] = static_cast<int>(::syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0));
+            if (descritores_[i] >= 0) {
+                ++abertos_;
+            } else if (erro_.empty()) {
+                erro_ = std::strerror(errno);
+            }
+        }
+    }
+
+    ~ContadoresHardware() {
+        for (int descritor : descritores_) {
+            if (descritor >= 0) {
+                ::close(descritor);
+            }
+        }
+    }
+
+    ContadoresHardware(const ContadoresHardware&) = delete;
+    ContadoresHardware& operator=(const ContadoresHardware&) = delete;
+
+    /**
+     * \brief Indica se ao menos um evento pôde ser aberto.
+     */
+    bool disponiveis() const { return abertos_ > 0; }
+
+    /**
+     * \brief Retorna o erro da primeira abertura que falhou.
+     */
+    const std::string& erro() const { return erro_; }
+
+    /**
+     * \brief Zera e liga os contadores.
+     */
+    void iniciar() {
+        for (int descritor : descritores_) {
+            if (descritor >= 0) {
+                ::ioctl(descritor, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(descritor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    /**
+     * \brief Desliga os contadores e lê os valores.
+     *
+     * \param valores Recebe os valores; um evento indisponível recebe NaN.
+     */
+    void parar(double valores[NUMERO_EVENTOS]) {
+        for (int descritor : descritores_) {
+            if (descritor >= 0) {
+                ::ioctl(descritor, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (int i = 0; i < NUMERO_EVENTOS; ++i) {
+            std::uint64_t leitura[3];
+            valores[i] = NAN;
+            if (descritores_[i] < 0 || ::read(descritores_[i], leitura, sizeof(leitura)) != sizeof(leitura) ||
+                leitura[2] == 0) {
+                continue;
+            }
+            valores[i] = static_cast<double>(leitura[0]) * static_cast<double>(leitura[1]) /
+                         static_cast<double>(leitura[2]);
+        }
+    }
+
+ private:
+    int descritores_[NUMERO_EVENTOS];
+    int abertos_;
+    std::string erro_;
+};
+
+/**
+ * \brief Os contadores de hardware, se pedidos com `--contadores` e disponíveis.
+ */
+static ContadoresHardware* contadores = nullptr;
+
+/**
+ * \brief Retorna a mediana de um conjunto de valores, ignorando os que são NaN.
+ */
+static double mediana(std::vector<double> valores) {
+    valores.erase(std::remove_if(valores.begin(), valores.end(), [](double valor) { return std::isnan(valor); }),
+                  valores.end());
+    if (valores.empty()) {
+        return NAN;
+    }
+    std::sort(valores.begin(), valores.end());
+    std::size_t n = valores.size();
+    return n % 2 == 1 ? valores[n / 2] : (valores[n / 2 - 1] + valores[n / 2]) / 2.0;
+}
+
+/**
+ * \brief Reinicia o pico de memória residente do processo, se o sistema permitir.
+ *
+ * Escrever `5` em `/proc/self/clear_refs` (Linux 4.0 ou posterior) faz o pico voltar à memória
+ * residente atual, o que permite medir o pico de cada etapa separadamente.
+ *
+ * \return Verdadeiro se o pico foi reiniciado.
+ */
+static bool reiniciar_pico() {
+    std::ofstream arquivo("/proc/self/clear_refs");
+    arquivo << "5";
+    arquivo.close();
+    return !arquivo.fail();
+}
+
+/**
+ * \brief Retorna o pico de memória residente do processo, em kB.
+ */
+static long ler_pico() {
+    std::ifstream arquivo("/proc/self/status");
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        if (linha.compare(0, 6, "VmHWM:") == 0) {
+            return std::strtol(linha.c_str() + 6, nullptr, 10);
+        }
+    }
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+/**
+ * \brief Valor crítico bilateral de 95% da distribuição t de Student.
+ *
+ * \param graus Os graus de liberdade (número de repetições menos um).
+ */
+static double t_critico(std::size_t graus) {
+    static const double tabela[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+                                    2.228,  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+                                    2.093,  2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+                                    2.048,  2.045, 2.042};
+    const std::size_t entradas = sizeof(tabela) / sizeof(tabela[0]);
+    if (graus == 0) {
+        return 0.0;
+    }
+    return graus <= entradas ? tabela[graus - 1] : 1.960;
+}
+
+/**
+ * \brief Um corpus de teste: o arquivo gravado e as suas grandezas.
+ */
+struct Corpus {
+    std::string nome;
+    std::string arquivo;
+    bool temporario;
+    std::size_t bytes;
+    std::size_t palavras;
+    std::size_t distintas;
+};
+
+/**
+ * \brief Grava um corpus gerado em um arquivo temporário e retorna o seu nome.
+ *
+ * \throws std::ios_base::failure Se não for possível criar ou gravar o arquivo.
+ */
+static std::string gravar_temporario(const ConfiguracaoCorpus& configuracao) {
+    const char* diretorio = std::getenv("TMPDIR");
+    std::string modelo = std::string(diretorio != nullptr && *diretorio != '\0' ? diretorio : "/tmp") +
+                         "/benchmark_XXXXXX";
+    std::vector<char> nome(modelo.begin(), modelo.end());
+    nome.push_back('\0');
+    int descritor = mkstemp(nome.data());
+    if (descritor < 0) {
+        throw std::ios_base::failure("Nao foi possivel criar o arquivo temporario.");
+    }
+    try {
+        gravar_corpus(configuracao, descritor);
+    } catch (...) {
+        ::close(descritor);
+        std::remove(nome.data());
+        throw;
+    }
+    ::close(descritor);
+    return nome.data();
+}
+
+/**
+ * \brief Mede uma etapa e exibe uma linha da tabela.
+ *
+ * \param nome O nome da etapa.
+ * \param etapa A etapa; retorna um valor derivado do resultado, para que não seja descartada.
+ * \param repeticoes O número de execuções medidas, além do aquecimento.
+ * \param bytes Os bytes processados por execução, para a vazão em MB/s (zero omite a coluna).
+ * \param palavras As palavras processadas por execução, para a vazão em palavras/s.
+ */
+static void medir(const char* nome, const std::function<std::size_t()>& etapa, std::size_t repeticoes,
+                  std::size_t bytes, std::size_t palavras) {
+    static volatile std::size_t sorvedouro;
+    sorvedouro = sorvedouro + etapa();
+
+    std::vector<double> tempos;
+    std::vector<double> eventos[ContadoresHardware::NUMERO_EVENTOS];
+    std::uint64_t total_alocacoes = 0;
+    std::uint64_t total_bytes = 0;
+    bool pico_por_etapa = reiniciar_pico();
+    for (std::size_t i = 0; i < repeticoes; ++i) {
+        std::uint64_t alocacoes_antes = alocacoes_da_thread();
+        std::uint64_t bytes_antes = bytes_alocados_da_thread();
+        if (contadores != nullptr) {
+            contadores->iniciar();
+        }
+        auto inicio = std::chrono::steady_clock::now();
+        sorvedouro = sorvedouro + etapa();
+        auto fim = std::chrono::steady_clock::now();
+        double valores[ContadoresHardware::NUMERO_EVENTOS];
+        if (contadores != nullptr) {
+            contadores->parar(valores);
+        }
+        total_alocacoes += alocacoes_da_thread() - alocacoes_antes;
+        total_bytes += bytes_alocados_da_thread() - bytes_antes;
+        if (contadores != nullptr) {
+            for (int evento = 0; evento < ContadoresHardware::NUMERO_EVENTOS; ++evento) {
+                eventos[evento].push_back(valores[evento]);
+            }
+        }
+        tempos.push_back(std::chrono::duration<double, std::milli>(fim - inicio).count());
+    }
+    long pico = ler_pico();
+
+    std::size_t n = tempos.size();
+    double tempo_mediano = mediana(tempos);
+    double media = 0.0;
+    for (double tempo : tempos) {
+        media += tempo;
+    }
+    media /= static_cast<double>(n);
+    double variancia = 0.0;
+    for (double tempo : tempos) {
+        variancia += (tempo - media) * (tempo - media);
+    }
+    double desvio = n > 1 ? std::sqrt(variancia / static_cast<double>(n - 1)) : 0.0;
+    double intervalo = t_critico(n - 1) * desvio / std::sqrt(static_cast<double>(n));
+
+    double segundos = tempo_mediano / 1000.0;
+    char vazao[32] = "-";
+    if (bytes > 0 && segundos > 0.0) {
+        std::snprintf(vazao, sizeof(vazao), "%.1f", static_cast<double>(bytes) / 1048576.0 / segundos);
+    }
+    char linha[256];
+    std::snprintf(linha, sizeof(linha), "  %-20s %10.3f %9.3f %9.3f %9s %12.0f %11.0f %11.2f %9.1f%s",
+                  nome, tempo_mediano, desvio, intervalo, vazao,
+                  segundos > 0.0 ? static_cast<double>(palavras) / segundos : 0.0,
+                  static_cast<double>(total_alocacoes) / static_cast<double>(n),
+                  static_cast<double>(total_bytes) / static_cast<double>(n) / 1048576.0,
+                  static_cast<double>(pico) / 1024.0,
+                  pico_por_etapa ? (contadores != nullptr ? " " : "") : "*");
+    std::cout << linha;
+
+    if (contadores != nullptr) {
+        // Eventos indisponíveis resultam em NaN, exibido como "nan"
+        double ciclos = mediana(eventos[ContadoresHardware::CICLOS]);
+        double instrucoes = mediana(eventos[ContadoresHardware::INSTRUCOES]);
+        double por_palavra = palavras > 0 ? 1.0 / static_cast<double>(palavras) : NAN;
+        std::snprintf(linha, sizeof(linha), " %11.1f %6.2f %10.4f %10.4f", ciclos * por_palavra,
+                      instrucoes / ciclos, mediana(eventos[ContadoresHardware::FALHAS_CACHE]) * por_palavra,
+                      mediana(eventos[ContadoresHardware::FALHAS_DESVIO]) * por_palavra);
+        std::cout << linha;
+    }
+    std::cout << '\n';
+}
+
+/**
+ * \brief Mede todas as etapas sobre um corpus.
+ */
+static void medir_corpus(Corpus& corpus, std::size_t repeticoes) {
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> convert;
+    const std::string bruto = ler_arquivo(corpus.arquivo);
+    const std::wstring texto = convert.from_bytes(bruto);
+    const std::vector<std::wstring> palavras = separar_palavras(texto);
+    const std::map<std::wstring, int> contagem = contar_palavras(texto);
+    corpus.bytes = bruto.size();
+    corpus.palavras = palavras.size();
+    corpus.distintas = contagem.size();
+
+    std::cout << "\ncorpus " << corpus.nome << ": " << corpus.bytes << " bytes, " << corpus.palavras
+              << " palavras, " << corpus.distintas << " distintas\n";
+    std::cout << "  etapa                mediana ms  desvio ms   IC95 ms      MB/s    palavras/s"
+                 "  alocacoes  MB alocados  pico MB";
+    if (contadores != nullptr) {
+        std::cout << "   ciclos/pal    IPC  cache/pal  desvio/pal";
+    }
+    std::cout << '\n';
+
+    medir("ler_arquivo", [&]() { return ler_arquivo(corpus.arquivo).size(); }, repeticoes,
+          corpus.bytes, corpus.palavras);
+    medir("conversao UTF-8", [&]() { return convert.from_bytes(bruto).size(); }, repeticoes,
+          corpus.bytes, corpus.palavras);
+    medir("separar_palavras", [&]() { return separar_palavras(texto).size(); }, repeticoes,
+          corpus.bytes, corpus.palavras);
+    medir("contar_palavras", [&]() { return contar_palavras(texto).size(); }, repeticoes,
+          corpus.bytes, corpus.palavras);
+    medir("remover_acentos", [&]() {
+              std::size_t total = 0;
+              for (const std::wstring& palavra : palavras) {
+                  total += remover_acentos(palavra).size();
+              }
+              return total;
+          }, repeticoes, 0, corpus.palavras);
+    medir("normalizar_chave", [&]() {
+              std::size_t total = 0;
+              std::wstring chave;
+              for (const std::wstring& palavra : palavras) {
+                  normalizar_chave(palavra.data(), palavra.data() + palavra.size(), TOKENIZADOR_MINUSCULAS, chave);
+                  total += chave.size();
+              }
+              return total;
+          }, repeticoes, 0, corpus.palavras);
+    medir("ordenar_palavras", [&]() { return ordenar_palavras(contagem).size(); }, repeticoes, 0,
+          corpus.distintas);
+    medir("processar_arquivo", [&]() {
+              std::wstreambuf* anterior = std::wcout.rdbuf();
+              DescarteLargo descarte;
+              std::wcout.rdbuf(&descarte);
+              processar_arquivo(corpus.arquivo);
+              std::wcout.rdbuf(anterior);
+              return static_cast<std::size_t>(1);
+          }, repeticoes, corpus.bytes, corpus.palavras);
+}
+
+/**
+ * \brief Exibe a forma de uso do programa na saída de erros.
+ */
+static void exibir_uso() {
+    std::cerr << "Uso: benchmark [--repeticoes N] [--tamanhos MB,MB,...] [--contadores] [arquivo...]\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t repeticoes = 7;
+    std::vector<std::size_t> tamanhos = {1, 8, 32};
+    std::vector<Corpus> corpora;
+    bool usar_contadores = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string argumento = argv[i];
+        if (argumento == "--contadores") {
+            usar_contadores = true;
+            continue;
+        }
+        if ((argumento == "--repeticoes" || argumento == "--tamanhos") && i + 1 >= argc) {
+            exibir_uso();
+            return 1;
+        }
+        if (argumento == "--repeticoes") {
+            long valor = std::strtol(argv[++i], nullptr, 10);
+            if (valor < 1) {
+                exibir_uso();
+                return 1;
+            }
+            repeticoes = static_cast<std::size_t>(valor);
+        } else if (argumento == "--tamanhos") {
+            tamanhos.clear();
+            std::stringstream lista(argv[++i]);
+            std::string item;
+            while (std::getline(lista, item, ',')) {
+                long valor = std::strtol(item.c_str(), nullptr, 10);
+                if (valor > 0) {
+                    tamanhos.push_back(static_cast<std::size_t>(valor));
+                }
+            }
+        } else if (argumento.compare(0, 2, "--") == 0) {
+            exibir_uso();
+            return 1;
+        } else {
+            corpora.push_back(Corpus{argumento, argumento, false, 0, 0, 0});
+        }
+    }
+
+    std::unique_ptr<ContadoresHardware> hardware;
+    if (usar_contadores) {
+        hardware.reset(new ContadoresHardware());
+        if (hardware->disponiveis()) {
+            contadores = hardware.get();
+        } else {
+            std::cerr << "Contadores de hardware indisponiveis: " << hardware->erro() << std::endl;
+        }
+    }
+
+    int situacao = 0;
+    try {
+        // Sintético: palavras ASCII sorteadas uniformemente, sem pontuação; realista: os padrões
+        // do gerador, com acentos, pontuação e frequências segundo a lei de Zipf
+        ConfiguracaoCorpus sintetico;
+        sintetico.vocabulario = 1000;
+        sintetico.expoente_zipf = 0.0;
+        sintetico.densidade_acentos = 0.0;
+        sintetico.densidade_pontuacao = 0.0;
+        ConfiguracaoCorpus realista;
+
+        std::vector<Corpus> gerados;
+        for (std::size_t tamanho : tamanhos) {
+            sintetico.tamanho = realista.tamanho = static_cast<std::uint64_t>(tamanho) << 20;
+            gerados.push_back(Corpus{"sintetico " + std::to_string(tamanho) + " MB",
+                                     gravar_temporario(sintetico), true, 0, 0, 0});
+            gerados.push_back(Corpus{"realista " + std::to_string(tamanho) + " MB",
+                                     gravar_temporario(realista), true, 0, 0, 0});
+        }
+        corpora.insert(corpora.begin(), gerados.begin(), gerados.end());
+
+        std::cout << "repeticoes: " << repeticoes << " (mais 1 de aquecimento)\n";
+        for (Corpus& corpus : corpora) {
+            medir_corpus(corpus, repeticoes);
+        }
+        if (!reiniciar_pico()) {
+            std::cout << "\n* pico de memoria do processo inteiro: o sistema nao permite reinicia-lo por etapa.\n";
+        }
+    } catch (const std::exception& erro) {
+        std::cerr << erro.what() << std::endl;
+        situacao = 1;
+    }
+
+    for (const Corpus& corpus : corpora) {
+        if (corpus.temporario) {
+            std::remove(corpus.arquivo.c_str());
+        }
+    }
+    return situacao;
+}
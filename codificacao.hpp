@@ -0,0 +1,112 @@
+/**
+ * \file codificacao.hpp
+ * \brief Funções de codificação binária comuns aos formatos gravados em disco.
+ *
+ * Inteiros de tamanho fixo são gravados em little-endian, independentemente da arquitetura, e
+ * inteiros de tamanho variável em varint (7 bits por byte, o bit mais alto indicando que há mais
+ * bytes). As funções são definidas no cabeçalho para que a decodificação, feita uma vez por campo,
+ * seja expandida em linha.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef CODIFICACAO_HPP_
+#define CODIFICACAO_HPP_
+
+#include <cstdint>
+#include <ios>
+#include <string>
+
+/**
+ * \brief Grava um inteiro de 32 bits em little-endian.
+ */
+inline void escrever_u32(unsigned char* destino, std::uint32_t valor) {
+    for (int i = 0; i < 4; ++i) {
+        destino[i] = static_cast<unsigned char>(valor >> (8 * i));
+    }
+}
+
+/**
+ * \brief Grava um inteiro de 64 bits em little-endian.
+ */
+inline void escrever_u64(unsigned char* destino, std::uint64_t valor) {
+    for (int i = 0; i < 8; ++i) {
+        destino[i] = static_cast<unsigned char>(valor >> (8 * i));
+    }
+}
+
+/**
+ * \brief Lê um inteiro de 32 bits gravado em little-endian.
+ */
+inline std::uint32_t ler_u32(const unsigned char* origem) {
+    std::uint32_t valor = 0;
+    for (int i = 3; i >= 0; --i) {
+        valor = (valor << 8) | origem[i];
+    }
+    return valor;
+}
+
+/**
+ * \brief Lê um inteiro de 64 bits gravado em little-endian.
+ */
+inline std::uint64_t ler_u64(const unsigned char* origem) {
+    std::uint64_t valor = 0;
+    for (int i = 7; i >= 0; --i) {
+        valor = (valor << 8) | origem[i];
+    }
+    return valor;
+}
+
+/**
+ * \brief Acrescenta um inteiro de 32 bits em little-endian.
+ */
+inline void acrescentar_u32(std::string& destino, std::uint32_t valor) {
+    unsigned char bytes[4];
+    escrever_u32(bytes, valor);
+    destino.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+/**
+ * \brief Acrescenta um inteiro de 64 bits em little-endian.
+ */
+inline void acrescentar_u64(std::string& destino, std::uint64_t valor) {
+    unsigned char bytes[8];
+    escrever_u64(bytes, valor);
+    destino.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+/**
+ * \brief Acrescenta um inteiro sem sinal codificado em varint (7 bits por byte).
+ */
+inline void acrescentar_varint(std::string& destino, std::uint64_t valor) {
+    while (valor >= 0x80) {
+        destino += static_cast<char>((valor & 0x7F) | 0x80);
+        valor >>= 7;
+    }
+    destino += static_cast<char>(valor);
+}
+
+/**
+ * \brief Lê um inteiro codificado em varint, conferindo o limite do buffer.
+ *
+ * \param cursor A posição de leitura, avançada para depois do varint.
+ * \param fim O fim do buffer.
+ * \return O valor lido.
+ * \throws std::ios_base::failure Se o varint ultrapassar o fim do buffer ou 64 bits.
+ */
+inline std::uint64_t ler_varint(const unsigned char*& cursor, const unsigned char* fim) {
+    std::uint64_t valor = 0;
+    for (int deslocamento = 0; deslocamento < 64; deslocamento += 7) {
+        if (cursor == fim) {
+            break;
+        }
+        unsigned char byte = *cursor++;
+        valor |= static_cast<std::uint64_t>(byte & 0x7F) << deslocamento;
+        if ((byte & 0x80) == 0) {
+            return valor;
+        }
+    }
+    throw std::ios_base::failure("Arquivo binario corrompido.");
+}
+
+#endif  // CODIFICACAO_HPP_
@@ -10,6 +10,12 @@
 
 #include "conta_palavras.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -20,23 +26,76 @@
 #include <algorithm>
 #include <locale>
 #include <codecvt>
-#include <cwctype>
+#include <utility>
+#include "descompressao.hpp"
+#include "estatisticas.hpp"
+#include "fluxo.hpp"
+#include "palavras_vazias.hpp"
 #include "catch.hpp"
 
 /**
- * \brief Função para abrir um arquivo.
+ * \brief Abre o arquivo especificado pelo nome.
  * 
- * Esta função tenta abrir o arquivo especificado pelo nome. Se o arquivo não puder ser aberto, 
- * uma exceção será lançada.
+ * O arquivo é aberto somente para leitura e o seu tamanho é obtido com fstat sobre o próprio 
+ * descritor, sem uma segunda busca pelo caminho. Diretórios são rejeitados na abertura, para que 
+ * o erro seja informado aqui e não apenas na leitura.
  * 
  * \param nome_arquivo O nome do arquivo a ser aberto.
  * \throws std::ios_base::failure Se o arquivo não puder ser aberto.
  */
-void abrir_arquivo(const std::string& nome_arquivo) {
-    std::ifstream arquivo(nome_arquivo);
-    if (!arquivo.is_open()) {
+Arquivo::Arquivo(const std::string& nome_arquivo)
+    : descritor_(-1), tamanho_(0), nome_(nome_arquivo) {
+    descritor_ = ::open(nome_arquivo.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descritor_ < 0) {
         throw std::ios_base::failure("Nao foi possivel abrir o arquivo.");
     }
+    struct stat informacoes;
+    if (::fstat(descritor_, &informacoes) != 0 || S_ISDIR(informacoes.st_mode)) {
+        ::close(descritor_);
+        descritor_ = -1;
+        throw std::ios_base::failure("Nao foi possivel abrir o arquivo.");
+    }
+    if (S_ISREG(informacoes.st_mode)) {
+        tamanho_ = static_cast<std::size_t>(informacoes.st_size);
+    }
+}
+
+Arquivo::Arquivo(Arquivo&& outro) noexcept
+    : descritor_(outro.descritor_), tamanho_(outro.tamanho_), nome_(std::move(outro.nome_)) {
+    outro.descritor_ = -1;
+}
+
+Arquivo& Arquivo::operator=(Arquivo&& outro) noexcept {
+    if (this != &outro) {
+        if (descritor_ >= 0) {
+            ::close(descritor_);
+        }
+        descritor_ = outro.descritor_;
+        tamanho_ = outro.tamanho_;
+        nome_ = std::move(outro.nome_);
+        outro.descritor_ = -1;
+    }
+    return *this;
+}
+
+Arquivo::~Arquivo() {
+    if (descritor_ >= 0) {
+        ::close(descritor_);
+    }
+}
+
+/**
+ * \brief Função para abrir um arquivo.
+ * 
+ * Esta função tenta abrir o arquivo especificado pelo nome. Se o arquivo não puder ser aberto, 
+ * uma exceção será lançada. O arquivo aberto é retornado para que a leitura use o mesmo descritor.
+ * 
+ * \param nome_arquivo O nome do arquivo a ser aberto.
+ * \return O arquivo aberto.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto.
+ */
+Arquivo abrir_arquivo(const std::string& nome_arquivo) {
+    return Arquivo(nome_arquivo);
 }
 
 /**
@@ -49,13 +108,76 @@ void abrir_arquivo(const std::string& nome_arquivo) {
  * \throws std::ios_base::failure Se o arquivo não puder ser aberto.
  */
 std::string ler_arquivo(const std::string& nome_arquivo) {
-    std::ifstream arquivo(nome_arquivo);
-    if (!arquivo.is_open()) {
-        throw std::ios_base::failure("Não foi possível abrir o arquivo.");
+    Arquivo arquivo(nome_arquivo);
+    return ler_arquivo(arquivo);
+}
+
+/**
+ * \brief Função para ler o conteúdo de um arquivo já aberto.
+ * 
+ * Esta função aloca a string de destino uma única vez, no tamanho informado pelo fstat, e lê o 
+ * arquivo diretamente nela. A string é retornada por movimentação.
+ * 
+ * \param arquivo O arquivo aberto a ser lido.
+ * \return Uma string contendo o conteúdo do arquivo.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+ */
+std::string ler_arquivo(Arquivo& arquivo) {
+    std::string conteudo;
+    ler_arquivo(arquivo, conteudo);
+    return conteudo;
+}
+
+/**
+ * \brief Função para ler o conteúdo de um arquivo já aberto para um destino do chamador.
+ * 
+ * Esta função redimensiona o destino para o tamanho exato do arquivo e lê com `read` diretamente 
+ * na memória da string, sem buffer intermediário. Se o arquivo terminar antes do esperado, o 
+ * destino é encurtado; se houver mais dados (arquivo que cresceu ou entrada sem tamanho conhecido, 
+ * como um pipe), o destino cresce geometricamente até o fim da entrada. Se o conteúdo começar com 
+ * a assinatura de gzip ou zstd, ele é descomprimido antes de ser entregue.
+ * 
+ * \param arquivo O arquivo aberto a ser lido.
+ * \param destino A string que recebe o conteúdo do arquivo.
+ * \return O número de bytes do conteúdo entregue em `destino`.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+std::size_t ler_arquivo(Arquivo& arquivo, std::string& destino) {
+    // Um byte a mais evita que a leitura final, que apenas detecta o fim do arquivo, force
+    // um redimensionamento; o excedente é removido ao final.
+    std::size_t total = 0;
+    {
+        MedicaoEtapa medicao(ETAPA_LEITURA);
+        destino.resize(arquivo.tamanho() + 1);
+        for (;;) {
+            if (total == destino.size()) {
+                destino.resize(destino.size() < 65536 ? 65536 : destino.size() * 2);
+            }
+            ssize_t lidos = ::read(arquivo.descritor(), &destino[total], destino.size() - total);
+            if (lidos < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                destino.clear();
+                throw std::ios_base::failure("Erro ao ler o arquivo.");
+            }
+            if (lidos == 0) {
+                break;
+            }
+            total += static_cast<std::size_t>(lidos);
+        }
+        destino.resize(total);
+        medicao.bytes(total);
+    }
+
+    // Conteúdo compactado é entregue já descomprimido
+    FormatoCompressao formato = detectar_compressao(destino.data(), destino.size());
+    if (formato != FormatoCompressao::nenhum) {
+        MedicaoEtapa medicao(ETAPA_DESCOMPRESSAO);
+        medicao.bytes(destino.size());
+        destino = descomprimir(formato, destino);
     }
-    std::stringstream conteudo;
-    conteudo << arquivo.rdbuf();  // Lê todo o conteúdo do arquivo
-    return conteudo.str();  // Retorna o conteúdo do arquivo como string
+    return destino.size();
 }
 
 /**
@@ -82,33 +204,87 @@ std::vector<std::wstring> separar_palavras(const std::wstring& texto) {
  * \brief Função para contar a ocorrência de cada palavra em um texto.
  * 
  * Esta função percorre o texto, converte as palavras para minúsculas e conta as ocorrências 
- * de cada palavra, armazenando em um mapa.
+ * de cada palavra, armazenando em um mapa. As palavras são separadas apenas por espaços.
  * 
  * \param texto O texto no qual as palavras serão contadas.
  * \return Um mapa onde as chaves são as palavras e os valores são suas respectivas contagens.
  */
 std::map<std::wstring, int> contar_palavras(const std::wstring& texto) {
-    std::map<std::wstring, int> contagem;
-    std::wstringstream stream(texto);
-    std::wstring palavra;
-    while (stream >> palavra) {
-        // Converter para minúsculas
-        std::transform(palavra.begin(), palavra.end(), palavra.begin(), ::towlower);
-        contagem[palavra]++;
+    return contar_palavras(texto, CONFIGURACAO_PADRAO);
+}
+
+namespace {
+
+/**
+ * \brief Contagem de um texto com a política de normalização fixa, para `despachar_normalizacao`.
+ */
+template <typename Politica>
+struct ContagemTexto {
+    static std::map<std::wstring, int> executar(const std::wstring& texto, std::uint32_t configuracao) {
+        MedicaoEtapa medicao(ETAPA_CONTAGEM);
+        std::shared_ptr<const FiltroPalavrasVazias> filtro = filtro_palavras_vazias(configuracao);
+        std::map<std::wstring, int> contagem;
+        std::wstring palavra;
+        std::wstring normalizada;
+        std::uint64_t palavras = 0;
+        percorrer_palavras(texto.data(), texto.data() + texto.size(), configuracao,
+                           [&](const wchar_t* inicio, const wchar_t* fim) {
+                               aplicar_forma_normal(inicio, fim, configuracao, normalizada);
+                               normalizar_chave<Politica>(inicio, fim, palavra);
+                               if (palavra.empty() || filtro->contem(palavra)) {
+                                   return;
+                               }
+                               contagem[palavra]++;
+                               ++palavras;
+                           });
+        medicao.palavras(palavras);
+        registrar_tabela(palavras, contagem.size());
+        return contagem;
     }
-    return contagem;
+};
+
+}  // namespace
+
+/**
+ * \brief Função para contar a ocorrência de cada palavra em um texto com um tokenizador configurado.
+ * 
+ * As palavras são delimitadas diretamente sobre o texto, pela tabela de classes de caracteres, e 
+ * copiadas para uma única chave reaproveitada, sem o `wstringstream` e sem uma string por palavra. 
+ * A conversão para minúsculas e a remoção dos acentos são feitas durante a cópia, por uma versão 
+ * da contagem compilada para a política de normalização da configuração. Com `TOKENIZADOR_NFC` ou 
+ * `TOKENIZADOR_NFD`, cada palavra passa antes pela forma normal, copiada só se não estiver nela. 
+ * Com `TOKENIZADOR_SEM_PALAVRAS_VAZIAS`, as chaves que estão no filtro de palavras vazias são 
+ * descartadas antes de chegar ao mapa.
+ * 
+ * \param texto O texto no qual as palavras serão contadas.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return Um mapa onde as chaves são as palavras e os valores são suas respectivas contagens.
+ */
+std::map<std::wstring, int> contar_palavras(const std::wstring& texto, std::uint32_t configuracao) {
+    return despachar_normalizacao<ContagemTexto>(configuracao, texto, configuracao);
 }
 
 /**
  * \brief Função para ordenar as palavras por ordem alfabética sem considerar acentos.
  * 
  * Esta função ordena as palavras de acordo com a versão sem acento de cada uma, mas preserva 
- * as palavras originais.
+ * as palavras originais. Se as chaves já foram contadas sem acentos, a ordem do mapa é a ordem 
+ * procurada, e nenhuma palavra é percorrida de novo.
  * 
  * \param contagem O mapa que contém as palavras e suas contagens.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
  * \return Um vetor com as palavras ordenadas de acordo com a versão sem acento.
  */
-std::vector<std::wstring> ordenar_palavras(const std::map<std::wstring, int>& contagem) {
+std::vector<std::wstring> ordenar_palavras(const std::map<std::wstring, int>& contagem, std::uint32_t configuracao) {
+    if (configuracao & TOKENIZADOR_SEM_ACENTOS) {
+        std::vector<std::wstring> palavras;
+        palavras.reserve(contagem.size());
+        for (const auto& par : contagem) {
+            palavras.push_back(par.first);
+        }
+        return palavras;
+    }
+
     // Vetor auxiliar para armazenar pares (sem acento, original)
     std::vector<std::pair<std::wstring, std::wstring>> palavras_aux;
 
@@ -132,23 +308,135 @@ std::vector<std::wstring> ordenar_palavras(const std::map<std::wstring, int>& co
 /**
  * \brief Função para remover acentos de uma palavra.
  * 
- * Esta função remove os acentos das letras de uma palavra, substituindo por suas versões sem acento.
+ * Esta função substitui cada letra acentuada pela sua letra base, com `remover_acento`, e descarta 
+ * as marcas combinantes.
  * 
  * \param palavra A palavra da qual os acentos serão removidos.
  * \return A palavra sem acento.
  */
 std::wstring remover_acentos(const std::wstring& palavra) {
     std::wstring palavra_sem_acento;
-    for (wchar_t c : palavra) {
-        switch (c) {
-            case L'à': case L'á': case L'â': case L'ã': case L'ä': c = L'a'; break;
-            case L'è': case L'é': case L'ê': case L'ë': c = L'e'; break;
-        }
-        palavra_sem_acento += c;
-    }
+    normalizar_chave(palavra.data(), palavra.data() + palavra.size(), TOKENIZADOR_SEM_ACENTOS,
+                     palavra_sem_acento);
     return palavra_sem_acento;
 }
 
+/**
+ * \brief Função para exibir a contagem das palavras ordenadas.
+ * 
+ * Esta função ordena as palavras sem considerar acentos e imprime cada palavra seguida de sua 
+ * contagem, uma por linha. A saída é descarregada uma única vez, ao final.
+ * 
+ * \param contagem O mapa que contém as palavras e suas contagens.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+ */
+void imprimir_contagem(const std::map<std::wstring, int>& contagem, std::uint32_t configuracao) {
+    std::vector<std::wstring> palavras_ordenadas;
+    {
+        MedicaoEtapa medicao(ETAPA_ORDENACAO);
+        palavras_ordenadas = ordenar_palavras(contagem, configuracao);
+        medicao.palavras(palavras_ordenadas.size());
+    }
+    MedicaoEtapa medicao(ETAPA_IMPRESSAO);
+    for (const auto& palavra : palavras_ordenadas) {
+        std::wcout << palavra << L": " << contagem.at(palavra) << L'\n';
+    }
+    std::wcout.flush();
+    medicao.palavras(palavras_ordenadas.size());
+}
+
+/**
+ * \brief Função para selecionar as palavras mais frequentes.
+ * 
+ * Esta função copia apenas ponteiros para as entradas do mapa e usa `std::partial_sort`, de forma 
+ * que somente as `k` primeiras posições são de fato ordenadas.
+ * 
+ * \param contagem O mapa que contém as palavras e suas contagens.
+ * \param k O número de palavras desejado; zero seleciona todas.
+ * \return Um vetor de pares (palavra, contagem) com as palavras mais frequentes.
+ */
+std::vector<std::pair<std::wstring, int>> mais_frequentes(const std::map<std::wstring, int>& contagem,
+                                                          std::size_t k) {
+    typedef const std::pair<const std::wstring, int>* Entrada;
+    std::vector<Entrada> entradas;
+    entradas.reserve(contagem.size());
+    for (const auto& par : contagem) {
+        entradas.push_back(&par);
+    }
+    if (k == 0 || k > entradas.size()) {
+        k = entradas.size();
+    }
+
+    // Maior contagem primeiro; empates em ordem alfabética
+    std::partial_sort(entradas.begin(), entradas.begin() + k, entradas.end(),
+                      [](Entrada a, Entrada b) {
+                          return a->second != b->second ? a->second > b->second
+                                                        : a->first < b->first;
+                      });
+
+    std::vector<std::pair<std::wstring, int>> resultado;
+    resultado.reserve(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        resultado.emplace_back(entradas[i]->first, entradas[i]->second);
+    }
+    return resultado;
+}
+
+/**
+ * \brief Função para exibir as palavras mais frequentes.
+ * 
+ * \param contagem O mapa que contém as palavras e suas contagens.
+ * \param k O número de palavras a exibir; zero exibe todas.
+ */
+void imprimir_mais_frequentes(const std::map<std::wstring, int>& contagem, std::size_t k) {
+    std::vector<std::pair<std::wstring, int>> frequentes;
+    {
+        MedicaoEtapa medicao(ETAPA_ORDENACAO);
+        frequentes = mais_frequentes(contagem, k);
+        medicao.palavras(contagem.size());
+    }
+    MedicaoEtapa medicao(ETAPA_IMPRESSAO);
+    for (const auto& par : frequentes) {
+        std::wcout << par.first << L": " << par.second << L'\n';
+    }
+    std::wcout.flush();
+    medicao.palavras(frequentes.size());
+}
+
+/**
+ * \brief Função para contar as palavras de um arquivo.
+ * 
+ * Esta função abre o arquivo uma única vez, lê seu conteúdo pelo mesmo descritor e o entrega de 
+ * uma vez ao `ContadorIncremental`, que decodifica o UTF-8, delimita as palavras e normaliza as 
+ * chaves em uma única passada sobre os bytes, sem a cópia em caracteres largos do texto inteiro. 
+ * Bytes que não formam UTF-8 válido contam como U+FFFD. Arquivos compactados com gzip ou zstd 
+ * são contados em fluxo, sem descomprimir o conteúdo inteiro na memória.
+ * 
+ * \param nome_arquivo O nome do arquivo a ser contado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return Um mapa contendo as palavras e suas respectivas contagens.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto ou lido.
+ */
+std::map<std::wstring, int> contar_palavras_arquivo(const std::string& nome_arquivo, std::uint32_t configuracao) {
+    Arquivo arquivo = abrir_arquivo(nome_arquivo);
+
+    // Arquivos compactados são descomprimidos em fluxo, em paralelo com a contagem
+    char assinatura[TAMANHO_ASSINATURA];
+    ssize_t lidos = ::pread(arquivo.descritor(), assinatura, sizeof(assinatura), 0);
+    if (lidos > 0 && detectar_compressao(assinatura, static_cast<std::size_t>(lidos)) !=
+                         FormatoCompressao::nenhum) {
+        return contar_palavras_fluxo(arquivo.descritor(), configuracao);
+    }
+
+    // Ler o arquivo pelo mesmo descritor, sem abri-lo novamente, e contar na mesma passada
+    // da decodificação
+    std::string conteudo_arquivo = ler_arquivo(arquivo);
+    ContadorIncremental contador(configuracao);
+    contador.alimentar(conteudo_arquivo.data(), conteudo_arquivo.size());
+    contador.finalizar();
+    return contador.extrair_contagem();
+}
+
 /**
  * \brief Função para processar o conteúdo de um arquivo e exibir a contagem de palavras ordenadas.
  * 
@@ -158,21 +446,9 @@ std::wstring remover_acentos(const std::wstring& palavra) {
  * \param nome_arquivo O nome do arquivo a ser processado.
  */
 void processar_arquivo(const std::string& nome_arquivo) {
-    abrir_arquivo(nome_arquivo);
-
-    // Ler o arquivo
-    std::string conteudo_arquivo = ler_arquivo(nome_arquivo);
-    std::wstring_convert<std::codecvt_utf8<wchar_t>> convert;
-    std::wstring conteudo = convert.from_bytes(conteudo_arquivo);
-
     // Contar palavras
-    std::map<std::wstring, int> contagem = contar_palavras(conteudo);
+    std::map<std::wstring, int> contagem = contar_palavras_arquivo(nome_arquivo);
 
-    // Ordenar palavras
-    std::vector<std::wstring> palavras_ordenadas = ordenar_palavras(contagem);
-
-    // Imprimir resultado
-    for (const auto& palavra : palavras_ordenadas) {
-        std::wcout << palavra << L": " << contagem[palavra] << std::endl;
-    }
+    // Ordenar e imprimir resultado
+    imprimir_contagem(contagem);
 }
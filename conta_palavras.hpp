@@ -11,26 +11,78 @@
 #ifndef CONTA_PALAVRAS_HPP_
 #define CONTA_PALAVRAS_HPP_
 
+#include <cstddef>
 #include <string>
 #include <stdexcept>
 #include <fstream>
 #include <vector>
 #include <sstream>
 #include <map>
+#include <utility>
 #include <algorithm>
 #include <locale>
 #include <codecvt>
+#include <cstdint>
+
+#include "tokenizador.hpp"
+
+/**
+ * \brief Manipulador de um arquivo aberto uma única vez.
+ * 
+ * Mantém o descritor do arquivo aberto desde a verificação até a leitura, de forma que o arquivo 
+ * não precise ser aberto novamente. O tamanho é obtido com fstat no momento da abertura e pode ser 
+ * usado para pré-alocar o destino da leitura. O descritor é fechado no destrutor.
+ */
+class Arquivo {
+ public:
+    /**
+     * \brief Abre o arquivo especificado pelo nome.
+     * 
+     * \param nome_arquivo O nome do arquivo a ser aberto.
+     * \throws std::ios_base::failure Se o arquivo não puder ser aberto.
+     */
+    explicit Arquivo(const std::string& nome_arquivo);
+
+    Arquivo(Arquivo&& outro) noexcept;
+    Arquivo& operator=(Arquivo&& outro) noexcept;
+    Arquivo(const Arquivo&) = delete;
+    Arquivo& operator=(const Arquivo&) = delete;
+    ~Arquivo();
+
+    /**
+     * \brief Retorna o descritor do arquivo aberto.
+     */
+    int descritor() const { return descritor_; }
+
+    /**
+     * \brief Retorna o tamanho do arquivo em bytes, obtido com fstat na abertura.
+     * 
+     * Para entradas que não são arquivos regulares (pipes, dispositivos) o tamanho é zero.
+     */
+    std::size_t tamanho() const { return tamanho_; }
+
+    /**
+     * \brief Retorna o nome com o qual o arquivo foi aberto.
+     */
+    const std::string& nome() const { return nome_; }
+
+ private:
+    int descritor_;
+    std::size_t tamanho_;
+    std::string nome_;
+};
 
 /**
  * \brief Função para abrir um arquivo.
  * 
  * Tenta abrir o arquivo especificado pelo nome. Caso o arquivo não possa ser aberto, uma exceção 
- * será lançada.
+ * será lançada. O arquivo aberto é retornado para ser reaproveitado pela etapa de leitura.
  * 
  * \param nome_arquivo O nome do arquivo a ser aberto.
+ * \return O arquivo aberto.
  * \throws std::ios_base::failure Se o arquivo não puder ser aberto.
  */
-void abrir_arquivo(const std::string& nome_arquivo);
+Arquivo abrir_arquivo(const std::string& nome_arquivo);
 
 /**
  * \brief Função para ler o conteúdo de um arquivo.
@@ -43,6 +95,34 @@ void abrir_arquivo(const std::string& nome_arquivo);
  */
 std::string ler_arquivo(const std::string& nome_arquivo);
 
+/**
+ * \brief Função para ler o conteúdo de um arquivo já aberto.
+ * 
+ * Lê todo o conteúdo a partir do descritor de um arquivo aberto por `abrir_arquivo`, sem abri-lo 
+ * novamente. O destino é alocado uma única vez com o tamanho obtido na abertura e retornado por 
+ * movimentação, sem cópias intermediárias.
+ * 
+ * \param arquivo O arquivo aberto a ser lido.
+ * \return Uma string contendo o conteúdo do arquivo.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+ */
+std::string ler_arquivo(Arquivo& arquivo);
+
+/**
+ * \brief Função para ler o conteúdo de um arquivo já aberto para um destino do chamador.
+ * 
+ * Lê todo o conteúdo do arquivo diretamente na memória de `destino`, que é redimensionado uma 
+ * única vez para o tamanho exato do arquivo. A capacidade já alocada em `destino` é reaproveitada, 
+ * o que permite ler muitos arquivos pequenos com o mesmo buffer. Conteúdo compactado com gzip ou 
+ * zstd é reconhecido pelos bytes iniciais e entregue já descomprimido.
+ * 
+ * \param arquivo O arquivo aberto a ser lido.
+ * \param destino A string que recebe o conteúdo do arquivo.
+ * \return O número de bytes do conteúdo entregue em `destino`.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+std::size_t ler_arquivo(Arquivo& arquivo, std::string& destino);
+
 /**
  * \brief Função para separar o texto em palavras.
  * 
@@ -64,26 +144,91 @@ std::vector<std::wstring> separar_palavras(const std::wstring& texto);
  */
 std::map<std::wstring, int> contar_palavras(const std::wstring& texto);
 
+/**
+ * \brief Função para contar as ocorrências de cada palavra no texto com um tokenizador configurado.
+ * 
+ * Separa as palavras com `percorrer_palavras`, que remove ou separa a pontuação e descarta números 
+ * conforme os bits de `ConfiguracaoTokenizador`, e converte-as para minúsculas se 
+ * `TOKENIZADOR_MINUSCULAS` estiver ligado.
+ * 
+ * \param texto O texto onde as palavras serão contadas.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return Um mapa contendo as palavras e suas respectivas contagens.
+ */
+std::map<std::wstring, int> contar_palavras(const std::wstring& texto, std::uint32_t configuracao);
+
 /**
  * \brief Função para ordenar as palavras por ordem alfabética, desconsiderando os acentos.
  * 
  * Ordena as palavras de acordo com suas versões sem acento, mas preservando as palavras originais.
  * 
  * \param contagem O mapa contendo as palavras e suas contagens.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
  * \return Um vetor com as palavras ordenadas sem considerar acentos.
  */
-std::vector<std::wstring> ordenar_palavras(const std::map<std::wstring, int>& contagem);
+std::vector<std::wstring> ordenar_palavras(const std::map<std::wstring, int>& contagem,
+                                           std::uint32_t configuracao = CONFIGURACAO_PADRAO);
 
 /**
  * \brief Função para remover os acentos de uma palavra.
  * 
- * Remove os acentos das letras de uma palavra, substituindo por suas versões sem acento.
+ * Remove os acentos das letras de uma palavra, substituindo por suas versões sem acento, e as 
+ * marcas combinantes.
  * 
  * \param palavra A palavra da qual os acentos serão removidos.
  * \return A palavra sem acento.
  */
 std::wstring remover_acentos(const std::wstring& palavra);
 
+/**
+ * \brief Função para exibir a contagem das palavras ordenadas.
+ * 
+ * Ordena as palavras com `ordenar_palavras` e exibe cada uma com sua contagem em `std::wcout`.
+ * 
+ * \param contagem O mapa contendo as palavras e suas contagens.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+ */
+void imprimir_contagem(const std::map<std::wstring, int>& contagem,
+                       std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+/**
+ * \brief Função para selecionar as palavras mais frequentes.
+ * 
+ * Seleciona as `k` palavras com as maiores contagens, em ordem decrescente de contagem; palavras 
+ * com a mesma contagem aparecem em ordem alfabética. Apenas as `k` primeiras são ordenadas.
+ * 
+ * \param contagem O mapa contendo as palavras e suas contagens.
+ * \param k O número de palavras desejado; zero seleciona todas.
+ * \return Um vetor de pares (palavra, contagem) com as palavras mais frequentes.
+ */
+std::vector<std::pair<std::wstring, int>> mais_frequentes(const std::map<std::wstring, int>& contagem,
+                                                          std::size_t k);
+
+/**
+ * \brief Função para exibir as palavras mais frequentes.
+ * 
+ * Exibe em `std::wcout` as `k` palavras com as maiores contagens, uma por linha.
+ * 
+ * \param contagem O mapa contendo as palavras e suas contagens.
+ * \param k O número de palavras a exibir; zero exibe todas.
+ */
+void imprimir_mais_frequentes(const std::map<std::wstring, int>& contagem, std::size_t k);
+
+/**
+ * \brief Função para contar as palavras de um arquivo.
+ * 
+ * Abre o arquivo, lê seu conteúdo e conta as palavras com as regras de `contar_palavras`, em uma 
+ * única passada que decodifica, separa e normaliza. Arquivos compactados com gzip ou zstd são 
+ * descomprimidos e contados em fluxo.
+ * 
+ * \param nome_arquivo O nome do arquivo a ser contado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return Um mapa contendo as palavras e suas respectivas contagens.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto ou lido.
+ */
+std::map<std::wstring, int> contar_palavras_arquivo(const std::string& nome_arquivo,
+                                                    std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
 /**
  * \brief Função para processar o conteúdo de um arquivo e exibir a contagem das palavras ordenadas.
  * 
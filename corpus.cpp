@@ -0,0 +1,194 @@
+/**
+ * \file corpus.cpp
+ * \brief Implementação da contagem incremental de um corpus formado por muitos arquivos.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "corpus.hpp"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "conta_palavras.hpp"
+#include "fluxo.hpp"
+#include "vocabulario.hpp"
+
+/**
+ * \brief Primeira linha de todo manifesto, seguida da configuração do tokenizador.
+ */
+static const char CABECALHO_MANIFESTO[] = "# conta_palavras manifesto 1";
+
+/**
+ * \brief Carrega o manifesto, ou começa um vazio se ele não existir.
+ *
+ * Linhas malformadas são ignoradas: o arquivo correspondente será apenas recontado.
+ *
+ * \param nome_arquivo O nome do arquivo do manifesto.
+ * \param configuracao A configuração do tokenizador em uso.
+ */
+Manifesto::Manifesto(const std::string& nome_arquivo, std::uint32_t configuracao)
+    : nome_(nome_arquivo), configuracao_(configuracao) {
+    std::ifstream entrada(nome_arquivo);
+    std::string linha;
+    if (!std::getline(entrada, linha) || linha != CABECALHO_MANIFESTO ||
+        !std::getline(entrada, linha) || linha != std::to_string(configuracao_)) {
+        return;
+    }
+    while (std::getline(entrada, linha)) {
+        std::istringstream campos(linha);
+        EntradaManifesto registro;
+        std::string caminho;
+        if (campos >> registro.tamanho >> registro.modificacao >> registro.crc >>
+                registro.instantaneo && campos.get() == '\t' && std::getline(campos, caminho)) {
+            entradas_[caminho] = registro;
+        }
+    }
+}
+
+/**
+ * \brief Grava o manifesto, substituindo o anterior de forma atômica.
+ *
+ * \throws std::ios_base::failure Se o manifesto não puder ser gravado.
+ */
+void Manifesto::gravar() const {
+    std::string temporario = nome_ + ".tmp";
+    {
+        std::ofstream saida(temporario, std::ios::trunc);
+        saida << CABECALHO_MANIFESTO << '\n' << configuracao_ << '\n';
+        for (const auto& par : entradas_) {
+            const EntradaManifesto& registro = par.second;
+            saida << registro.tamanho << '\t' << registro.modificacao << '\t' << registro.crc
+                  << '\t' << registro.instantaneo << '\t' << par.first << '\n';
+        }
+        if (!saida) {
+            throw std::ios_base::failure("Erro ao gravar o manifesto.");
+        }
+    }
+    if (std::rename(temporario.c_str(), nome_.c_str()) != 0) {
+        throw std::ios_base::failure("Erro ao gravar o manifesto.");
+    }
+}
+
+/**
+ * \brief Calcula o nome do instantâneo de um arquivo a partir do seu caminho (FNV-1a de 64 bits).
+ */
+static std::string nome_instantaneo(const std::string& caminho) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : caminho) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    char nome[32];
+    std::snprintf(nome, sizeof(nome), "%016llx.voc", static_cast<unsigned long long>(hash));
+    return nome;
+}
+
+/**
+ * \brief Calcula o CRC-32 de um conteúdo de qualquer tamanho.
+ */
+static std::uint32_t crc_conteudo(const std::string& conteudo) {
+    uLong crc = crc32(0, Z_NULL, 0);
+    const Bytef* cursor = reinterpret_cast<const Bytef*>(conteudo.data());
+    std::size_t restante = conteudo.size();
+    while (restante > 0) {
+        uInt parte = static_cast<uInt>(std::min<std::size_t>(restante, 1u << 30));
+        crc = crc32(crc, cursor, parte);
+        cursor += parte;
+        restante -= parte;
+    }
+    return static_cast<std::uint32_t>(crc);
+}
+
+/**
+ * \brief Função para atualizar a contagem de um corpus recontando apenas os arquivos alterados.
+ *
+ * Arquivos alterados são lidos uma única vez: o mesmo conteúdo serve para o CRC-32 e para a
+ * contagem.
+ *
+ * \param arquivos Os arquivos que formam o corpus.
+ * \param diretorio_cache O diretório dos instantâneos por arquivo e do manifesto.
+ * \param nome_vocabulario O nome do instantâneo global a ser gravado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return O resumo da atualização.
+ * \throws std::ios_base::failure Se algum arquivo não puder ser lido ou o cache não puder ser gravado.
+ */
+ResultadoCorpus atualizar_corpus(const std::vector<std::string>& arquivos,
+                                 const std::string& diretorio_cache,
+                                 const std::string& nome_vocabulario,
+                                 std::uint32_t configuracao) {
+    if (::mkdir(diretorio_cache.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::ios_base::failure("Nao foi possivel criar o diretorio de cache.");
+    }
+    Manifesto manifesto(diretorio_cache + "/manifesto.txt", configuracao);
+    std::map<std::string, EntradaManifesto>& registros = manifesto.entradas();
+    ResultadoCorpus resultado = {0, 0, 0, 0};
+
+    std::set<std::string> presentes;
+    std::vector<std::string> instantaneos;
+    std::string conteudo;
+    for (const auto& caminho : arquivos) {
+        if (!presentes.insert(caminho).second) {
+            continue;  // Arquivo repetido na lista
+        }
+        Arquivo arquivo = abrir_arquivo(caminho);
+        struct stat informacoes;
+        if (::fstat(arquivo.descritor(), &informacoes) != 0) {
+            throw std::ios_base::failure("Nao foi possivel ler os atributos do arquivo.");
+        }
+        std::int64_t modificacao = static_cast<std::int64_t>(informacoes.st_mtim.tv_sec) *
+                                       1000000000 + informacoes.st_mtim.tv_nsec;
+
+        auto registro = registros.find(caminho);
+        std::string instantaneo = diretorio_cache + "/" + nome_instantaneo(caminho);
+        bool existe = ::access(instantaneo.c_str(), R_OK) == 0;
+        if (registro != registros.end() && existe && registro->second.tamanho == arquivo.tamanho() &&
+            registro->second.modificacao == modificacao) {
+            ++resultado.reaproveitados;
+            instantaneos.push_back(instantaneo);
+            continue;
+        }
+
+        ler_arquivo(arquivo, conteudo);
+        std::uint32_t crc = crc_conteudo(conteudo);
+        if (registro == registros.end() || !existe || registro->second.crc != crc ||
+            registro->second.tamanho != arquivo.tamanho()) {
+            // Mesma contagem de `contar_palavras_arquivo`: bytes inválidos contam como U+FFFD
+            ContadorIncremental contador(configuracao);
+            contador.alimentar(conteudo.data(), conteudo.size());
+            contador.finalizar();
+            gravar_vocabulario(contador.contagem(), instantaneo, configuracao);
+            ++resultado.recontados;
+        } else {
+            ++resultado.reaproveitados;  // Só a data mudou: o conteúdo é o mesmo
+        }
+        EntradaManifesto novo = {arquivo.tamanho(), modificacao, crc, nome_instantaneo(caminho)};
+        registros[caminho] = novo;
+        instantaneos.push_back(instantaneo);
+    }
+
+    // Arquivos que saíram do corpus deixam de ter instantâneo
+    for (auto registro = registros.begin(); registro != registros.end();) {
+        if (presentes.count(registro->first) == 0) {
+            std::remove((diretorio_cache + "/" + registro->second.instantaneo).c_str());
+            registro = registros.erase(registro);
+            ++resultado.removidos;
+        } else {
+            ++registro;
+        }
+    }
+
+    manifesto.gravar();
+    resultado.palavras = mesclar_vocabularios(instantaneos, nome_vocabulario);
+    return resultado;
+}
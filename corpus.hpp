@@ -0,0 +1,99 @@
+/**
+ * \file corpus.hpp
+ * \brief Definições para a contagem incremental de um corpus formado por muitos arquivos.
+ *
+ * Este arquivo contém as declarações do manifesto, que registra para cada arquivo do corpus o
+ * tamanho, a data de modificação e o CRC-32 do conteúdo, e da função que reconta apenas os
+ * arquivos alterados e mescla os instantâneos por arquivo em um vocabulário global.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef CORPUS_HPP_
+#define CORPUS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tokenizador.hpp"
+
+/**
+ * \brief Registro de um arquivo do corpus no manifesto.
+ */
+struct EntradaManifesto {
+    std::uint64_t tamanho;       ///< Tamanho do arquivo, em bytes.
+    std::int64_t modificacao;    ///< Data de modificação, em nanossegundos desde a época.
+    std::uint32_t crc;           ///< CRC-32 do conteúdo (já descomprimido).
+    std::string instantaneo;     ///< Nome do instantâneo de vocabulário do arquivo.
+};
+
+/**
+ * \brief Manifesto do cache de instantâneos por arquivo.
+ *
+ * Gravado como texto, uma linha por arquivo, com os campos separados por tabulação e o caminho
+ * do arquivo por último. O manifesto também guarda a configuração do tokenizador; um manifesto
+ * produzido com outra configuração é descartado ao ser carregado.
+ */
+class Manifesto {
+ public:
+    /**
+     * \brief Carrega o manifesto, ou começa um vazio se ele não existir.
+     *
+     * \param nome_arquivo O nome do arquivo do manifesto.
+     * \param configuracao A configuração do tokenizador em uso.
+     */
+    Manifesto(const std::string& nome_arquivo, std::uint32_t configuracao);
+
+    /**
+     * \brief Grava o manifesto, substituindo o anterior de forma atômica.
+     *
+     * \throws std::ios_base::failure Se o manifesto não puder ser gravado.
+     */
+    void gravar() const;
+
+    /**
+     * \brief Retorna os registros, indexados pelo caminho do arquivo.
+     */
+    std::map<std::string, EntradaManifesto>& entradas() { return entradas_; }
+
+ private:
+    std::string nome_;
+    std::uint32_t configuracao_;
+    std::map<std::string, EntradaManifesto> entradas_;
+};
+
+/**
+ * \brief Resumo de uma atualização incremental do corpus.
+ */
+struct ResultadoCorpus {
+    std::size_t recontados;      ///< Arquivos novos ou alterados, que foram contados.
+    std::size_t reaproveitados;  ///< Arquivos inalterados, cujo instantâneo foi reaproveitado.
+    std::size_t removidos;       ///< Arquivos que saíram do corpus desde a última atualização.
+    std::uint64_t palavras;      ///< Palavras distintas no vocabulário global.
+};
+
+/**
+ * \brief Função para atualizar a contagem de um corpus recontando apenas os arquivos alterados.
+ *
+ * Cada arquivo tem seu próprio instantâneo no diretório de cache. Um arquivo cujo tamanho e data
+ * de modificação coincidem com os do manifesto é reaproveitado sem ser lido; se apenas a data
+ * mudou, o conteúdo é lido e comparado pelo CRC-32 antes de ser recontado. Ao final, todos os
+ * instantâneos são mesclados em `nome_vocabulario` com `mesclar_vocabularios`.
+ *
+ * \param arquivos Os arquivos que formam o corpus.
+ * \param diretorio_cache O diretório dos instantâneos por arquivo e do manifesto; é criado se não existir.
+ * \param nome_vocabulario O nome do instantâneo global a ser gravado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`; um cache gravado com outra configuração
+ * é recontado por inteiro.
+ * \return O resumo da atualização.
+ * \throws std::ios_base::failure Se algum arquivo não puder ser lido ou o cache não puder ser gravado.
+ */
+ResultadoCorpus atualizar_corpus(const std::vector<std::string>& arquivos,
+                                 const std::string& diretorio_cache,
+                                 const std::string& nome_vocabulario,
+                                 std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+#endif  // CORPUS_HPP_
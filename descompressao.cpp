@@ -0,0 +1,216 @@
+/**
+ * \file descompressao.cpp
+ * \brief Implementação da detecção e da descompressão em fluxo de entradas gzip e zstd.
+ *
+ * O gzip é tratado com a zlib. O zstd só é descomprimido quando o programa é compilado com
+ * `-DCONTA_PALAVRAS_ZSTD` e ligado com `-lzstd`; sem isso, entradas zstd são reconhecidas e
+ * rejeitadas com uma mensagem de erro, em vez de serem contadas como texto.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "descompressao.hpp"
+
+#include <zlib.h>
+#ifdef CONTA_PALAVRAS_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Tamanho do buffer de saída de cada descompressor, em bytes.
+ */
+static const std::size_t TAMANHO_SAIDA_DESCOMPRESSAO = 256 * 1024;
+
+/**
+ * \brief Função para detectar o formato de compressão pelos bytes iniciais da entrada.
+ *
+ * \param dados Os primeiros bytes da entrada.
+ * \param tamanho O número de bytes disponíveis.
+ * \return O formato reconhecido, ou `FormatoCompressao::nenhum`.
+ */
+FormatoCompressao detectar_compressao(const char* dados, std::size_t tamanho) {
+    const unsigned char* byte = reinterpret_cast<const unsigned char*>(dados);
+    if (tamanho >= 2 && byte[0] == 0x1F && byte[1] == 0x8B) {
+        return FormatoCompressao::gzip;
+    }
+    if (tamanho >= 4 && byte[0] == 0x28 && byte[1] == 0xB5 && byte[2] == 0x2F && byte[3] == 0xFD) {
+        return FormatoCompressao::zstd;
+    }
+    return FormatoCompressao::nenhum;
+}
+
+/**
+ * \brief Descompressor de gzip em fluxo, baseado na zlib.
+ *
+ * Aceita vários membros gzip concatenados, como os produzidos por `cat a.gz b.gz`.
+ */
+class DescompressorGzip : public Descompressor {
+ public:
+    DescompressorGzip() : saida_(TAMANHO_SAIDA_DESCOMPRESSAO), terminado_(false) {
+        std::memset(&fluxo_, 0, sizeof(fluxo_));
+        // 15 + 16: janela máxima e somente o cabeçalho gzip
+        if (inflateInit2(&fluxo_, 15 + 16) != Z_OK) {
+            throw std::ios_base::failure("Nao foi possivel iniciar a descompressao gzip.");
+        }
+    }
+
+    ~DescompressorGzip() override {
+        inflateEnd(&fluxo_);
+    }
+
+    void alimentar(const char* dados, std::size_t tamanho,
+                   const SaidaDescompressao& saida) override {
+        // avail_in é um uInt de 32 bits: entradas maiores são entregues à zlib em partes
+        const std::size_t maximo = std::numeric_limits<uInt>::max();
+        do {
+            std::size_t parte = std::min(tamanho, maximo);
+            fluxo_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(dados));
+            fluxo_.avail_in = static_cast<uInt>(parte);
+            inflar(saida);
+            dados += parte;
+            tamanho -= parte;
+        } while (tamanho > 0);
+    }
+
+    void finalizar() override {
+        if (!terminado_) {
+            throw std::ios_base::failure("Arquivo gzip incompleto.");
+        }
+    }
+
+ private:
+    /**
+     * \brief Descomprime a entrada pendente no fluxo, entregando cada bloco produzido.
+     */
+    void inflar(const SaidaDescompressao& saida) {
+        while (fluxo_.avail_in > 0 || fluxo_.avail_out == 0) {
+            if (terminado_) {
+                // Um novo membro começa depois do fim do anterior
+                inflateReset(&fluxo_);
+                terminado_ = false;
+            }
+            fluxo_.next_out = reinterpret_cast<Bytef*>(saida_.data());
+            fluxo_.avail_out = static_cast<uInt>(saida_.size());
+            int resultado = inflate(&fluxo_, Z_NO_FLUSH);
+            if (resultado == Z_BUF_ERROR && fluxo_.avail_in == 0) {
+                break;  // A saída anterior já estava completa; é preciso mais entrada
+            }
+            if (resultado != Z_OK && resultado != Z_STREAM_END) {
+                throw std::ios_base::failure("Arquivo gzip corrompido.");
+            }
+            std::size_t produzidos = saida_.size() - fluxo_.avail_out;
+            if (produzidos > 0) {
+                saida(saida_.data(), produzidos);
+            }
+            if (resultado == Z_STREAM_END) {
+                terminado_ = true;
+                fluxo_.avail_out = 1;  // Não há saída pendente no fim de um membro
+            }
+        }
+    }
+
+    z_stream fluxo_;
+    std::vector<char> saida_;
+    bool terminado_;
+};
+
+#ifdef CONTA_PALAVRAS_ZSTD
+/**
+ * \brief Descompressor de zstd em fluxo, baseado na libzstd.
+ *
+ * Quadros zstd concatenados são tratados pela própria biblioteca.
+ */
+class DescompressorZstd : public Descompressor {
+ public:
+    DescompressorZstd()
+        : fluxo_(ZSTD_createDStream()), saida_(TAMANHO_SAIDA_DESCOMPRESSAO), pendente_(1) {
+        if (fluxo_ == nullptr || ZSTD_isError(ZSTD_initDStream(fluxo_))) {
+            ZSTD_freeDStream(fluxo_);
+            throw std::ios_base::failure("Nao foi possivel iniciar a descompressao zstd.");
+        }
+    }
+
+    ~DescompressorZstd() override {
+        ZSTD_freeDStream(fluxo_);
+    }
+
+    void alimentar(const char* dados, std::size_t tamanho,
+                   const SaidaDescompressao& saida) override {
+        ZSTD_inBuffer entrada = {dados, tamanho, 0};
+        for (;;) {
+            ZSTD_outBuffer destino = {saida_.data(), saida_.size(), 0};
+            pendente_ = ZSTD_decompressStream(fluxo_, &destino, &entrada);
+            if (ZSTD_isError(pendente_)) {
+                throw std::ios_base::failure("Arquivo zstd corrompido.");
+            }
+            if (destino.pos > 0) {
+                saida(saida_.data(), destino.pos);
+            }
+            if (entrada.pos == entrada.size && destino.pos < destino.size) {
+                break;
+            }
+        }
+    }
+
+    void finalizar() override {
+        if (pendente_ != 0) {
+            throw std::ios_base::failure("Arquivo zstd incompleto.");
+        }
+    }
+
+ private:
+    ZSTD_DStream* fluxo_;
+    std::vector<char> saida_;
+    std::size_t pendente_;
+};
+#endif  // CONTA_PALAVRAS_ZSTD
+
+/**
+ * \brief Cria o descompressor adequado ao formato.
+ *
+ * \param formato O formato da entrada.
+ * \return O descompressor criado.
+ * \throws std::ios_base::failure Se o formato não for suportado nesta compilação.
+ */
+std::unique_ptr<Descompressor> Descompressor::criar(FormatoCompressao formato) {
+    switch (formato) {
+        case FormatoCompressao::gzip:
+            return std::unique_ptr<Descompressor>(new DescompressorGzip());
+        case FormatoCompressao::zstd:
+#ifdef CONTA_PALAVRAS_ZSTD
+            return std::unique_ptr<Descompressor>(new DescompressorZstd());
+#else
+            throw std::ios_base::failure("Suporte a zstd nao foi compilado.");
+#endif
+        case FormatoCompressao::nenhum:
+            break;
+    }
+    throw std::ios_base::failure("Formato de compressao invalido.");
+}
+
+/**
+ * \brief Função para descomprimir um conteúdo inteiro já carregado na memória.
+ *
+ * \param formato O formato do conteúdo.
+ * \param conteudo Os bytes compactados.
+ * \return Os bytes descomprimidos.
+ * \throws std::ios_base::failure Se o conteúdo estiver corrompido ou o formato não for suportado.
+ */
+std::string descomprimir(FormatoCompressao formato, const std::string& conteudo) {
+    std::unique_ptr<Descompressor> descompressor = Descompressor::criar(formato);
+    std::string resultado;
+    descompressor->alimentar(conteudo.data(), conteudo.size(),
+                             [&resultado](const char* dados, std::size_t tamanho) {
+                                 resultado.append(dados, tamanho);
+                             });
+    descompressor->finalizar();
+    return resultado;
+}
@@ -0,0 +1,95 @@
+/**
+ * \file descompressao.hpp
+ * \brief Definições para detectar e descomprimir entradas compactadas (gzip e zstd).
+ *
+ * Este arquivo contém as declarações das funções que reconhecem o formato de uma entrada pelos
+ * seus bytes iniciais e dos descompressores em fluxo usados pela leitura de arquivos e de pipes.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef DESCOMPRESSAO_HPP_
+#define DESCOMPRESSAO_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * \brief Formatos de compressão reconhecidos na entrada.
+ */
+enum class FormatoCompressao {
+    nenhum,  ///< Texto sem compressão.
+    gzip,    ///< Formato gzip (bytes iniciais 1F 8B).
+    zstd     ///< Formato Zstandard (bytes iniciais 28 B5 2F FD).
+};
+
+/**
+ * \brief Número de bytes iniciais necessários para reconhecer qualquer formato.
+ */
+const std::size_t TAMANHO_ASSINATURA = 4;
+
+/**
+ * \brief Função para detectar o formato de compressão pelos bytes iniciais da entrada.
+ *
+ * \param dados Os primeiros bytes da entrada.
+ * \param tamanho O número de bytes disponíveis.
+ * \return O formato reconhecido, ou `FormatoCompressao::nenhum`.
+ */
+FormatoCompressao detectar_compressao(const char* dados, std::size_t tamanho);
+
+/**
+ * \brief Função chamada com cada trecho de dados já descomprimido.
+ */
+typedef std::function<void(const char*, std::size_t)> SaidaDescompressao;
+
+/**
+ * \brief Descompressor em fluxo.
+ *
+ * Recebe a entrada compactada em pedaços arbitrários e entrega os dados descomprimidos à função
+ * de saída assim que são produzidos, sem manter a entrada ou a saída inteiras na memória.
+ */
+class Descompressor {
+ public:
+    virtual ~Descompressor() {}
+
+    /**
+     * \brief Cria o descompressor adequado ao formato.
+     *
+     * \param formato O formato da entrada; não pode ser `FormatoCompressao::nenhum`.
+     * \return O descompressor criado.
+     * \throws std::ios_base::failure Se o formato não for suportado nesta compilação.
+     */
+    static std::unique_ptr<Descompressor> criar(FormatoCompressao formato);
+
+    /**
+     * \brief Descomprime mais um pedaço da entrada.
+     *
+     * \param dados Os bytes compactados.
+     * \param tamanho O número de bytes.
+     * \param saida A função que recebe os dados descomprimidos.
+     * \throws std::ios_base::failure Se a entrada estiver corrompida.
+     */
+    virtual void alimentar(const char* dados, std::size_t tamanho,
+                           const SaidaDescompressao& saida) = 0;
+
+    /**
+     * \brief Indica o fim da entrada.
+     *
+     * \throws std::ios_base::failure Se a entrada terminar no meio de um bloco compactado.
+     */
+    virtual void finalizar() = 0;
+};
+
+/**
+ * \brief Função para descomprimir um conteúdo inteiro já carregado na memória.
+ *
+ * \param formato O formato do conteúdo.
+ * \param conteudo Os bytes compactados.
+ * \return Os bytes descomprimidos.
+ * \throws std::ios_base::failure Se o conteúdo estiver corrompido ou o formato não for suportado.
+ */
+std::string descomprimir(FormatoCompressao formato, const std::string& conteudo);
+
+#endif  // DESCOMPRESSAO_HPP_
@@ -0,0 +1,217 @@
+/**
+ * \file estatisticas.cpp
+ * \brief Implementação da instrumentação por etapa da contagem de palavras.
+ *
+ * Os totais de cada etapa são atômicos, pois a descompressão e a contagem executam em threads
+ * diferentes; cada medição soma aos totais uma única vez, no fim. As alocações são contadas por
+ * thread, pelo operador `new` de `alocacoes.cpp`, para que uma etapa não contabilize as alocações
+ * de outra executada em paralelo.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "estatisticas.hpp"
+
+#include <time.h>
+
+#include <atomic>
+#include <cstdio>
+
+#ifndef CONTA_PALAVRAS_SEM_ESTATISTICAS
+
+thread_local std::uint64_t alocacoes_thread = 0;
+thread_local std::uint64_t bytes_alocados_thread = 0;
+
+namespace {
+
+/**
+ * \brief Totais acumulados de uma etapa.
+ */
+struct TotaisEtapa {
+    std::atomic<std::uint64_t> chamadas;
+    std::atomic<std::uint64_t> nanossegundos;
+    std::atomic<std::uint64_t> nanossegundos_cpu;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::uint64_t> palavras;
+    std::atomic<std::uint64_t> alocacoes;
+    std::atomic<std::uint64_t> bytes_alocados;
+};
+
+const char* const NOMES_ETAPAS[NUMERO_ETAPAS] = {"leitura",   "descompressao", "contagem",
+                                                 "ordenacao", "impressao"};
+
+std::atomic<bool> ativas(false);
+std::chrono::steady_clock::time_point ativacao;
+TotaisEtapa totais[NUMERO_ETAPAS];
+std::atomic<std::uint64_t> buscas_tabela(0);
+std::atomic<std::uint64_t> insercoes_tabela(0);
+std::atomic<std::uint64_t> buscas_sondadas(0);
+std::atomic<std::uint64_t> posicoes_sondadas(0);
+
+/**
+ * \brief Retorna o tempo de CPU da thread atual, em nanossegundos.
+ */
+std::uint64_t tempo_cpu() {
+    struct timespec agora;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &agora) != 0) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(agora.tv_sec) * 1000000000u + static_cast<std::uint64_t>(agora.tv_nsec);
+}
+
+void somar(std::atomic<std::uint64_t>& total, std::uint64_t valor) {
+    total.fetch_add(valor, std::memory_order_relaxed);
+}
+
+std::uint64_t ler(const std::atomic<std::uint64_t>& total) {
+    return total.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+bool estatisticas_disponiveis() {
+    return true;
+}
+
+void ativar_estatisticas(bool ativar) {
+    if (ativar) {
+        for (TotaisEtapa& etapa : totais) {
+            etapa.chamadas = 0;
+            etapa.nanossegundos = 0;
+            etapa.nanossegundos_cpu = 0;
+            etapa.bytes = 0;
+            etapa.palavras = 0;
+            etapa.alocacoes = 0;
+            etapa.bytes_alocados = 0;
+        }
+        buscas_tabela = 0;
+        insercoes_tabela = 0;
+        buscas_sondadas = 0;
+        posicoes_sondadas = 0;
+        ativacao = std::chrono::steady_clock::now();
+    }
+    ativas.store(ativar, std::memory_order_release);
+}
+
+std::uint64_t alocacoes_da_thread() {
+    return alocacoes_thread;
+}
+
+std::uint64_t bytes_alocados_da_thread() {
+    return bytes_alocados_thread;
+}
+
+MedicaoEtapa::MedicaoEtapa(EtapaContagem etapa)
+    : etapa_(etapa), ativa_(ativas.load(std::memory_order_relaxed)), inicio_cpu_(0), alocacoes_(0),
+      bytes_alocados_(0), bytes_(0), palavras_(0) {
+    if (ativa_) {
+        inicio_ = std::chrono::steady_clock::now();
+        inicio_cpu_ = tempo_cpu();
+        alocacoes_ = alocacoes_thread;
+        bytes_alocados_ = bytes_alocados_thread;
+    }
+}
+
+MedicaoEtapa::~MedicaoEtapa() {
+    if (!ativa_) {
+        return;
+    }
+    TotaisEtapa& total = totais[etapa_];
+    auto decorrido = std::chrono::steady_clock::now() - inicio_;
+    somar(total.chamadas, 1);
+    somar(total.nanossegundos, static_cast<std::uint64_t>(
+                                   std::chrono::duration_cast<std::chrono::nanoseconds>(decorrido).count()));
+    somar(total.nanossegundos_cpu, tempo_cpu() - inicio_cpu_);
+    somar(total.bytes, bytes_);
+    somar(total.palavras, palavras_);
+    somar(total.alocacoes, alocacoes_thread - alocacoes_);
+    somar(total.bytes_alocados, bytes_alocados_thread - bytes_alocados_);
+}
+
+void registrar_tabela(std::uint64_t buscas, std::uint64_t insercoes) {
+    if (ativas.load(std::memory_order_relaxed)) {
+        somar(buscas_tabela, buscas);
+        somar(insercoes_tabela, insercoes);
+    }
+}
+
+void registrar_sondagens(std::uint64_t buscas, std::uint64_t posicoes) {
+    if (ativas.load(std::memory_order_relaxed)) {
+        somar(buscas_sondadas, buscas);
+        somar(posicoes_sondadas, posicoes);
+    }
+}
+
+/**
+ * \brief Exibe o relatório das etapas executadas, em JSON.
+ *
+ * Apenas as etapas executadas ao menos uma vez aparecem. As vazões são calculadas sobre o tempo de
+ * relógio da etapa; o tempo total vai da ativação até o relatório. As sondagens só aparecem
+ * preenchidas quando alguma tabela de dispersão aberta foi usada, como na contagem de n-gramas.
+ *
+ * \param saida O fluxo de destino.
+ */
+void imprimir_estatisticas(std::ostream& saida) {
+    char linha[512];
+    double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - ativacao).count();
+    std::snprintf(linha, sizeof(linha), "{\n  \"tempo_total_ms\": %.3f,\n  \"etapas\": [", total_ms);
+    saida << linha;
+    const char* separador = "\n";
+    for (int i = 0; i < NUMERO_ETAPAS; ++i) {
+        const TotaisEtapa& etapa = totais[i];
+        std::uint64_t chamadas = ler(etapa.chamadas);
+        if (chamadas == 0) {
+            continue;
+        }
+        double segundos = static_cast<double>(ler(etapa.nanossegundos)) / 1e9;
+        double bytes = static_cast<double>(ler(etapa.bytes));
+        double palavras = static_cast<double>(ler(etapa.palavras));
+        std::snprintf(linha, sizeof(linha),
+                      "%s    {\"etapa\": \"%s\", \"chamadas\": %llu, \"tempo_ms\": %.3f, \"cpu_ms\": %.3f, "
+                      "\"bytes\": %.0f, \"palavras\": %.0f, \"mb_por_s\": %.1f, \"palavras_por_s\": %.0f, "
+                      "\"alocacoes\": %llu, \"bytes_alocados\": %llu}",
+                      separador, NOMES_ETAPAS[i], static_cast<unsigned long long>(chamadas), segundos * 1e3,
+                      static_cast<double>(ler(etapa.nanossegundos_cpu)) / 1e6, bytes, palavras,
+                      segundos > 0.0 ? bytes / 1048576.0 / segundos : 0.0,
+                      segundos > 0.0 ? palavras / segundos : 0.0,
+                      static_cast<unsigned long long>(ler(etapa.alocacoes)),
+                      static_cast<unsigned long long>(ler(etapa.bytes_alocados)));
+        saida << linha;
+        separador = ",\n";
+    }
+    std::uint64_t buscas = ler(buscas_tabela);
+    std::uint64_t insercoes = ler(insercoes_tabela);
+    std::snprintf(linha, sizeof(linha),
+                  "\n  ],\n  \"tabela\": {\"buscas\": %llu, \"insercoes\": %llu, \"acertos\": %.4f},",
+                  static_cast<unsigned long long>(buscas), static_cast<unsigned long long>(insercoes),
+                  buscas > 0 ? static_cast<double>(buscas - insercoes) / static_cast<double>(buscas) : 0.0);
+    saida << linha;
+    std::uint64_t sondadas = ler(buscas_sondadas);
+    std::uint64_t posicoes = ler(posicoes_sondadas);
+    std::snprintf(linha, sizeof(linha),
+                  "\n  \"sondagens\": {\"buscas\": %llu, \"posicoes\": %llu, \"media\": %.4f}\n}\n",
+                  static_cast<unsigned long long>(sondadas), static_cast<unsigned long long>(posicoes),
+                  sondadas > 0 ? static_cast<double>(posicoes) / static_cast<double>(sondadas) : 0.0);
+    saida << linha;
+    saida.flush();
+}
+
+#else
+
+bool estatisticas_disponiveis() {
+    return false;
+}
+
+void ativar_estatisticas(bool) {}
+
+void imprimir_estatisticas(std::ostream&) {}
+
+std::uint64_t alocacoes_da_thread() {
+    return 0;
+}
+
+std::uint64_t bytes_alocados_da_thread() {
+    return 0;
+}
+
+#endif  // CONTA_PALAVRAS_SEM_ESTATISTICAS
@@ -0,0 +1,140 @@
+/**
+ * \file estatisticas.hpp
+ * \brief Definições da instrumentação por etapa da contagem de palavras.
+ *
+ * Cada etapa (leitura, descompressão, decodificação, contagem, ordenação e impressão) registra,
+ * enquanto as estatísticas estiverem ativas, o tempo de relógio, o tempo de CPU da thread que a
+ * executa, os bytes e as palavras processados e as alocações feitas. A tabela de contagem
+ * registra as buscas e as inserções. A contagem de palavras usa um `std::map`, uma árvore sem
+ * sondagens; as tabelas de dispersão aberta dos n-gramas registram também o número de posições
+ * examinadas pelas buscas. O filtro de palavras vazias, um hash perfeito mínimo, examina sempre uma
+ * única posição e não é registrado.
+ *
+ * As alocações só são contadas nos programas ligados a `alocacoes.cpp`, que substitui o operador
+ * `new` global; nos demais, como os testes, os contadores ficam em zero e as alocações não passam
+ * por nenhum código extra.
+ *
+ * Compilada com `-DCONTA_PALAVRAS_SEM_ESTATISTICAS`, a instrumentação é removida por completo:
+ * `MedicaoEtapa` e `registrar_tabela` ficam vazias e são eliminadas pelo compilador, e
+ * `alocacoes.cpp` não substitui o operador `new`.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef ESTATISTICAS_HPP_
+#define ESTATISTICAS_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * \brief As etapas instrumentadas.
+ */
+enum EtapaContagem {
+    ETAPA_LEITURA,         ///< Leitura do arquivo ou da entrada.
+    ETAPA_DESCOMPRESSAO,   ///< Descompressão de entradas gzip ou zstd.
+    ETAPA_CONTAGEM,        ///< Separação e contagem das palavras (inclui a decodificação do UTF-8).
+    ETAPA_ORDENACAO,       ///< Ordenação das palavras para a exibição.
+    ETAPA_IMPRESSAO,       ///< Escrita do resultado.
+    NUMERO_ETAPAS
+};
+
+/**
+ * \brief Indica se a instrumentação foi compilada no programa.
+ */
+bool estatisticas_disponiveis();
+
+/**
+ * \brief Ativa ou desativa o registro das estatísticas; ao ativar, zera os totais.
+ */
+void ativar_estatisticas(bool ativar);
+
+/**
+ * \brief Exibe o relatório das etapas executadas, em JSON.
+ *
+ * \param saida O fluxo de destino.
+ */
+void imprimir_estatisticas(std::ostream& saida);
+
+/**
+ * \brief Retorna o número de alocações feitas pela thread atual (zero sem `alocacoes.cpp`).
+ */
+std::uint64_t alocacoes_da_thread();
+
+/**
+ * \brief Retorna o número de bytes alocados pela thread atual (zero sem `alocacoes.cpp`).
+ */
+std::uint64_t bytes_alocados_da_thread();
+
+#ifndef CONTA_PALAVRAS_SEM_ESTATISTICAS
+
+/**
+ * \brief Alocações feitas pela thread atual, somadas pelo operador `new` de `alocacoes.cpp`.
+ */
+extern thread_local std::uint64_t alocacoes_thread;
+
+/**
+ * \brief Bytes alocados pela thread atual, somados pelo operador `new` de `alocacoes.cpp`.
+ */
+extern thread_local std::uint64_t bytes_alocados_thread;
+
+/**
+ * \brief Mede uma execução de uma etapa, do construtor ao destrutor.
+ *
+ * Quando as estatísticas estão inativas, a medição custa apenas a consulta de um indicador.
+ */
+class MedicaoEtapa {
+ public:
+    explicit MedicaoEtapa(EtapaContagem etapa);
+    ~MedicaoEtapa();
+
+    MedicaoEtapa(const MedicaoEtapa&) = delete;
+    MedicaoEtapa& operator=(const MedicaoEtapa&) = delete;
+
+    /**
+     * \brief Soma bytes processados nesta execução.
+     */
+    void bytes(std::uint64_t quantidade) { bytes_ += quantidade; }
+
+    /**
+     * \brief Soma palavras processadas nesta execução.
+     */
+    void palavras(std::uint64_t quantidade) { palavras_ += quantidade; }
+
+ private:
+    EtapaContagem etapa_;
+    bool ativa_;
+    std::chrono::steady_clock::time_point inicio_;
+    std::uint64_t inicio_cpu_;
+    std::uint64_t alocacoes_;
+    std::uint64_t bytes_alocados_;
+    std::uint64_t bytes_;
+    std::uint64_t palavras_;
+};
+
+/**
+ * \brief Registra buscas e inserções na tabela de contagem.
+ */
+void registrar_tabela(std::uint64_t buscas, std::uint64_t insercoes);
+
+/**
+ * \brief Registra buscas em uma tabela de dispersão aberta e as posições examinadas por elas.
+ */
+void registrar_sondagens(std::uint64_t buscas, std::uint64_t posicoes);
+
+#else
+
+class MedicaoEtapa {
+ public:
+    explicit MedicaoEtapa(EtapaContagem) {}
+    void bytes(std::uint64_t) {}
+    void palavras(std::uint64_t) {}
+};
+
+inline void registrar_tabela(std::uint64_t, std::uint64_t) {}
+inline void registrar_sondagens(std::uint64_t, std::uint64_t) {}
+
+#endif  // CONTA_PALAVRAS_SEM_ESTATISTICAS
+
+#endif  // ESTATISTICAS_HPP_
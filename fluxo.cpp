@@ -0,0 +1,667 @@
+/**
+ * \file fluxo.cpp
+ * \brief Implementação da contagem de palavras de uma entrada lida em fluxo.
+ *
+ * Este arquivo contém a implementação do leitor em blocos, do contador incremental e das funções
+ * que contam e exibem as palavras lidas de um descritor, como a entrada padrão.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "fluxo.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <ios>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "conta_palavras.hpp"
+#include "descompressao.hpp"
+#include "estatisticas.hpp"
+
+/**
+ * \brief Caractere usado no lugar de bytes que não formam UTF-8 válido (U+FFFD).
+ */
+static const wchar_t CARACTERE_SUBSTITUICAO = 0xFFFD;
+
+/**
+ * \brief Cria um leitor para o descritor informado.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param tamanho_bloco O tamanho do buffer de leitura, em bytes.
+ */
+LeitorBlocos::LeitorBlocos(int descritor, std::size_t tamanho_bloco)
+    : descritor_(descritor), buffer_(tamanho_bloco) {
+    struct stat informacoes;
+    if (::fstat(descritor_, &informacoes) != 0) {
+        return;
+    }
+    if (S_ISFIFO(informacoes.st_mode)) {
+#ifdef F_SETPIPE_SZ
+        // Um pipe maior deixa o produtor escrever um bloco inteiro sem bloquear
+        ::fcntl(descritor_, F_SETPIPE_SZ, static_cast<int>(tamanho_bloco));
+#endif
+    } else if (S_ISREG(informacoes.st_mode)) {
+#ifdef POSIX_FADV_SEQUENTIAL
+        ::posix_fadvise(descritor_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+}
+
+/**
+ * \brief Lê o próximo bloco do descritor.
+ *
+ * Faz uma única leitura bem-sucedida, repetindo apenas se ela for interrompida por um sinal.
+ *
+ * \return O número de bytes disponíveis em `dados()`, ou zero no fim da entrada.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+ */
+std::size_t LeitorBlocos::proximo() {
+    MedicaoEtapa medicao(ETAPA_LEITURA);
+    for (;;) {
+        ssize_t lidos = ::read(descritor_, buffer_.data(), buffer_.size());
+        if (lidos >= 0) {
+            medicao.bytes(static_cast<std::uint64_t>(lidos));
+            return static_cast<std::size_t>(lidos);
+        }
+        if (errno != EINTR) {
+            throw std::ios_base::failure("Erro ao ler a entrada.");
+        }
+    }
+}
+
+/**
+ * \brief Tarefa de `despachar_normalizacao` que escolhe o laço de decodificação da política.
+ */
+template <typename Politica>
+struct ContadorIncremental::SelecaoDecodificador {
+    static Decodificador executar() { return &ContadorIncremental::decodificar<Politica>; }
+};
+
+/**
+ * \brief Cria um contador vazio.
+ *
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ */
+ContadorIncremental::ContadorIncremental(std::uint32_t configuracao)
+    : processados_(0), palavras_(0), insercoes_(0), inicio_palavra_(0), inicio_caractere_(0), memoria_(0), limite_(0),
+      ponto_codigo_(0), minimo_(0), configuracao_(configuracao), restantes_(0), agrupar_formas_(false),
+      chave_direta_(false), contar_(true), rastrear_posicoes_(false) {
+    escolher_decodificador();
+    filtro_ = filtro_palavras_vazias(configuracao_);
+}
+
+/**
+ * \brief Escolhe o laço de decodificação conforme a configuração e o modo de contagem.
+ *
+ * Quando a palavra ainda será dividida ou agrupada, os acentos só são removidos das partes, para
+ * que o deslocamento de cada parte seja calculado sobre os caracteres originais e para que a
+ * forma original continue disponível; o laço é então escolhido sem a remoção de acentos. Com uma
+ * forma normal, a palavra é decodificada sem alterações, porque a conversão para minúsculas e a
+ * remoção dos acentos só podem vir depois da normalização.
+ */
+void ContadorIncremental::escolher_decodificador() {
+    const std::uint32_t forma_normal = TOKENIZADOR_NFC | TOKENIZADOR_NFD;
+    chave_direta_ = !divide_na_pontuacao(configuracao_) && !agrupar_formas_ && (configuracao_ & forma_normal) == 0;
+    std::uint32_t normalizacao = configuracao_;
+    if (configuracao_ & forma_normal) {
+        normalizacao = 0;
+    } else if (!chave_direta_) {
+        normalizacao &= ~static_cast<std::uint32_t>(TOKENIZADOR_SEM_ACENTOS);
+    }
+    decodificador_ = despachar_normalizacao<SelecaoDecodificador>(normalizacao);
+    rastrear_posicoes_ = static_cast<bool>(observador_) && !chave_direta_;
+}
+
+/**
+ * \brief Passa a contar as palavras agrupadas sem acentos, guardando as formas originais.
+ *
+ * A decodificação deixa de remover os acentos, para que a palavra acumulada seja a forma
+ * original; a chave sem acentos é obtida dela ao encerrar a palavra. O filtro de palavras vazias
+ * passa a ser o das chaves sem acentos, já compilado se outra contagem o usou.
+ */
+void ContadorIncremental::agrupar_formas() {
+    agrupar_formas_ = true;
+    configuracao_ |= TOKENIZADOR_SEM_ACENTOS;
+    escolher_decodificador();
+    filtro_ = filtro_palavras_vazias(configuracao_);
+}
+
+/**
+ * \brief Processa mais um pedaço do texto.
+ *
+ * A decodificação e a contagem são medidas juntas, como a etapa de contagem.
+ *
+ * \param dados Os bytes do pedaço, em UTF-8.
+ * \param tamanho O número de bytes do pedaço.
+ */
+void ContadorIncremental::alimentar(const char* dados, std::size_t tamanho) {
+    MedicaoEtapa medicao(ETAPA_CONTAGEM);
+    const std::uint64_t palavras = palavras_;
+    const std::uint64_t insercoes = insercoes_;
+    (this->*decodificador_)(reinterpret_cast<const unsigned char*>(dados), tamanho);
+    medicao.bytes(tamanho);
+    medicao.palavras(palavras_ - palavras);
+    if (contar_) {
+        registrar_tabela(palavras_ - palavras, insercoes_ - insercoes);
+    }
+}
+
+/**
+ * \brief Decodifica um pedaço do texto com a política de normalização fixa.
+ *
+ * Decodifica o UTF-8 byte a byte, guardando o estado de uma sequência incompleta para o próximo
+ * pedaço. Bytes ASCII, que são a maior parte do texto, são tratados sem consultar as tabelas. O
+ * deslocamento do início da palavra atual é guardado para o observador de palavras; se a palavra
+ * ainda puder ser dividida, o de cada caractere também.
+ *
+ * \param dados Os bytes do pedaço, em UTF-8.
+ * \param tamanho O número de bytes do pedaço.
+ */
+template <typename Politica>
+void ContadorIncremental::decodificar(const unsigned char* dados, std::size_t tamanho) {
+    const unsigned char* byte = dados;
+    const unsigned char* fim = byte + tamanho;
+    const std::uint64_t base = processados_;
+    processados_ += tamanho;
+    while (byte != fim) {
+        unsigned char c = *byte;
+        if (restantes_ > 0) {
+            if ((c & 0xC0) == 0x80) {
+                ponto_codigo_ = (ponto_codigo_ << 6) | (c & 0x3F);
+                ++byte;
+                if (--restantes_ == 0) {
+                    bool invalido = ponto_codigo_ < minimo_ || ponto_codigo_ > 0x10FFFF ||
+                                    (ponto_codigo_ >= 0xD800 && ponto_codigo_ <= 0xDFFF);
+                    adicionar_caractere<Politica>(invalido ? CARACTERE_SUBSTITUICAO
+                                                           : static_cast<wchar_t>(ponto_codigo_));
+                }
+                continue;
+            }
+            // Sequência interrompida: o byte atual é tratado de novo como início de caractere
+            restantes_ = 0;
+            adicionar_caractere<Politica>(CARACTERE_SUBSTITUICAO);
+        }
+        std::uint64_t posicao = base + static_cast<std::uint64_t>(byte - dados);
+        ++byte;
+        if (c < 0x80) {
+            if (c == ' ' || (c >= '\t' && c <= '\r')) {
+                encerrar_palavra();
+            } else {
+                if (palavra_.empty()) {
+                    inicio_palavra_ = posicao;
+                }
+                palavra_ += Politica::normalizar_ascii(static_cast<wchar_t>(c));
+                if (rastrear_posicoes_) {
+                    posicoes_.push_back(posicao);
+                }
+            }
+            continue;
+        }
+        inicio_caractere_ = posicao;
+        if (c >= 0xC2 && c <= 0xDF) {
+            ponto_codigo_ = c & 0x1F;
+            minimo_ = 0x80;
+            restantes_ = 1;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            ponto_codigo_ = c & 0x0F;
+            minimo_ = 0x800;
+            restantes_ = 2;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            ponto_codigo_ = c & 0x07;
+            minimo_ = 0x10000;
+            restantes_ = 3;
+        } else {
+            adicionar_caractere<Politica>(CARACTERE_SUBSTITUICAO);
+        }
+    }
+}
+
+/**
+ * \brief Indica o fim do texto, contando a última palavra e sequências UTF-8 incompletas.
+ */
+void ContadorIncremental::finalizar() {
+    const std::uint64_t palavras = palavras_;
+    const std::uint64_t insercoes = insercoes_;
+    if (restantes_ > 0) {
+        restantes_ = 0;
+        // U+FFFD não muda com nenhuma normalização
+        adicionar_caractere<PoliticaNormalizacao<false, false>>(CARACTERE_SUBSTITUICAO);
+    }
+    encerrar_palavra();
+    if (contar_) {
+        registrar_tabela(palavras_ - palavras, insercoes_ - insercoes);
+    }
+}
+
+/**
+ * \brief Entrega a contagem acumulada ao chamador, deixando o contador vazio.
+ *
+ * \return O mapa com as palavras e suas contagens.
+ */
+std::map<std::wstring, int> ContadorIncremental::extrair_contagem() {
+    std::map<std::wstring, int> contagem;
+    contagem.swap(contagem_);
+    memoria_ = 0;
+    return contagem;
+}
+
+/**
+ * \brief Entrega a contagem agrupada ao chamador, deixando o contador vazio.
+ *
+ * \return O mapa com as chaves sem acentos e as suas formas.
+ */
+ContagemFormas ContadorIncremental::extrair_formas() {
+    ContagemFormas formas;
+    formas.swap(formas_);
+    memoria_ = 0;
+    return formas;
+}
+
+/**
+ * \brief Limita a memória usada pela contagem, descarregando contagens parciais.
+ *
+ * \param limite O limite, em bytes, da estimativa de `memoria_estimada`.
+ * \param descarga A função que recebe cada contagem parcial.
+ */
+void ContadorIncremental::limitar_memoria(std::size_t limite, DescargaContagem descarga) {
+    limite_ = limite;
+    descarga_ = std::move(descarga);
+}
+
+/**
+ * \brief Acrescenta um caractere não ASCII à palavra atual ou a encerra, se for um espaço.
+ *
+ * Os espaços são reconhecidos pela tabela de classes do tokenizador, sem consultar a localidade.
+ * O caractere entra na palavra já normalizado pela política, de forma que a chave fica pronta
+ * quando o espaço seguinte é encontrado.
+ *
+ * \param caractere O caractere decodificado.
+ */
+template <typename Politica>
+void ContadorIncremental::adicionar_caractere(wchar_t caractere) {
+    if (classe_caractere(caractere) == CLASSE_ESPACO) {
+        encerrar_palavra();
+    } else {
+        if ((caractere = Politica::normalizar(caractere)) == 0) {
+            return;
+        }
+        if (palavra_.empty()) {
+            inicio_palavra_ = inicio_caractere_;
+        }
+        palavra_ += caractere;
+        if (rastrear_posicoes_) {
+            posicoes_.push_back(inicio_caractere_);
+        }
+    }
+}
+
+/**
+ * \brief Conta a palavra atual, se houver, e reaproveita o seu buffer para a próxima.
+ *
+ * Com as regras de pontuação ou de números ligadas, a palavra é aparada ou dividida por
+ * `dividir_palavra` antes da contagem, e o deslocamento de cada parte é o do seu primeiro
+ * caractere no texto original, guardado na decodificação. Os acentos de cada parte são removidos na
+ * cópia para a chave; no modo de formas, a parte antes da cópia é a forma original. Com uma forma
+ * normal, cada parte é normalizada antes da cópia, e a forma original é a parte normalizada em
+ * minúsculas.
+ */
+void ContadorIncremental::encerrar_palavra() {
+    if (palavra_.empty()) {
+        return;
+    }
+    if (chave_direta_) {
+        contar_chave(palavra_, inicio_palavra_);
+    } else {
+        const wchar_t* base = palavra_.data();
+        dividir_palavra(base, base + palavra_.size(), configuracao_,
+                        [this, base](const wchar_t* inicio, const wchar_t* fim) {
+                            // As posições só são guardadas se houver quem as receba
+                            std::uint64_t deslocamento = rastrear_posicoes_ ? posicoes_[inicio - base] : 0;
+                            aplicar_forma_normal(inicio, fim, configuracao_, normalizada_);
+                            normalizar_chave(inicio, fim, configuracao_, pedaco_);
+                            if (pedaco_.empty()) {
+                                return;
+                            }
+                            if (agrupar_formas_ && (configuracao_ & (TOKENIZADOR_NFC | TOKENIZADOR_NFD))) {
+                                normalizar_chave(inicio, fim,
+                                                 configuracao_ & ~static_cast<std::uint32_t>(TOKENIZADOR_SEM_ACENTOS),
+                                                 forma_);
+                                contar_forma(pedaco_, forma_.data(), forma_.data() + forma_.size(), deslocamento);
+                            } else if (agrupar_formas_) {
+                                contar_forma(pedaco_, inicio, fim, deslocamento);
+                            } else {
+                                contar_chave(pedaco_, deslocamento);
+                            }
+                        });
+    }
+    palavra_.clear();
+    posicoes_.clear();
+}
+
+/**
+ * \brief Conta uma ocorrência de uma palavra já separada.
+ *
+ * Cada palavra nova soma à estimativa de memória o nó do mapa e os caracteres da chave; quando a
+ * estimativa passa do limite, a contagem parcial é descarregada. As palavras vazias do filtro são
+ * descartadas antes de chegar ao observador e à tabela.
+ *
+ * \param chave A palavra a ser contada.
+ * \param deslocamento O deslocamento do primeiro byte da palavra, entregue ao observador.
+ */
+void ContadorIncremental::contar_chave(const std::wstring& chave, std::uint64_t deslocamento) {
+    if (filtro_->contem(chave)) {
+        return;
+    }
+    if (observador_) {
+        observador_(chave, deslocamento);
+    }
+    ++palavras_;
+    if (!contar_) {
+        return;
+    }
+    auto posicao = contagem_.lower_bound(chave);
+    if (posicao != contagem_.end() && posicao->first == chave) {
+        ++posicao->second;
+    } else {
+        contagem_.emplace_hint(posicao, chave, 1);
+        ++insercoes_;
+        memoria_ += sizeof(std::map<std::wstring, int>::value_type) + 4 * sizeof(void*) +
+                    (chave.size() + 1) * sizeof(wchar_t);
+        if (limite_ > 0 && memoria_ > limite_) {
+            descarga_(contagem_);
+            contagem_.clear();
+            memoria_ = 0;
+        }
+    }
+}
+
+/**
+ * \brief Conta uma ocorrência de uma palavra na contagem agrupada.
+ *
+ * \param chave A palavra sem acentos.
+ * \param inicio O primeiro caractere da forma original.
+ * \param fim O caractere seguinte ao último.
+ * \param deslocamento O deslocamento do primeiro byte da palavra, entregue ao observador.
+ */
+void ContadorIncremental::contar_forma(const std::wstring& chave, const wchar_t* inicio, const wchar_t* fim,
+                                       std::uint64_t deslocamento) {
+    if (filtro_->contem(chave)) {
+        return;
+    }
+    if (observador_) {
+        observador_(chave, deslocamento);
+    }
+    ++palavras_;
+    if (!contar_) {
+        return;
+    }
+    auto posicao = formas_.lower_bound(chave);
+    if (posicao == formas_.end() || posicao->first != chave) {
+        posicao = formas_.emplace_hint(posicao, chave, FormasPalavra());
+        ++insercoes_;
+        memoria_ += sizeof(ContagemFormas::value_type) + 4 * sizeof(void*) + (chave.size() + 1) * sizeof(wchar_t);
+    }
+    posicao->second.contar(chave, inicio, fim);
+}
+
+/**
+ * \brief Número de buffers em circulação entre a thread de descompressão e a de contagem.
+ */
+static const std::size_t BUFFERS_PIPELINE = 4;
+
+/**
+ * \brief Fila limitada de blocos descomprimidos entre duas threads.
+ *
+ * Os buffers circulam entre uma lista de livres e uma fila de prontos, de forma que nenhum bloco 
+ * é alocado depois do início e a descompressão nunca fica mais de `BUFFERS_PIPELINE` blocos à 
+ * frente da contagem.
+ */
+class FilaBlocos {
+ public:
+    FilaBlocos() : encerrada_(false), cancelada_(false) {
+        for (std::size_t i = 0; i < BUFFERS_PIPELINE; ++i) {
+            livres_.push_back(std::string());
+            livres_.back().reserve(TAMANHO_BLOCO_PADRAO);
+        }
+    }
+
+    /**
+     * \brief Obtém um buffer vazio, esperando a contagem devolver um se necessário.
+     *
+     * \param buffer Recebe o buffer livre.
+     * \return Falso se a contagem foi cancelada.
+     */
+    bool obter_livre(std::string& buffer) {
+        std::unique_lock<std::mutex> trava(mutex_);
+        livre_disponivel_.wait(trava, [this] { return !livres_.empty() || cancelada_; });
+        if (cancelada_) {
+            return false;
+        }
+        buffer = std::move(livres_.front());
+        livres_.pop_front();
+        buffer.clear();
+        return true;
+    }
+
+    /**
+     * \brief Entrega um buffer preenchido para a contagem.
+     */
+    void publicar(std::string&& buffer) {
+        std::lock_guard<std::mutex> trava(mutex_);
+        prontos_.push_back(std::move(buffer));
+        pronto_disponivel_.notify_one();
+    }
+
+    /**
+     * \brief Retira o próximo buffer preenchido, esperando a descompressão se necessário.
+     *
+     * \param buffer Recebe o buffer preenchido.
+     * \return Falso quando a descompressão terminou e não há mais buffers.
+     */
+    bool retirar(std::string& buffer) {
+        std::unique_lock<std::mutex> trava(mutex_);
+        pronto_disponivel_.wait(trava, [this] { return !prontos_.empty() || encerrada_; });
+        if (prontos_.empty()) {
+            return false;
+        }
+        buffer = std::move(prontos_.front());
+        prontos_.pop_front();
+        return true;
+    }
+
+    /**
+     * \brief Devolve à lista de livres um buffer já contado.
+     */
+    void devolver(std::string&& buffer) {
+        std::lock_guard<std::mutex> trava(mutex_);
+        livres_.push_back(std::move(buffer));
+        livre_disponivel_.notify_one();
+    }
+
+    /**
+     * \brief Indica que a descompressão terminou, com sucesso ou com o erro informado.
+     */
+    void encerrar(std::exception_ptr erro) {
+        std::lock_guard<std::mutex> trava(mutex_);
+        encerrada_ = true;
+        erro_ = erro;
+        pronto_disponivel_.notify_one();
+    }
+
+    /**
+     * \brief Interrompe a descompressão quando a contagem falha.
+     */
+    void cancelar() {
+        std::lock_guard<std::mutex> trava(mutex_);
+        cancelada_ = true;
+        livre_disponivel_.notify_one();
+    }
+
+    /**
+     * \brief Retorna o erro ocorrido na descompressão, se houver.
+     */
+    std::exception_ptr erro() {
+        std::lock_guard<std::mutex> trava(mutex_);
+        return erro_;
+    }
+
+ private:
+    std::mutex mutex_;
+    std::condition_variable livre_disponivel_;
+    std::condition_variable pronto_disponivel_;
+    std::deque<std::string> livres_;
+    std::deque<std::string> prontos_;
+    bool encerrada_;
+    bool cancelada_;
+    std::exception_ptr erro_;
+};
+
+/**
+ * \brief Sinaliza, dentro da thread de descompressão, que a contagem foi cancelada.
+ */
+struct DescompressaoCancelada {};
+
+/**
+ * \brief Descomprime a entrada em uma thread separada e conta as palavras na thread atual.
+ *
+ * A thread de descompressão lê os blocos compactados e preenche buffers de `TAMANHO_BLOCO_PADRAO` 
+ * bytes com o texto descomprimido; a thread atual conta cada buffer assim que ele fica pronto. 
+ * Assim a descompressão de um bloco se sobrepõe à contagem do anterior.
+ *
+ * \param leitor O leitor da entrada compactada, posicionado logo após `inicio`.
+ * \param inicio Os bytes já lidos do início da entrada.
+ * \param formato O formato de compressão da entrada.
+ * \param contador O contador que recebe o texto descomprimido.
+ * \throws std::ios_base::failure Se a entrada estiver corrompida ou não puder ser lida.
+ */
+static void contar_compactado(LeitorBlocos& leitor, const std::string& inicio,
+                              FormatoCompressao formato, ContadorIncremental& contador) {
+    FilaBlocos fila;
+    std::thread descompressao([&leitor, &inicio, formato, &fila] {
+        try {
+            std::unique_ptr<Descompressor> descompressor = Descompressor::criar(formato);
+            std::string atual;
+            if (!fila.obter_livre(atual)) {
+                throw DescompressaoCancelada();
+            }
+            SaidaDescompressao saida = [&fila, &atual](const char* dados, std::size_t tamanho) {
+                while (tamanho > 0) {
+                    std::size_t cabe = std::min(tamanho, TAMANHO_BLOCO_PADRAO - atual.size());
+                    atual.append(dados, cabe);
+                    dados += cabe;
+                    tamanho -= cabe;
+                    if (atual.size() == TAMANHO_BLOCO_PADRAO) {
+                        fila.publicar(std::move(atual));
+                        if (!fila.obter_livre(atual)) {
+                            throw DescompressaoCancelada();
+                        }
+                    }
+                }
+            };
+            descompressor->alimentar(inicio.data(), inicio.size(), saida);
+            std::size_t lidos;
+            while ((lidos = leitor.proximo()) > 0) {
+                // A medição inclui a espera por um buffer livre quando a contagem está atrasada
+                MedicaoEtapa medicao(ETAPA_DESCOMPRESSAO);
+                medicao.bytes(lidos);
+                descompressor->alimentar(leitor.dados(), lidos, saida);
+            }
+            descompressor->finalizar();
+            if (!atual.empty()) {
+                fila.publicar(std::move(atual));
+            }
+            fila.encerrar(std::exception_ptr());
+        } catch (const DescompressaoCancelada&) {
+            fila.encerrar(std::exception_ptr());
+        } catch (...) {
+            fila.encerrar(std::current_exception());
+        }
+    });
+
+    try {
+        std::string bloco;
+        while (fila.retirar(bloco)) {
+            contador.alimentar(bloco.data(), bloco.size());
+            fila.devolver(std::move(bloco));
+        }
+    } catch (...) {
+        fila.cancelar();
+        descompressao.join();
+        throw;
+    }
+    descompressao.join();
+    if (fila.erro()) {
+        std::rethrow_exception(fila.erro());
+    }
+}
+
+/**
+ * \brief Função para alimentar um contador com tudo o que for lido de um descritor.
+ *
+ * Esta função lê o descritor em blocos e entrega cada bloco ao contador incremental assim que ele
+ * chega, de forma que a contagem avança enquanto o produtor ainda está escrevendo. Entradas
+ * compactadas com gzip ou zstd são reconhecidas pelos bytes iniciais e descomprimidas em uma
+ * thread separada, em paralelo com a contagem.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param contador O contador que recebe o texto.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+void alimentar_contador(int descritor, ContadorIncremental& contador) {
+    LeitorBlocos leitor(descritor);
+
+    // Acumula bytes suficientes para reconhecer a assinatura de um formato compactado
+    std::string inicio;
+    std::size_t lidos;
+    while (inicio.size() < TAMANHO_ASSINATURA && (lidos = leitor.proximo()) > 0) {
+        inicio.append(leitor.dados(), lidos);
+    }
+
+    FormatoCompressao formato = detectar_compressao(inicio.data(), inicio.size());
+    if (formato != FormatoCompressao::nenhum) {
+        contar_compactado(leitor, inicio, formato, contador);
+    } else {
+        contador.alimentar(inicio.data(), inicio.size());
+        while ((lidos = leitor.proximo()) > 0) {
+            contador.alimentar(leitor.dados(), lidos);
+        }
+    }
+    contador.finalizar();
+}
+
+/**
+ * \brief Função para contar as palavras lidas de um descritor.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return Um mapa contendo as palavras e suas respectivas contagens.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+std::map<std::wstring, int> contar_palavras_fluxo(int descritor, std::uint32_t configuracao) {
+    ContadorIncremental contador(configuracao);
+    alimentar_contador(descritor, contador);
+    return contador.extrair_contagem();
+}
+
+/**
+ * \brief Função para processar uma entrada em fluxo e exibir a contagem das palavras ordenadas.
+ *
+ * \param descritor O descritor a ser processado.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+ */
+void processar_fluxo(int descritor) {
+    imprimir_contagem(contar_palavras_fluxo(descritor));
+}
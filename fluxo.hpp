@@ -0,0 +1,269 @@
+/**
+ * \file fluxo.hpp
+ * \brief Definições para contar palavras de uma entrada lida em fluxo (stdin, pipes, descritores).
+ *
+ * Este arquivo contém as declarações do leitor em blocos e do contador incremental, que permitem
+ * contar as palavras de uma entrada à medida que ela é produzida, sem esperar que o conteúdo
+ * completo esteja disponível.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef FLUXO_HPP_
+#define FLUXO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <map>
+#include <memory>
+
+#include "formas.hpp"
+#include "palavras_vazias.hpp"
+#include "tokenizador.hpp"
+
+/**
+ * \brief Tamanho padrão, em bytes, do bloco usado pelo leitor em blocos.
+ */
+const std::size_t TAMANHO_BLOCO_PADRAO = 1 << 20;
+
+/**
+ * \brief Leitor de um descritor em blocos, com um único buffer reaproveitado.
+ *
+ * Cada chamada a `proximo` faz uma leitura no descritor e devolve o que estiver disponível, sem
+ * esperar o bloco encher, para que o processamento comece antes de o produtor terminar. O buffer
+ * é alocado uma vez e reaproveitado em todas as leituras. O descritor não é fechado pelo leitor.
+ */
+class LeitorBlocos {
+ public:
+    /**
+     * \brief Cria um leitor para o descritor informado.
+     *
+     * Se o descritor for um pipe, a sua capacidade é aumentada para o tamanho do bloco quando o
+     * sistema permitir, reduzindo o número de trocas de contexto entre produtor e consumidor. Se
+     * for um arquivo regular, o núcleo é avisado de que a leitura é sequencial.
+     *
+     * \param descritor O descritor a ser lido.
+     * \param tamanho_bloco O tamanho do buffer de leitura, em bytes.
+     */
+    explicit LeitorBlocos(int descritor, std::size_t tamanho_bloco = TAMANHO_BLOCO_PADRAO);
+
+    /**
+     * \brief Lê o próximo bloco do descritor.
+     *
+     * \return O número de bytes disponíveis em `dados()`, ou zero no fim da entrada.
+     * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+     */
+    std::size_t proximo();
+
+    /**
+     * \brief Retorna os bytes lidos pela última chamada a `proximo`.
+     */
+    const char* dados() const { return buffer_.data(); }
+
+ private:
+    int descritor_;
+    std::vector<char> buffer_;
+};
+
+/**
+ * \brief Destino da contagem parcial quando o contador atinge o limite de memória.
+ *
+ * Recebe a contagem acumulada até o momento; o contador a esvazia logo em seguida.
+ */
+typedef std::function<void(const std::map<std::wstring, int>&)> DescargaContagem;
+
+/**
+ * \brief Função chamada para cada palavra encerrada pelo contador.
+ *
+ * Recebe a palavra, já normalizada como chave, e o deslocamento, em bytes desde o início do
+ * texto entregue ao contador, do primeiro byte da palavra.
+ */
+typedef std::function<void(const std::wstring&, std::uint64_t)> ObservadorPalavras;
+
+/**
+ * \brief Contador de palavras alimentado em partes.
+ *
+ * Recebe o texto em UTF-8 em pedaços arbitrários e conta as palavras com as mesmas regras de
+ * `contar_palavras` para a mesma configuração do tokenizador. Sequências UTF-8 e palavras divididas
+ * entre dois pedaços são tratadas corretamente. Bytes que não formam UTF-8 válido são contados
+ * como o caractere de substituição U+FFFD, em vez de interromper o fluxo. O laço de decodificação
+ * é compilado para cada `PoliticaNormalizacao` e escolhido uma vez, na construção.
+ */
+class ContadorIncremental {
+ public:
+    /**
+     * \brief Cria um contador vazio.
+     *
+     * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+     */
+    explicit ContadorIncremental(std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+    /**
+     * \brief Processa mais um pedaço do texto.
+     *
+     * \param dados Os bytes do pedaço, em UTF-8.
+     * \param tamanho O número de bytes do pedaço.
+     */
+    void alimentar(const char* dados, std::size_t tamanho);
+
+    /**
+     * \brief Indica o fim do texto, contando a última palavra e sequências UTF-8 incompletas.
+     */
+    void finalizar();
+
+    /**
+     * \brief Retorna a contagem acumulada até o momento.
+     */
+    const std::map<std::wstring, int>& contagem() const { return contagem_; }
+
+    /**
+     * \brief Entrega a contagem acumulada sem copiá-la, deixando o contador vazio.
+     */
+    std::map<std::wstring, int> extrair_contagem();
+
+    /**
+     * \brief Passa a contar as palavras agrupadas sem acentos, guardando as formas originais.
+     *
+     * As palavras são contadas pela chave sem acentos em `formas()`, com a forma mais frequente de
+     * cada uma, em vez de em `contagem()`, que fica vazia. Deve ser chamado antes do primeiro pedaço.
+     * O limite de `limitar_memoria` não se aplica às formas.
+     */
+    void agrupar_formas();
+
+    /**
+     * \brief Retorna a contagem agrupada acumulada até o momento, no modo de `agrupar_formas`.
+     */
+    const ContagemFormas& formas() const { return formas_; }
+
+    /**
+     * \brief Entrega a contagem agrupada sem copiá-la, deixando o contador vazio.
+     */
+    ContagemFormas extrair_formas();
+
+    /**
+     * \brief Limita a memória usada pela contagem.
+     *
+     * Sempre que a estimativa de memória da contagem ultrapassar o limite, a contagem parcial é
+     * entregue a `descarga` e o contador recomeça vazio. A palavra incompleta do pedaço atual é
+     * preservada.
+     *
+     * \param limite O limite, em bytes, da estimativa de `memoria_estimada`.
+     * \param descarga A função que recebe cada contagem parcial.
+     */
+    void limitar_memoria(std::size_t limite, DescargaContagem descarga);
+
+    /**
+     * \brief Retorna uma estimativa, em bytes, da memória ocupada pela contagem.
+     */
+    std::size_t memoria_estimada() const { return memoria_; }
+
+    /**
+     * \brief Define uma função chamada para cada palavra contada, com a sua posição no texto.
+     *
+     * A posição é o deslocamento, nos bytes entregues ao contador, do primeiro caractere da palavra,
+     * mesmo quando os caracteres antes dela foram substituídos por U+FFFD, removidos ou convertidos
+     * para minúsculas com outro número de bytes. Deve ser chamado antes do primeiro pedaço.
+     *
+     * \param observador A função chamada para cada palavra.
+     * \param contar Se falso, as palavras só são entregues ao observador, que faz a sua própria
+     * contagem: `contagem()` e `formas()` ficam vazias, sem o custo de uma busca por palavra.
+     */
+    void observar_palavras(ObservadorPalavras observador, bool contar = true) {
+        observador_ = std::move(observador);
+        contar_ = contar;
+        rastrear_posicoes_ = static_cast<bool>(observador_) && !chave_direta_;
+    }
+
+    /**
+     * \brief Retorna o número de bytes entregues ao contador até o momento.
+     */
+    std::uint64_t bytes_processados() const { return processados_; }
+
+    /**
+     * \brief Retorna a configuração do tokenizador usada pelo contador.
+     */
+    std::uint32_t configuracao() const { return configuracao_; }
+
+ private:
+    typedef void (ContadorIncremental::*Decodificador)(const unsigned char* dados, std::size_t tamanho);
+    template <typename Politica>
+    struct SelecaoDecodificador;
+
+    template <typename Politica>
+    void decodificar(const unsigned char* dados, std::size_t tamanho);
+    template <typename Politica>
+    void adicionar_caractere(wchar_t caractere);
+    void escolher_decodificador();
+    void encerrar_palavra();
+    void contar_chave(const std::wstring& chave, std::uint64_t deslocamento);
+    void contar_forma(const std::wstring& chave, const wchar_t* inicio, const wchar_t* fim,
+                      std::uint64_t deslocamento);
+
+    std::map<std::wstring, int> contagem_;
+    ContagemFormas formas_;
+    std::wstring palavra_;
+    std::vector<std::uint64_t> posicoes_;
+    std::wstring pedaco_;
+    std::wstring normalizada_;
+    std::wstring forma_;
+    std::shared_ptr<const FiltroPalavrasVazias> filtro_;
+    DescargaContagem descarga_;
+    ObservadorPalavras observador_;
+    Decodificador decodificador_;
+    std::uint64_t processados_;
+    std::uint64_t palavras_;
+    std::uint64_t insercoes_;
+    std::uint64_t inicio_palavra_;
+    std::uint64_t inicio_caractere_;
+    std::size_t memoria_;
+    std::size_t limite_;
+    std::uint32_t ponto_codigo_;
+    std::uint32_t minimo_;
+    std::uint32_t configuracao_;
+    int restantes_;
+    bool agrupar_formas_;
+    bool chave_direta_;
+    bool contar_;
+    bool rastrear_posicoes_;
+};
+
+/**
+ * \brief Função para alimentar um contador com tudo o que for lido de um descritor.
+ *
+ * Lê o descritor em blocos até o fim, descomprimindo entradas compactadas, e finaliza o contador.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param contador O contador que recebe o texto.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+void alimentar_contador(int descritor, ContadorIncremental& contador);
+
+/**
+ * \brief Função para contar as palavras lidas de um descritor.
+ *
+ * Lê o descritor em blocos até o fim e conta as palavras à medida que chegam. Entradas compactadas
+ * com gzip ou zstd são reconhecidas pelos bytes iniciais e descomprimidas em fluxo, em uma thread
+ * separada da contagem.
+ *
+ * \param descritor O descritor a ser lido (por exemplo, a entrada padrão).
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return Um mapa contendo as palavras e suas respectivas contagens.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+std::map<std::wstring, int> contar_palavras_fluxo(int descritor, std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+/**
+ * \brief Função para processar uma entrada em fluxo e exibir a contagem das palavras ordenadas.
+ *
+ * Equivalente a `processar_arquivo`, mas lê de um descritor já aberto, como a entrada padrão.
+ *
+ * \param descritor O descritor a ser processado.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura.
+ */
+void processar_fluxo(int descritor);
+
+#endif  // FLUXO_HPP_
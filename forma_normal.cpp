@@ -0,0 +1,248 @@
+/**
+ * \file forma_normal.cpp
+ * \brief Implementação da normalização Unicode (NFC e NFD).
+ *
+ * Segue o algoritmo do UAX #15: decomposição canônica completa, ordenação canônica das marcas
+ * pela classe de combinação e, para a NFC, composição canônica com as composições primárias.
+ * As sílabas do hangul são decompostas e compostas por fórmula.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "forma_normal.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace {
+
+const std::uint32_t HANGUL_SILABA = 0xAC00;  ///< Primeira sílaba do hangul.
+const std::uint32_t HANGUL_INICIAL = 0x1100;  ///< Primeira consoante inicial (L).
+const std::uint32_t HANGUL_VOGAL = 0x1161;  ///< Primeira vogal (V).
+const std::uint32_t HANGUL_FINAL = 0x11A7;  ///< Anterior à primeira consoante final (T).
+const std::uint32_t HANGUL_INICIAIS = 19;
+const std::uint32_t HANGUL_VOGAIS = 21;
+const std::uint32_t HANGUL_FINAIS = 28;
+const std::uint32_t HANGUL_POR_INICIAL = HANGUL_VOGAIS * HANGUL_FINAIS;
+const std::uint32_t HANGUL_SILABAS = HANGUL_INICIAIS * HANGUL_POR_INICIAL;
+
+/**
+ * \brief Retorna a classe de combinação canônica de um caractere.
+ */
+inline unsigned classe_combinacao(wchar_t caractere) {
+    return propriedades_normalizacao(caractere) & 0xFF;
+}
+
+/**
+ * \brief Indica se um segmento pode começar no caractere, sem interagir com o que vem antes.
+ *
+ * São estáveis os caracteres de classe zero que já estão na forma normal e que, na NFC, não se
+ * compõem com o anterior.
+ */
+inline bool estavel(wchar_t caractere, bool compor) {
+    std::uint16_t propriedades = propriedades_normalizacao(caractere);
+    std::uint16_t impede = compor ? (NORMALIZACAO_NAO_NFC | NORMALIZACAO_TALVEZ_NFC) : NORMALIZACAO_NAO_NFD;
+    return (propriedades & (0xFF | impede)) == 0;
+}
+
+/**
+ * \brief Acrescenta a decomposição canônica completa de um caractere ao destino.
+ */
+void decompor(wchar_t caractere, std::wstring& destino) {
+    std::uint32_t ponto_codigo = static_cast<std::uint32_t>(caractere);
+    if (ponto_codigo - HANGUL_SILABA < HANGUL_SILABAS) {
+        std::uint32_t indice = ponto_codigo - HANGUL_SILABA;
+        destino += static_cast<wchar_t>(HANGUL_INICIAL + indice / HANGUL_POR_INICIAL);
+        destino += static_cast<wchar_t>(HANGUL_VOGAL + indice % HANGUL_POR_INICIAL / HANGUL_FINAIS);
+        if (indice % HANGUL_FINAIS != 0) {
+            destino += static_cast<wchar_t>(HANGUL_FINAL + indice % HANGUL_FINAIS);
+        }
+        return;
+    }
+    if (propriedades_normalizacao(caractere) & NORMALIZACAO_NAO_NFD) {
+        const Decomposicao* fim = DECOMPOSICOES + NUMERO_DECOMPOSICOES;
+        const Decomposicao* decomposicao = std::lower_bound(
+            DECOMPOSICOES, fim, ponto_codigo,
+            [](const Decomposicao& atual, std::uint32_t ponto) { return atual.ponto_codigo < ponto; });
+        if (decomposicao != fim && decomposicao->ponto_codigo == ponto_codigo) {
+            const std::uint32_t* dados = DADOS_DECOMPOSICOES + decomposicao->inicio;
+            for (std::uint16_t i = 0; i < decomposicao->tamanho; ++i) {
+                destino += static_cast<wchar_t>(dados[i]);
+            }
+            return;
+        }
+    }
+    destino += caractere;
+}
+
+/**
+ * \brief Ordena as marcas de cada sequência pela classe de combinação, preservando os empates.
+ *
+ * \param texto O texto decomposto.
+ * \param inicio A posição a partir da qual ordenar.
+ */
+void ordenar_marcas(std::wstring& texto, std::size_t inicio) {
+    for (std::size_t i = inicio + 1; i < texto.size(); ++i) {
+        wchar_t caractere = texto[i];
+        unsigned classe = classe_combinacao(caractere);
+        if (classe == 0) {
+            continue;
+        }
+        std::size_t j = i;
+        for (; j > inicio && classe_combinacao(texto[j - 1]) > classe; --j) {
+            texto[j] = texto[j - 1];
+        }
+        texto[j] = caractere;
+    }
+}
+
+/**
+ * \brief Retorna a composição primária de dois caracteres, ou zero se eles não se compõem.
+ */
+std::uint32_t compor_par(std::uint32_t primeiro, std::uint32_t segundo) {
+    if (primeiro - HANGUL_INICIAL < HANGUL_INICIAIS && segundo - HANGUL_VOGAL < HANGUL_VOGAIS) {
+        return HANGUL_SILABA + ((primeiro - HANGUL_INICIAL) * HANGUL_VOGAIS + segundo - HANGUL_VOGAL) * HANGUL_FINAIS;
+    }
+    if (primeiro - HANGUL_SILABA < HANGUL_SILABAS && (primeiro - HANGUL_SILABA) % HANGUL_FINAIS == 0 &&
+        segundo - HANGUL_FINAL - 1 < HANGUL_FINAIS - 1) {
+        return primeiro + segundo - HANGUL_FINAL;
+    }
+    const Composicao* fim = COMPOSICOES + NUMERO_COMPOSICOES;
+    const Composicao* composicao = std::lower_bound(
+        COMPOSICOES, fim, std::make_pair(primeiro, segundo),
+        [](const Composicao& atual, const std::pair<std::uint32_t, std::uint32_t>& par) {
+            return atual.primeiro != par.first ? atual.primeiro < par.first : atual.segundo < par.second;
+        });
+    if (composicao != fim && composicao->primeiro == primeiro && composicao->segundo == segundo) {
+        return composicao->composto;
+    }
+    return 0;
+}
+
+/**
+ * \brief Aplica a composição canônica ao texto decomposto e ordenado, a partir de `inicio`.
+ *
+ * Cada caractere se compõe com o último caractere inicial (de classe zero) se não estiver
+ * bloqueado, isto é, se nenhum caractere entre os dois tiver classe maior ou igual à sua.
+ */
+void recompor(std::wstring& texto, std::size_t inicio) {
+    if (inicio >= texto.size()) {
+        return;
+    }
+    std::size_t posicao_inicial = inicio;
+    std::uint32_t inicial = static_cast<std::uint32_t>(texto[inicio]);
+    unsigned ultima_classe = classe_combinacao(texto[inicio]);
+    // As marcas antes do primeiro caractere inicial não têm com o que se compor
+    bool tem_inicial = ultima_classe == 0;
+    std::size_t escrita = inicio + 1;
+    for (std::size_t leitura = inicio + 1; leitura < texto.size(); ++leitura) {
+        wchar_t caractere = texto[leitura];
+        unsigned classe = classe_combinacao(caractere);
+        if (tem_inicial && (ultima_classe < classe || ultima_classe == 0)) {
+            std::uint32_t composto = compor_par(inicial, static_cast<std::uint32_t>(caractere));
+            if (composto != 0) {
+                texto[posicao_inicial] = static_cast<wchar_t>(composto);
+                inicial = composto;
+                continue;
+            }
+        }
+        if (classe == 0) {
+            posicao_inicial = escrita;
+            inicial = static_cast<std::uint32_t>(caractere);
+            tem_inicial = true;
+        }
+        ultima_classe = classe;
+        texto[escrita++] = caractere;
+    }
+    texto.resize(escrita);
+}
+
+}  // namespace
+
+/**
+ * \brief Encontra o primeiro caractere que a verificação rápida não consegue aceitar.
+ *
+ * Os caracteres abaixo de `LIMITE_RAPIDO_NFC` (ou `LIMITE_RAPIDO_NFD`), que incluem todo o
+ * Latin-1 na NFC, são aceitos sem consultar as tabelas. Os demais são recusados se não puderem
+ * aparecer na forma normal, se puderem se compor com o anterior (na NFC) ou se a sua classe de
+ * combinação for menor que a do caractere anterior.
+ *
+ * \param inicio O primeiro caractere do trecho.
+ * \param fim O caractere seguinte ao último.
+ * \param compor Verdadeiro para NFC, falso para NFD.
+ * \return O primeiro caractere recusado, ou `fim`.
+ */
+const wchar_t* fim_forma_normal(const wchar_t* inicio, const wchar_t* fim, bool compor) {
+    const std::uint32_t limite = compor ? LIMITE_RAPIDO_NFC : LIMITE_RAPIDO_NFD;
+    const std::uint16_t impede = compor ? (NORMALIZACAO_NAO_NFC | NORMALIZACAO_TALVEZ_NFC) : NORMALIZACAO_NAO_NFD;
+    unsigned ultima_classe = 0;
+    for (; inicio != fim; ++inicio) {
+        if (static_cast<std::uint32_t>(*inicio) < limite) {
+            ultima_classe = 0;
+            continue;
+        }
+        std::uint16_t propriedades = propriedades_normalizacao(*inicio);
+        unsigned classe = propriedades & 0xFF;
+        if ((propriedades & impede) || (classe != 0 && ultima_classe > classe)) {
+            return inicio;
+        }
+        ultima_classe = classe;
+    }
+    return fim;
+}
+
+/**
+ * \brief Converte um trecho para a forma normal NFC ou NFD.
+ *
+ * A cada caractere recusado pela verificação rápida, o segmento que vai do último caractere
+ * estável antes dele até o próximo caractere estável depois dele é normalizado por completo; o
+ * restante é copiado como está, e a verificação continua depois do segmento.
+ *
+ * \param inicio O primeiro caractere do trecho.
+ * \param fim O caractere seguinte ao último.
+ * \param compor Verdadeiro para NFC, falso para NFD.
+ * \param destino Recebe o trecho normalizado.
+ */
+void converter_forma_normal(const wchar_t* inicio, const wchar_t* fim, bool compor, std::wstring& destino) {
+    destino.clear();
+    while (inicio != fim) {
+        const wchar_t* recusado = fim_forma_normal(inicio, fim, compor);
+        if (recusado == fim) {
+            destino.append(inicio, fim);
+            return;
+        }
+        const wchar_t* segmento = recusado;
+        while (segmento != inicio && !estavel(*segmento, compor)) {
+            --segmento;
+        }
+        const wchar_t* final = recusado + 1;
+        while (final != fim && !estavel(*final, compor)) {
+            ++final;
+        }
+        destino.append(inicio, segmento);
+        std::size_t posicao = destino.size();
+        for (const wchar_t* caractere = segmento; caractere != final; ++caractere) {
+            decompor(*caractere, destino);
+        }
+        ordenar_marcas(destino, posicao);
+        if (compor) {
+            recompor(destino, posicao);
+        }
+        inicio = final;
+    }
+}
+
+/**
+ * \brief Função para converter um texto para a forma normal NFC ou NFD.
+ *
+ * \param texto O texto a ser convertido.
+ * \param compor Verdadeiro para NFC, falso para NFD.
+ * \return O texto na forma normal.
+ */
+std::wstring converter_forma_normal(const std::wstring& texto, bool compor) {
+    std::wstring normalizado;
+    converter_forma_normal(texto.data(), texto.data() + texto.size(), compor, normalizado);
+    return normalizado;
+}
@@ -0,0 +1,68 @@
+/**
+ * \file forma_normal.hpp
+ * \brief Definições da normalização Unicode (NFC e NFD) usada antes da contagem.
+ *
+ * O mesmo texto pode chegar com "é" pré-composto (U+00E9) ou como "e" seguido do acento agudo
+ * combinante (U+0301). As formas normais do UAX #15 dão a cada sequência uma única representação:
+ * a NFC compõe os caracteres sempre que possível, e a NFD os decompõe. A verificação rápida
+ * (Quick_Check) aceita sem cópia os trechos já normalizados, que são quase todo texto real; só os
+ * trechos em volta de um caractere suspeito são decompostos, reordenados e recompostos, com as
+ * tabelas geradas em `tabelas_unicode.cpp`.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef FORMA_NORMAL_HPP_
+#define FORMA_NORMAL_HPP_
+
+#include <cstdint>
+#include <string>
+
+#include "tabelas_unicode.hpp"
+
+/**
+ * \brief Retorna a classe de combinação e os bits de verificação rápida de um caractere.
+ */
+inline std::uint16_t propriedades_normalizacao(wchar_t caractere) {
+    std::uint32_t ponto_codigo = static_cast<std::uint32_t>(caractere);
+    if (ponto_codigo >= MAXIMO_PONTO_CODIGO) {
+        return 0;
+    }
+    return BLOCOS_NORMALIZACAO[INDICE_NORMALIZACAO[ponto_codigo >> DESLOCAMENTO_BLOCO_NORMALIZACAO]]
+                              [ponto_codigo & ((1u << DESLOCAMENTO_BLOCO_NORMALIZACAO) - 1)];
+}
+
+/**
+ * \brief Encontra o primeiro caractere que a verificação rápida não consegue aceitar.
+ *
+ * \param inicio O primeiro caractere do trecho.
+ * \param fim O caractere seguinte ao último.
+ * \param compor Verdadeiro para NFC, falso para NFD.
+ * \return O primeiro caractere fora da forma normal ou fora de ordem, ou `fim` se o trecho
+ * inteiro já estiver na forma normal.
+ */
+const wchar_t* fim_forma_normal(const wchar_t* inicio, const wchar_t* fim, bool compor);
+
+/**
+ * \brief Converte um trecho para a forma normal NFC ou NFD.
+ *
+ * Os trechos aceitos pela verificação rápida são copiados sem alteração; apenas os segmentos entre
+ * dois caracteres estáveis que contêm um caractere suspeito são decompostos e recompostos.
+ *
+ * \param inicio O primeiro caractere do trecho.
+ * \param fim O caractere seguinte ao último.
+ * \param compor Verdadeiro para NFC, falso para NFD.
+ * \param destino Recebe o trecho normalizado.
+ */
+void converter_forma_normal(const wchar_t* inicio, const wchar_t* fim, bool compor, std::wstring& destino);
+
+/**
+ * \brief Função para converter um texto para a forma normal NFC ou NFD.
+ *
+ * \param texto O texto a ser convertido.
+ * \param compor Verdadeiro para NFC, falso para NFD.
+ * \return O texto na forma normal.
+ */
+std::wstring converter_forma_normal(const std::wstring& texto, bool compor);
+
+#endif  // FORMA_NORMAL_HPP_
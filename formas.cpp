@@ -0,0 +1,154 @@
+/**
+ * \file formas.cpp
+ * \brief Implementação da contagem de palavras agrupadas sem acentos, com as formas originais.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "formas.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "estatisticas.hpp"
+#include "fluxo.hpp"
+#include "palavras_vazias.hpp"
+
+/**
+ * \brief Conta uma ocorrência de uma forma, atualizando a forma mais frequente.
+ *
+ * A comparação com a chave, que o chamador acabou de montar, resolve a maior parte das palavras
+ * sem acessar as formas guardadas. As demais formas costumam ser uma ou duas, de forma que a
+ * busca linear é suficiente.
+ *
+ * \param chave A chave sem acentos da palavra.
+ * \param inicio O primeiro caractere da forma.
+ * \param fim O caractere seguinte ao último.
+ */
+void FormasPalavra::contar(const std::wstring& chave, const wchar_t* inicio, const wchar_t* fim) {
+    ++total;
+    const std::size_t tamanho = static_cast<std::size_t>(fim - inicio);
+    std::size_t posicao = FORMA_CHAVE;
+    int* vezes = &iguais;
+    if (chave.compare(0, std::wstring::npos, inicio, tamanho) != 0) {
+        posicao = 0;
+        while (posicao < formas.size() &&
+               formas[posicao].first.compare(0, std::wstring::npos, inicio, tamanho) != 0) {
+            ++posicao;
+        }
+        if (posicao == formas.size()) {
+            formas.emplace_back(std::wstring(inicio, fim), 0);
+        }
+        vezes = &formas[posicao].second;
+    }
+    if (++*vezes > maximo) {
+        maximo = *vezes;
+        preferida = posicao;
+    }
+}
+
+/**
+ * \brief Função para contar as palavras de um texto agrupadas sem acentos, com as formas originais.
+ *
+ * A forma e a chave são normalizadas a partir da palavra original, com e sem a remoção dos
+ * acentos, de forma que as chaves são as mesmas de `contar_palavras` com `TOKENIZADOR_SEM_ACENTOS`.
+ *
+ * \param texto O texto onde as palavras serão contadas.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`; `TOKENIZADOR_SEM_ACENTOS` é implícito.
+ * \return A contagem agrupada.
+ */
+ContagemFormas contar_formas(const std::wstring& texto, std::uint32_t configuracao) {
+    MedicaoEtapa medicao(ETAPA_CONTAGEM);
+    configuracao |= TOKENIZADOR_SEM_ACENTOS;
+    const std::uint32_t com_acentos = configuracao & ~static_cast<std::uint32_t>(TOKENIZADOR_SEM_ACENTOS);
+    std::shared_ptr<const FiltroPalavrasVazias> filtro = filtro_palavras_vazias(configuracao);
+    ContagemFormas contagem;
+    std::wstring forma;
+    std::wstring chave;
+    std::wstring normalizada;
+    std::uint64_t palavras = 0;
+    percorrer_palavras(texto.data(), texto.data() + texto.size(), configuracao,
+                       [&](const wchar_t* inicio, const wchar_t* fim) {
+                           aplicar_forma_normal(inicio, fim, configuracao, normalizada);
+                           normalizar_chave(inicio, fim, configuracao, chave);
+                           if (chave.empty() || filtro->contem(chave)) {
+                               return;
+                           }
+                           normalizar_chave(inicio, fim, com_acentos, forma);
+                           contagem[chave].contar(chave, forma.data(), forma.data() + forma.size());
+                           ++palavras;
+                       });
+    medicao.palavras(palavras);
+    registrar_tabela(palavras, contagem.size());
+    return contagem;
+}
+
+/**
+ * \brief Função para contar as palavras lidas de um descritor agrupadas sem acentos.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`; `TOKENIZADOR_SEM_ACENTOS` é implícito.
+ * \return A contagem agrupada.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+ContagemFormas contar_formas_fluxo(int descritor, std::uint32_t configuracao) {
+    ContadorIncremental contador(configuracao);
+    contador.agrupar_formas();
+    alimentar_contador(descritor, contador);
+    return contador.extrair_formas();
+}
+
+/**
+ * \brief Função para selecionar as palavras mais frequentes de uma contagem agrupada.
+ *
+ * Como em `mais_frequentes` para um mapa de contagens, apenas as `k` primeiras posições são
+ * ordenadas; empates ficam em ordem alfabética das formas exibidas.
+ *
+ * \param contagem A contagem agrupada.
+ * \param k O número de palavras desejado; zero seleciona todas.
+ * \return Um vetor de pares (forma mais frequente, total), em ordem decrescente de total.
+ */
+std::vector<std::pair<std::wstring, int>> mais_frequentes(const ContagemFormas& contagem, std::size_t k) {
+    typedef const ContagemFormas::value_type* Entrada;
+    std::vector<Entrada> entradas;
+    entradas.reserve(contagem.size());
+    for (const auto& par : contagem) {
+        entradas.push_back(&par);
+    }
+    if (k == 0 || k > entradas.size()) {
+        k = entradas.size();
+    }
+
+    std::partial_sort(entradas.begin(), entradas.begin() + k, entradas.end(),
+                      [](Entrada a, Entrada b) {
+                          return a->second.total != b->second.total
+                                     ? a->second.total > b->second.total
+                                     : a->second.forma(a->first) < b->second.forma(b->first);
+                      });
+
+    std::vector<std::pair<std::wstring, int>> resultado;
+    resultado.reserve(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        resultado.emplace_back(entradas[i]->second.forma(entradas[i]->first), entradas[i]->second.total);
+    }
+    return resultado;
+}
+
+/**
+ * \brief Função para exibir uma contagem agrupada em ordem alfabética sem acentos.
+ *
+ * \param contagem A contagem agrupada.
+ */
+void imprimir_contagem(const ContagemFormas& contagem) {
+    MedicaoEtapa medicao(ETAPA_IMPRESSAO);
+    for (const auto& par : contagem) {
+        std::wcout << par.second.forma(par.first) << L": " << par.second.total << L'\n';
+    }
+    std::wcout.flush();
+    medicao.palavras(contagem.size());
+}
@@ -0,0 +1,114 @@
+/**
+ * \file formas.hpp
+ * \brief Definições da contagem de palavras agrupadas sem acentos, com as formas originais.
+ *
+ * Na contagem agrupada, "será" e "sera" somam na mesma chave sem acentos, como em
+ * `TOKENIZADOR_SEM_ACENTOS`, mas cada chave guarda também as formas em que a palavra apareceu e
+ * quantas vezes apareceu em cada uma. A forma mais frequente é mantida durante a contagem, de
+ * forma que a contagem agrupada é exibida com a grafia do texto, sem uma segunda passada que
+ * remova os acentos, e a tabela de contagem tem uma entrada por palavra sem acentos.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef FORMAS_HPP_
+#define FORMAS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tokenizador.hpp"
+
+/**
+ * \brief Contagem de uma palavra sem acentos e das formas originais agrupadas nela.
+ *
+ * A forma escrita exatamente como a chave, a mais comum, é contada em `iguais`, sem ser guardada
+ * de novo; apenas as formas diferentes da chave ficam em `formas`.
+ */
+struct FormasPalavra {
+    /**
+     * \brief Valor de `preferida` quando a forma mais frequente é a própria chave.
+     */
+    static const std::size_t FORMA_CHAVE = static_cast<std::size_t>(-1);
+
+    int total = 0;                                       ///< Ocorrências somadas de todas as formas.
+    int iguais = 0;                                      ///< Ocorrências escritas como a chave.
+    int maximo = 0;                                      ///< Ocorrências da forma preferida.
+    std::size_t preferida = FORMA_CHAVE;                 ///< Posição da forma mais frequente em `formas`.
+    std::vector<std::pair<std::wstring, int>> formas;    ///< As demais formas e as suas ocorrências.
+
+    /**
+     * \brief Conta uma ocorrência de uma forma, atualizando a forma mais frequente.
+     *
+     * Em caso de empate, continua preferida a forma que chegou primeiro àquele número de ocorrências.
+     *
+     * \param chave A chave sem acentos da palavra.
+     * \param inicio O primeiro caractere da forma.
+     * \param fim O caractere seguinte ao último.
+     */
+    void contar(const std::wstring& chave, const wchar_t* inicio, const wchar_t* fim);
+
+    /**
+     * \brief Retorna a forma mais frequente da palavra.
+     *
+     * \param chave A chave sem acentos da palavra, com a qual ela está na tabela.
+     */
+    const std::wstring& forma(const std::wstring& chave) const {
+        return preferida == FORMA_CHAVE ? chave : formas[preferida].first;
+    }
+};
+
+/**
+ * \brief Contagem agrupada: cada chave sem acentos e as suas formas.
+ */
+typedef std::map<std::wstring, FormasPalavra> ContagemFormas;
+
+/**
+ * \brief Função para contar as palavras de um texto agrupadas sem acentos, com as formas originais.
+ *
+ * As palavras são separadas e convertidas para minúsculas como em `contar_palavras`; a chave é a
+ * palavra sem acentos, e a forma guardada é a palavra antes da remoção dos acentos.
+ *
+ * \param texto O texto onde as palavras serão contadas.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`; `TOKENIZADOR_SEM_ACENTOS` é implícito.
+ * \return A contagem agrupada.
+ */
+ContagemFormas contar_formas(const std::wstring& texto, std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+/**
+ * \brief Função para contar as palavras lidas de um descritor agrupadas sem acentos.
+ *
+ * Lê o descritor em blocos, com as mesmas regras de `contar_palavras_fluxo`, e conta com um
+ * `ContadorIncremental` no modo de formas.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`; `TOKENIZADOR_SEM_ACENTOS` é implícito.
+ * \return A contagem agrupada.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+ContagemFormas contar_formas_fluxo(int descritor, std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+/**
+ * \brief Função para selecionar as palavras mais frequentes de uma contagem agrupada.
+ *
+ * \param contagem A contagem agrupada.
+ * \param k O número de palavras desejado; zero seleciona todas.
+ * \return Um vetor de pares (forma mais frequente, total), em ordem decrescente de total.
+ */
+std::vector<std::pair<std::wstring, int>> mais_frequentes(const ContagemFormas& contagem, std::size_t k);
+
+/**
+ * \brief Função para exibir uma contagem agrupada em ordem alfabética sem acentos.
+ *
+ * Cada palavra é exibida na sua forma mais frequente, com o total de todas as formas. A ordem é a
+ * da tabela, que já está ordenada pelas chaves sem acentos.
+ *
+ * \param contagem A contagem agrupada.
+ */
+void imprimir_contagem(const ContagemFormas& contagem);
+
+#endif  // FORMAS_HPP_
@@ -0,0 +1,133 @@
+/**
+ * \file gera_corpus.cpp
+ * \brief Programa de linha de comando para gerar um corpus sintético em português.
+ *
+ * Uso: `gera_corpus [opções] [arquivo]`. Sem arquivo, ou com `-` no lugar do arquivo, o texto é
+ * escrito na saída padrão, o que permite comprimi-lo ou contá-lo em fluxo
+ * (por exemplo, `./gera_corpus --tamanho 4G | gzip > corpus.gz`).
+ *
+ * Opções (os tamanhos aceitam os sufixos K, M e G):
+ * - `--semente N`: semente do sorteio (padrão: 1).
+ * - `--tamanho BYTES`: tamanho mínimo do texto (padrão: 1M).
+ * - `--vocabulario N`: número de palavras distintas (padrão: 50000).
+ * - `--zipf S`: expoente da lei de Zipf; 0 sorteia as palavras uniformemente (padrão: 1).
+ * - `--acentos F`: fração das palavras com acento ou cedilha (padrão: 0.2).
+ * - `--pontuacao F`: probabilidade de pontuação após cada palavra (padrão: 0.1).
+ * - `--linhas MIN,MAX`: comprimento das linhas, em bytes (padrão: 40,120).
+ * - `--invalidos F`: probabilidade de uma sequência UTF-8 inválida após cada palavra (padrão: 0).
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <ios>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "gerador_corpus.hpp"
+
+/**
+ * \brief Exibe a forma de uso do programa na saída de erros.
+ */
+static void exibir_uso() {
+    std::cerr << "Uso: gera_corpus [--semente N] [--tamanho BYTES] [--vocabulario N] [--zipf S]\n"
+                 "                 [--acentos F] [--pontuacao F] [--linhas MIN,MAX] [--invalidos F]\n"
+                 "                 [arquivo]\n";
+}
+
+/**
+ * \brief Converte um tamanho com sufixo opcional (K, M ou G, em potências de 1024).
+ *
+ * \throws std::invalid_argument Se o texto não for um tamanho válido.
+ */
+static std::uint64_t ler_tamanho(const std::string& texto) {
+    char* fim = nullptr;
+    unsigned long long valor = std::strtoull(texto.c_str(), &fim, 10);
+    if (fim == texto.c_str()) {
+        throw std::invalid_argument("Tamanho invalido.");
+    }
+    std::string sufixo(fim);
+    if (sufixo == "K" || sufixo == "k") {
+        valor <<= 10;
+    } else if (sufixo == "M" || sufixo == "m") {
+        valor <<= 20;
+    } else if (sufixo == "G" || sufixo == "g") {
+        valor <<= 30;
+    } else if (!sufixo.empty()) {
+        throw std::invalid_argument("Tamanho invalido.");
+    }
+    return valor;
+}
+
+int main(int argc, char* argv[]) {
+    ConfiguracaoCorpus configuracao;
+    std::string nome_arquivo = "-";
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argumento = argv[i];
+            if (argumento.compare(0, 2, "--") == 0 && i + 1 >= argc) {
+                exibir_uso();
+                return 1;
+            }
+            if (argumento == "--semente") {
+                configuracao.semente = ler_tamanho(argv[++i]);
+            } else if (argumento == "--tamanho") {
+                configuracao.tamanho = ler_tamanho(argv[++i]);
+            } else if (argumento == "--vocabulario") {
+                configuracao.vocabulario = static_cast<std::size_t>(ler_tamanho(argv[++i]));
+            } else if (argumento == "--zipf") {
+                configuracao.expoente_zipf = std::stod(argv[++i]);
+            } else if (argumento == "--acentos") {
+                configuracao.densidade_acentos = std::stod(argv[++i]);
+            } else if (argumento == "--pontuacao") {
+                configuracao.densidade_pontuacao = std::stod(argv[++i]);
+            } else if (argumento == "--invalidos") {
+                configuracao.taxa_invalidos = std::stod(argv[++i]);
+            } else if (argumento == "--linhas") {
+                std::string limites = argv[++i];
+                std::size_t virgula = limites.find(',');
+                if (virgula == std::string::npos) {
+                    exibir_uso();
+                    return 1;
+                }
+                configuracao.linha_minima = static_cast<std::size_t>(ler_tamanho(limites.substr(0, virgula)));
+                configuracao.linha_maxima = static_cast<std::size_t>(ler_tamanho(limites.substr(virgula + 1)));
+            } else if (argumento.compare(0, 2, "--") == 0) {
+                exibir_uso();
+                return 1;
+            } else {
+                nome_arquivo = argumento;
+            }
+        }
+    } catch (const std::exception&) {
+        exibir_uso();
+        return 1;
+    }
+
+    int descritor = STDOUT_FILENO;
+    if (nome_arquivo != "-") {
+        descritor = ::open(nome_arquivo.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (descritor < 0) {
+            std::cerr << "Nao foi possivel abrir o arquivo." << std::endl;
+            return 1;
+        }
+    }
+
+    int situacao = 0;
+    try {
+        gravar_corpus(configuracao, descritor);
+    } catch (const std::exception& erro) {
+        std::cerr << erro.what() << std::endl;
+        situacao = 1;
+    }
+    if (descritor != STDOUT_FILENO && ::close(descritor) != 0) {
+        std::cerr << "Nao foi possivel gravar o corpus." << std::endl;
+        situacao = 1;
+    }
+    return situacao;
+}
@@ -0,0 +1,376 @@
+#!/usr/bin/env python3
+"""Gera tabelas_unicode.cpp a partir do banco de dados Unicode do Python (modulo unicodedata).
+
+Uso: python3 gera_tabelas.py > tabelas_unicode.cpp (ou `make tabelas`).
+
+As propriedades de normalizacao do UAX #15 (classes de combinacao, decomposicoes e composicoes)
+tambem vem do unicodedata. As propriedades Word_Break do UAX #29 e Simple_Case_Folding nao estao no
+modulo unicodedata; elas sao lidas do Unicode::UCD do perl, que precisa ter a mesma versao do
+Unicode que o Python.
+
+As tabelas sao consultadas por caractere durante a contagem; gera-las aqui, uma vez, evita
+chamadas a localidade (iswspace, iswpunct, towlower) no laco principal e torna a classificacao
+independente da localidade do ambiente.
+"""
+
+import subprocess
+import sys
+import unicodedata
+
+LIMITE_TABELA = 0x800
+MAXIMO = 0x110000
+
+CLASSE_ESPACO = 0
+CLASSE_LETRA = 1
+CLASSE_DIGITO = 2
+CLASSE_PONTUACAO = 3
+
+NOMES_CLASSES = ['CLASSE_ESPACO', 'CLASSE_LETRA', 'CLASSE_DIGITO', 'CLASSE_PONTUACAO']
+
+# Os mesmos espacos de iswspace na glibc: White_Space sem os espacos que nao quebram a linha
+# (U+00A0, U+2007 e U+202F), que ficam colados as palavras.
+ESPACOS = set([0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x20, 0x1680, 0x2028, 0x2029, 0x205F, 0x3000] +
+              list(range(0x2000, 0x2007)) + list(range(0x2008, 0x200B)))
+
+
+def classe(ponto):
+    """Classe de um ponto de codigo; formatacao, uso privado e nao atribuidos contam como letra."""
+    if ponto in ESPACOS:
+        return CLASSE_ESPACO
+    categoria = unicodedata.category(chr(ponto))
+    if categoria[0] in 'LM':
+        return CLASSE_LETRA
+    if categoria[0] == 'N':
+        return CLASSE_DIGITO
+    if categoria[0] in 'PSZ' or categoria == 'Cc':
+        return CLASSE_PONTUACAO
+    return CLASSE_LETRA
+
+
+def gerar_classes(saida):
+    valores = [classe(ponto) for ponto in range(LIMITE_TABELA)]
+    saida.write('const unsigned char TABELA_CLASSES[LIMITE_TABELA_CLASSES] = {\n')
+    for inicio in range(0, LIMITE_TABELA, 32):
+        saida.write('    ' + ', '.join(str(valor) for valor in valores[inicio:inicio + 32]) + ',\n')
+    saida.write('};\n\n')
+
+    # Acima da tabela, apenas os intervalos que nao sao letras; o restante e letra
+    intervalos = []
+    ponto = LIMITE_TABELA
+    while ponto < MAXIMO:
+        atual = classe(ponto)
+        fim = ponto
+        while fim + 1 < MAXIMO and classe(fim + 1) == atual:
+            fim += 1
+        if atual != CLASSE_LETRA:
+            intervalos.append((ponto, fim, atual))
+        ponto = fim + 1
+
+    saida.write('const IntervaloClasse INTERVALOS_CLASSES[] = {\n')
+    for inicio, fim, atual in intervalos:
+        saida.write('    {0x%04X, 0x%04X, %s},\n' % (inicio, fim, NOMES_CLASSES[atual]))
+    saida.write('};\n\n')
+    saida.write('const std::size_t NUMERO_INTERVALOS_CLASSES = sizeof(INTERVALOS_CLASSES) / '
+                'sizeof(INTERVALOS_CLASSES[0]);\n')
+
+
+# Marcas combinantes removidas junto com os acentos (Combining Diacritical Marks)
+MARCAS_COMBINANTES = range(0x0300, 0x0370)
+
+
+def sem_acento(ponto):
+    """Letra base da decomposicao canonica, ou 0 para as marcas combinantes, que sao removidas."""
+    if ponto in MARCAS_COMBINANTES:
+        return 0
+    decomposta = unicodedata.normalize('NFD', chr(ponto))
+    if len(decomposta) > 1 and all(ord(marca) in MARCAS_COMBINANTES for marca in decomposta[1:]):
+        return ord(decomposta[0])
+    return ponto
+
+
+def gerar_sem_acentos(saida):
+    saida.write('\nconst std::uint16_t TABELA_SEM_ACENTOS[LIMITE_TABELA_CLASSES] = {\n')
+    for inicio in range(0, LIMITE_TABELA, 16):
+        saida.write('    ' + ', '.join('0x%04X' % sem_acento(ponto) for ponto in range(inicio, inicio + 16)) + ',\n')
+    saida.write('};\n')
+
+
+# Classes de Word_Break, na ordem de QuebraPalavra em tabelas_unicode.hpp
+CLASSES_QUEBRA = ['Other', 'CR', 'LF', 'Newline', 'Extend', 'ZWJ', 'Regional_Indicator', 'Format',
+                  'Katakana', 'Hebrew_Letter', 'ALetter', 'Single_Quote', 'Double_Quote', 'MidNumLet',
+                  'MidLetter', 'MidNum', 'Numeric', 'ExtendNumLet', 'WSegSpace']
+NOMES_QUEBRA = ['QUEBRA_OUTRO', 'QUEBRA_CR', 'QUEBRA_LF', 'QUEBRA_NOVA_LINHA', 'QUEBRA_EXTENSAO', 'QUEBRA_ZWJ',
+                'QUEBRA_REGIONAL', 'QUEBRA_FORMATO', 'QUEBRA_KATAKANA', 'QUEBRA_HEBRAICA', 'QUEBRA_LETRA',
+                'QUEBRA_ASPAS_SIMPLES', 'QUEBRA_ASPAS_DUPLAS', 'QUEBRA_MEIO_NUMERO_LETRA', 'QUEBRA_MEIO_LETRA',
+                'QUEBRA_MEIO_NUMERO', 'QUEBRA_NUMERO', 'QUEBRA_EXTENSAO_NUMERO_LETRA', 'QUEBRA_ESPACO']
+PICTOGRAFICO = 0x80
+DESLOCAMENTO_BLOCO_QUEBRA = 8
+
+# Adaptacao ao portugues: o hifen une letras como MidLetter (guarda-chuva, disse-lhe), mas
+# continua separando numeros (2025-10-19).
+HIFENS = [0x002D, 0x2010, 0x2011]
+
+CODIGO_PERL = r'''
+use Unicode::UCD qw(prop_invmap prop_invlist);
+my ($inicios, $valores) = prop_invmap("Word_Break");
+print "$inicios->[$_] $valores->[$_]\n" for 0 .. $#$inicios;
+my @pictograficos = prop_invlist("Extended_Pictographic");
+print "pict @pictograficos\n";
+'''
+
+
+def executar_perl(codigo):
+    """Linhas escritas pelo codigo perl, depois de conferir a versao do Unicode do perl."""
+    codigo = 'print Unicode::UCD::UnicodeVersion(), "\\n";\n' + codigo
+    linhas = subprocess.check_output(['perl', '-MUnicode::UCD', '-e', codigo], universal_newlines=True).splitlines()
+    if linhas[0] != unicodedata.unidata_version:
+        sys.exit('Unicode do perl (%s) difere do Python (%s)' % (linhas[0], unicodedata.unidata_version))
+    return linhas[1:]
+
+
+def ler_quebras():
+    """Word_Break e Extended_Pictographic de cada ponto de codigo, lidos do perl."""
+    linhas = executar_perl(CODIGO_PERL)
+    valores = [0] * MAXIMO
+    mapa = [tuple(linha.split()) for linha in linhas[:-1]]
+    for indice, (inicio, nome) in enumerate(mapa):
+        fim = int(mapa[indice + 1][0]) if indice + 1 < len(mapa) else MAXIMO
+        # O perl junta Extended_Pictographic ao nome e adapta os espacos; a lista de
+        # pictograficos e os espacos de WSegSpace sao recalculados abaixo.
+        nome = {'ExtPict_LE': 'ALetter', 'ExtPict_XX': 'Other', 'Perl_Tailored_HSpace': 'Other'}.get(nome, nome)
+        for ponto in range(int(inicio), fim):
+            valores[ponto] = CLASSES_QUEBRA.index(nome)
+    for ponto in range(MAXIMO):
+        caractere = chr(ponto)
+        if unicodedata.category(caractere) == 'Zs' and \
+                not unicodedata.decomposition(caractere).startswith('<noBreak>'):
+            valores[ponto] = CLASSES_QUEBRA.index('WSegSpace')
+    for ponto in HIFENS:
+        valores[ponto] = CLASSES_QUEBRA.index('MidLetter')
+    pictograficos = [int(valor) for valor in linhas[-1].split()[1:]]
+    for indice in range(0, len(pictograficos), 2):
+        fim = pictograficos[indice + 1] if indice + 1 < len(pictograficos) else MAXIMO
+        for ponto in range(pictograficos[indice], fim):
+            valores[ponto] |= PICTOGRAFICO
+    return valores
+
+
+def pares_unidos():
+    """Pares (anterior, atual) sem quebra pelas regras de um par do UAX #29, depois de WB4."""
+    classe = CLASSES_QUEBRA.index
+    letras = [classe('ALetter'), classe('Hebrew_Letter')]
+    pares = set()
+    for a in letras:
+        for b in letras:
+            pares.add((a, b))                                           # WB5
+        pares.add((a, classe('Numeric')))                               # WB9
+        pares.add((classe('Numeric'), a))                               # WB10
+        pares.add((a, classe('ExtendNumLet')))                          # WB13a
+        pares.add((classe('ExtendNumLet'), a))                          # WB13b
+    pares.add((classe('Hebrew_Letter'), classe('Single_Quote')))        # WB7a
+    pares.add((classe('Numeric'), classe('Numeric')))                   # WB8
+    pares.add((classe('Katakana'), classe('Katakana')))                 # WB13
+    for a in ['Numeric', 'Katakana', 'ExtendNumLet']:
+        pares.add((classe(a), classe('ExtendNumLet')))                  # WB13a
+    for b in ['Numeric', 'Katakana']:
+        pares.add((classe('ExtendNumLet'), classe(b)))                  # WB13b
+    mascaras = [0] * len(CLASSES_QUEBRA)
+    for a, b in pares:
+        mascaras[a] |= 1 << b
+    return mascaras
+
+
+def gerar_quebras(saida):
+    valores = ler_quebras()
+    tamanho_bloco = 1 << DESLOCAMENTO_BLOCO_QUEBRA
+    blocos = []
+    indices = {}
+    indice = []
+    for inicio in range(0, MAXIMO, tamanho_bloco):
+        bloco = tuple(valores[inicio:inicio + tamanho_bloco])
+        if bloco not in indices:
+            indices[bloco] = len(blocos)
+            blocos.append(bloco)
+        indice.append(indices[bloco])
+    if len(blocos) > 256:
+        sys.exit('Blocos demais para um indice de 8 bits')
+
+    saida.write('\nconst unsigned char INDICE_QUEBRA[MAXIMO_PONTO_CODIGO >> DESLOCAMENTO_BLOCO_QUEBRA] = {\n')
+    for inicio in range(0, len(indice), 24):
+        saida.write('    ' + ', '.join(str(valor) for valor in indice[inicio:inicio + 24]) + ',\n')
+    saida.write('};\n\n')
+    saida.write('const unsigned char BLOCOS_QUEBRA[][1 << DESLOCAMENTO_BLOCO_QUEBRA] = {\n')
+    for bloco in blocos:
+        saida.write('    {\n')
+        for inicio in range(0, tamanho_bloco, 16):
+            saida.write('        ' + ', '.join('0x%02X' % valor for valor in bloco[inicio:inicio + 16]) + ',\n')
+        saida.write('    },\n')
+    saida.write('};\n\n')
+    saida.write('const std::uint32_t PARES_UNIDOS[NUMERO_CLASSES_QUEBRA] = {\n')
+    for nome, mascara in zip(NOMES_QUEBRA, pares_unidos()):
+        saida.write('    0x%05X,  // %s\n' % (mascara, nome))
+    saida.write('};\n')
+
+
+# Simple_Case_Folding (CaseFolding.txt, status C e S): a cada ponto de codigo, um unico ponto
+CODIGO_PERL_CAIXA = r'''
+use Unicode::UCD qw(prop_invmap);
+my ($inicios, $valores) = prop_invmap("Simple_Case_Folding");
+print "$inicios->[$_] $valores->[$_]\n" for 0 .. $#$inicios;
+'''
+DESLOCAMENTO_BLOCO_MINUSCULAS = 8
+
+
+def ler_minusculas():
+    """Diferenca entre o ponto de codigo dobrado (Simple_Case_Folding) e o original."""
+    diferencas = [0] * MAXIMO
+    mapa = [tuple(int(valor) for valor in linha.split()) for linha in executar_perl(CODIGO_PERL_CAIXA)]
+    for indice, (inicio, dobrado) in enumerate(mapa):
+        # No formato ajustado do perl, zero indica que o intervalo nao muda; os demais pontos do
+        # intervalo sao dobrados para os pontos seguintes ao primeiro
+        if dobrado == 0:
+            continue
+        fim = mapa[indice + 1][0] if indice + 1 < len(mapa) else MAXIMO
+        for ponto in range(inicio, fim):
+            diferencas[ponto] = dobrado - inicio
+    return diferencas
+
+
+def gerar_minusculas(saida):
+    diferencas = ler_minusculas()
+    tamanho_bloco = 1 << DESLOCAMENTO_BLOCO_MINUSCULAS
+    blocos = []
+    indices = {}
+    indice = []
+    for inicio in range(0, MAXIMO, tamanho_bloco):
+        bloco = tuple(diferencas[inicio:inicio + tamanho_bloco])
+        if bloco not in indices:
+            indices[bloco] = len(blocos)
+            blocos.append(bloco)
+        indice.append(indices[bloco])
+    if len(blocos) > 256:
+        sys.exit('Blocos demais para um indice de 8 bits')
+
+    saida.write('\nconst unsigned char INDICE_MINUSCULAS[MAXIMO_PONTO_CODIGO >> DESLOCAMENTO_BLOCO_MINUSCULAS] = {\n')
+    for inicio in range(0, len(indice), 24):
+        saida.write('    ' + ', '.join(str(valor) for valor in indice[inicio:inicio + 24]) + ',\n')
+    saida.write('};\n\n')
+    saida.write('const std::int32_t BLOCOS_MINUSCULAS[][1 << DESLOCAMENTO_BLOCO_MINUSCULAS] = {\n')
+    for bloco in blocos:
+        saida.write('    {\n')
+        for inicio in range(0, tamanho_bloco, 16):
+            saida.write('        ' + ', '.join(str(valor) for valor in bloco[inicio:inicio + 16]) + ',\n')
+        saida.write('    },\n')
+    saida.write('};\n')
+
+
+# Bits somados a classe de combinacao canonica (Canonical_Combining_Class) na tabela de normalizacao
+NAO_NFD = 0x100
+NAO_NFC = 0x200
+TALVEZ_NFC = 0x400
+DESLOCAMENTO_BLOCO_NORMALIZACAO = 8
+# Limites em tabelas_unicode.hpp: abaixo deles todo caractere ja esta na forma normal
+LIMITE_RAPIDO_NFC = 0x300
+LIMITE_RAPIDO_NFD = 0xC0
+# Silabas e jamos do hangul, compostos e decompostos por formula, sem tabela
+SILABAS_HANGUL = range(0xAC00, 0xD7A4)
+JAMOS_TALVEZ = list(range(0x1161, 0x1176)) + list(range(0x11A8, 0x11C3))
+
+
+def ler_normalizacao():
+    """Propriedades de normalizacao, decomposicoes completas e pares de composicao primaria."""
+    propriedades = [0] * MAXIMO
+    decomposicoes = []
+    composicoes = []
+    for ponto in range(MAXIMO):
+        if 0xD800 <= ponto <= 0xDFFF:
+            continue
+        caractere = chr(ponto)
+        valor = unicodedata.combining(caractere)
+        decomposto = unicodedata.normalize('NFD', caractere)
+        if decomposto != caractere:
+            valor |= NAO_NFD
+        if unicodedata.normalize('NFC', caractere) != caractere:
+            valor |= NAO_NFC
+        propriedades[ponto] = valor
+        mapeamento = unicodedata.decomposition(caractere)
+        if not mapeamento or mapeamento.startswith('<') or ponto in SILABAS_HANGUL:
+            continue
+        decomposicoes.append((ponto, [ord(parte) for parte in decomposto]))
+        partes = [int(parte, 16) for parte in mapeamento.split()]
+        # Composicao primaria: decomposicao em dois caracteres que o NFC volta a compor
+        if len(partes) == 2 and not valor & NAO_NFC:
+            composicoes.append((partes[0], partes[1], ponto))
+    for ponto in set(segundo for _, segundo, _ in composicoes) | set(JAMOS_TALVEZ):
+        propriedades[ponto] |= TALVEZ_NFC
+    for limite, impede in [(LIMITE_RAPIDO_NFC, 0xFF | NAO_NFC | TALVEZ_NFC), (LIMITE_RAPIDO_NFD, 0xFF | NAO_NFD)]:
+        if any(valor & impede for valor in propriedades[:limite]):
+            sys.exit('Limite rapido 0x%X incorreto' % limite)
+    return propriedades, decomposicoes, sorted(composicoes)
+
+
+def gerar_normalizacao(saida):
+    propriedades, decomposicoes, composicoes = ler_normalizacao()
+    tamanho_bloco = 1 << DESLOCAMENTO_BLOCO_NORMALIZACAO
+    blocos = []
+    indices = {}
+    indice = []
+    for inicio in range(0, MAXIMO, tamanho_bloco):
+        bloco = tuple(propriedades[inicio:inicio + tamanho_bloco])
+        if bloco not in indices:
+            indices[bloco] = len(blocos)
+            blocos.append(bloco)
+        indice.append(indices[bloco])
+    if len(blocos) > 256:
+        sys.exit('Blocos demais para um indice de 8 bits')
+
+    saida.write('\nconst unsigned char INDICE_NORMALIZACAO[MAXIMO_PONTO_CODIGO >> DESLOCAMENTO_BLOCO_NORMALIZACAO] = {\n')
+    for inicio in range(0, len(indice), 24):
+        saida.write('    ' + ', '.join(str(valor) for valor in indice[inicio:inicio + 24]) + ',\n')
+    saida.write('};\n\n')
+    saida.write('const std::uint16_t BLOCOS_NORMALIZACAO[][1 << DESLOCAMENTO_BLOCO_NORMALIZACAO] = {\n')
+    for bloco in blocos:
+        saida.write('    {\n')
+        for inicio in range(0, tamanho_bloco, 16):
+            saida.write('        ' + ', '.join('0x%03X' % valor for valor in bloco[inicio:inicio + 16]) + ',\n')
+        saida.write('    },\n')
+    saida.write('};\n\n')
+
+    dados = []
+    saida.write('const Decomposicao DECOMPOSICOES[] = {\n')
+    for ponto, partes in decomposicoes:
+        saida.write('    {0x%05X, %d, %d},\n' % (ponto, len(dados), len(partes)))
+        dados.extend(partes)
+    saida.write('};\n\n')
+    saida.write('const std::size_t NUMERO_DECOMPOSICOES = sizeof(DECOMPOSICOES) / sizeof(DECOMPOSICOES[0]);\n\n')
+    saida.write('const std::uint32_t DADOS_DECOMPOSICOES[] = {\n')
+    for inicio in range(0, len(dados), 10):
+        saida.write('    ' + ', '.join('0x%05X' % valor for valor in dados[inicio:inicio + 10]) + ',\n')
+    saida.write('};\n\n')
+    saida.write('const Composicao COMPOSICOES[] = {\n')
+    for primeiro, segundo, composto in composicoes:
+        saida.write('    {0x%05X, 0x%05X, 0x%05X},\n' % (primeiro, segundo, composto))
+    saida.write('};\n\n')
+    saida.write('const std::size_t NUMERO_COMPOSICOES = sizeof(COMPOSICOES) / sizeof(COMPOSICOES[0]);\n')
+
+
+def main():
+    saida = sys.stdout
+    saida.write('/**\n'
+                ' * \\file tabelas_unicode.cpp\n'
+                ' * \\brief Tabelas de propriedades Unicode geradas por gera_tabelas.py (Unicode %s).\n'
+                ' *\n'
+                ' * Arquivo gerado; nao edite. Para atualizar, execute `make tabelas`.\n'
+                ' *\n'
+                ' * \\copyright 2025 Alexandre\n'
+                ' */\n\n' % unicodedata.unidata_version)
+    saida.write('#include "tabelas_unicode.hpp"\n\n')
+    gerar_classes(saida)
+    gerar_sem_acentos(saida)
+    gerar_minusculas(saida)
+    gerar_quebras(saida)
+    gerar_normalizacao(saida)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,252 @@
+/**
+ * \file gerador_corpus.cpp
+ * \brief Implementação do gerador de corpus sintético em português.
+ *
+ * O sorteio das palavras usa o método dos aliases de Vose: cada sorteio custa um número
+ * pseudoaleatório e uma comparação, independentemente do tamanho do vocabulário, o que mantém
+ * a geração de vários gigabytes limitada pela gravação.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "gerador_corpus.hpp"
+
+#include <errno.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ios>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace {
+
+const char* const SILABAS[] = {"a",  "ba",  "ca",  "co",  "da",  "de",  "di",  "do",  "e",   "fa",
+                               "fi", "ga",  "go",  "i",   "la",  "le",  "li",  "lo",  "ma",  "me",
+                               "mi", "mo",  "na",  "ne",  "no",  "o",   "pa",  "pe",  "po",  "que",
+                               "ra", "re",  "ri",  "ro",  "sa",  "se",  "si",  "so",  "ta",  "te",
+                               "ti", "to",  "tu",  "va",  "ve",  "vi",  "vo",  "com", "par", "por",
+                               "men", "ter", "tar", "can", "con", "des", "tra", "pre", "pro", "res"};
+const std::size_t NUMERO_SILABAS = sizeof(SILABAS) / sizeof(SILABAS[0]);
+
+const char* const TERMINACOES[] = {"", "", "", "s", "r", "l", "m", "cao", "coes", "dade", "mente"};
+const std::size_t NUMERO_TERMINACOES = sizeof(TERMINACOES) / sizeof(TERMINACOES[0]);
+
+const char* const SEQUENCIAS_INVALIDAS[] = {
+    "\x80",       // byte de continuação solto
+    "\xC3",       // sequência de dois bytes truncada
+    "\xE2\x82",   // sequência de três bytes truncada
+    "\xC0\xAF",   // codificação longa demais de '/'
+    "\xFF"        // byte que nunca ocorre em UTF-8
+};
+const std::size_t NUMERO_INVALIDAS = sizeof(SEQUENCIAS_INVALIDAS) / sizeof(SEQUENCIAS_INVALIDAS[0]);
+
+/**
+ * \brief Retorna as formas acentuadas de uma vogal, em UTF-8, separadas por espaço.
+ */
+const char* formas_acentuadas(char vogal) {
+    switch (vogal) {
+        case 'a': return "á â ã à";
+        case 'e': return "é ê";
+        case 'i': return "í";
+        case 'o': return "ó ô õ";
+        case 'u': return "ú";
+        default: return nullptr;
+    }
+}
+
+/**
+ * \brief Converte a primeira letra de uma palavra em maiúscula (ASCII ou Latin-1 em UTF-8).
+ */
+void capitalizar(std::string& bloco, std::size_t inicio) {
+    unsigned char primeiro = static_cast<unsigned char>(bloco[inicio]);
+    if (primeiro >= 'a' && primeiro <= 'z') {
+        bloco[inicio] = static_cast<char>(primeiro - 'a' + 'A');
+    } else if (primeiro == 0xC3 && inicio + 1 < bloco.size()) {
+        unsigned char segundo = static_cast<unsigned char>(bloco[inicio + 1]);
+        if (segundo >= 0xA0 && segundo <= 0xBE && segundo != 0xB7) {
+            bloco[inicio + 1] = static_cast<char>(segundo - 0x20);
+        }
+    }
+}
+
+}  // namespace
+
+GeradorCorpus::GeradorCorpus(const ConfiguracaoCorpus& configuracao)
+    : configuracao_(configuracao), estado_(configuracao.semente), gerados_(0), linha_(0),
+      alvo_linha_(0), inicio_frase_(true) {
+    if (configuracao.vocabulario == 0 || configuracao.vocabulario > 0xFFFFFFFFu ||
+        configuracao.expoente_zipf < 0.0 || configuracao.densidade_acentos < 0.0 ||
+        configuracao.densidade_acentos > 1.0 || configuracao.densidade_pontuacao < 0.0 ||
+        configuracao.densidade_pontuacao > 1.0 || configuracao.taxa_invalidos < 0.0 ||
+        configuracao.taxa_invalidos > 1.0 || configuracao.linha_minima == 0 ||
+        configuracao.linha_minima > configuracao.linha_maxima) {
+        throw std::invalid_argument("Configuracao de corpus invalida.");
+    }
+    montar_vocabulario();
+    montar_tabela();
+    alvo_linha_ = configuracao_.linha_minima +
+                  sortear_abaixo(configuracao_.linha_maxima - configuracao_.linha_minima + 1);
+}
+
+std::uint64_t GeradorCorpus::sortear() {
+    // SplitMix64
+    std::uint64_t valor = (estado_ += 0x9E3779B97F4A7C15ULL);
+    valor = (valor ^ (valor >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    valor = (valor ^ (valor >> 27)) * 0x94D049BB133111EBULL;
+    return valor ^ (valor >> 31);
+}
+
+double GeradorCorpus::sortear_real() {
+    return static_cast<double>(sortear() >> 11) / 9007199254740992.0;
+}
+
+std::size_t GeradorCorpus::sortear_abaixo(std::size_t limite) {
+    return static_cast<std::size_t>(sortear_real() * static_cast<double>(limite));
+}
+
+std::size_t GeradorCorpus::sortear_palavra() {
+    std::size_t indice = sortear_abaixo(probabilidades_.size());
+    return sortear_real() < probabilidades_[indice] ? indice : aliases_[indice];
+}
+
+void GeradorCorpus::montar_vocabulario() {
+    std::unordered_set<std::string> existentes;
+    std::size_t maximo_silabas = 4;
+    std::size_t repetidas = 0;
+    while (vocabulario_.size() < configuracao_.vocabulario) {
+        std::string palavra;
+        for (std::size_t i = 1 + sortear_abaixo(maximo_silabas); i > 0; --i) {
+            palavra += SILABAS[sortear_abaixo(NUMERO_SILABAS)];
+        }
+        palavra += TERMINACOES[sortear_abaixo(NUMERO_TERMINACOES)];
+
+        if (sortear_real() < configuracao_.densidade_acentos) {
+            // As terminações "cao" e "coes" ganham cedilha e til; as demais palavras, um acento
+            std::size_t tamanho = palavra.size();
+            if (tamanho > 3 && palavra.compare(tamanho - 3, 3, "cao") == 0) {
+                palavra.replace(tamanho - 3, 3, "ção");
+            } else if (tamanho > 4 && palavra.compare(tamanho - 4, 4, "coes") == 0) {
+                palavra.replace(tamanho - 4, 4, "ções");
+            } else {
+                std::vector<std::size_t> vogais;
+                for (std::size_t i = 0; i < palavra.size(); ++i) {
+                    if (formas_acentuadas(palavra[i]) != nullptr) {
+                        vogais.push_back(i);
+                    }
+                }
+                std::size_t posicao = vogais[sortear_abaixo(vogais.size())];
+                std::string formas = formas_acentuadas(palavra[posicao]);
+                std::size_t quantidade = (formas.size() + 1) / 3;
+                palavra.replace(posicao, 1, formas.substr(3 * sortear_abaixo(quantidade), 2));
+            }
+        }
+
+        if (existentes.insert(palavra).second) {
+            vocabulario_.push_back(palavra);
+            repetidas = 0;
+        } else if (++repetidas == 64) {
+            // O espaço de palavras curtas se esgotou; passa a formar palavras mais longas
+            ++maximo_silabas;
+            repetidas = 0;
+        }
+    }
+
+    // Lei da abreviação: as palavras mais frequentes são as mais curtas
+    std::stable_sort(vocabulario_.begin(), vocabulario_.end(),
+                     [](const std::string& a, const std::string& b) { return a.size() < b.size(); });
+}
+
+void GeradorCorpus::montar_tabela() {
+    const std::size_t n = vocabulario_.size();
+    std::vector<double> pesos(n);
+    double soma = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        pesos[i] = std::pow(static_cast<double>(i + 1), -configuracao_.expoente_zipf);
+        soma += pesos[i];
+    }
+
+    probabilidades_.assign(n, 1.0);
+    aliases_.resize(n);
+    std::vector<std::uint32_t> pequenos;
+    std::vector<std::uint32_t> grandes;
+    for (std::size_t i = 0; i < n; ++i) {
+        pesos[i] *= static_cast<double>(n) / soma;
+        aliases_[i] = static_cast<std::uint32_t>(i);
+        (pesos[i] < 1.0 ? pequenos : grandes).push_back(static_cast<std::uint32_t>(i));
+    }
+    while (!pequenos.empty() && !grandes.empty()) {
+        std::uint32_t pequeno = pequenos.back();
+        pequenos.pop_back();
+        std::uint32_t grande = grandes.back();
+        probabilidades_[pequeno] = pesos[pequeno];
+        aliases_[pequeno] = grande;
+        pesos[grande] -= 1.0 - pesos[pequeno];
+        if (pesos[grande] < 1.0) {
+            grandes.pop_back();
+            pequenos.push_back(grande);
+        }
+    }
+    // As sobras, por erro de arredondamento, ficam com probabilidade 1
+}
+
+void GeradorCorpus::acrescentar_palavra(std::string& bloco) {
+    std::size_t inicio = bloco.size();
+    bloco += vocabulario_[sortear_palavra()];
+    if (inicio_frase_) {
+        capitalizar(bloco, inicio);
+        inicio_frase_ = false;
+    }
+    if (configuracao_.taxa_invalidos > 0.0 && sortear_real() < configuracao_.taxa_invalidos) {
+        bloco += SEQUENCIAS_INVALIDAS[sortear_abaixo(NUMERO_INVALIDAS)];
+    }
+    if (configuracao_.densidade_pontuacao > 0.0 && sortear_real() < configuracao_.densidade_pontuacao) {
+        static const char PONTUACAO[] = ",,,,,,,,,,,,....;:!?";
+        char sinal = PONTUACAO[sortear_abaixo(sizeof(PONTUACAO) - 1)];
+        bloco += sinal;
+        inicio_frase_ = sinal == '.' || sinal == '!' || sinal == '?';
+    }
+
+    std::size_t comprimento = bloco.size() - inicio;
+    linha_ += comprimento;
+    if (linha_ >= alvo_linha_ || gerados_ + comprimento + 1 >= configuracao_.tamanho) {
+        bloco += '\n';
+        linha_ = 0;
+        alvo_linha_ = configuracao_.linha_minima +
+                      sortear_abaixo(configuracao_.linha_maxima - configuracao_.linha_minima + 1);
+    } else {
+        bloco += ' ';
+        ++linha_;
+    }
+    gerados_ += comprimento + 1;
+}
+
+bool GeradorCorpus::gerar(std::string& bloco, std::size_t tamanho_bloco) {
+    bloco.clear();
+    while (gerados_ < configuracao_.tamanho && bloco.size() < tamanho_bloco) {
+        acrescentar_palavra(bloco);
+    }
+    return !bloco.empty();
+}
+
+std::uint64_t gravar_corpus(const ConfiguracaoCorpus& configuracao, int descritor) {
+    GeradorCorpus gerador(configuracao);
+    std::string bloco;
+    while (gerador.gerar(bloco)) {
+        const char* dados = bloco.data();
+        std::size_t restantes = bloco.size();
+        while (restantes > 0) {
+            ssize_t gravados = ::write(descritor, dados, restantes);
+            if (gravados < 0 && errno == EINTR) {
+                continue;
+            }
+            if (gravados <= 0) {
+                throw std::ios_base::failure("Nao foi possivel gravar o corpus.");
+            }
+            dados += gravados;
+            restantes -= static_cast<std::size_t>(gravados);
+        }
+    }
+    return gerador.gerados();
+}
@@ -0,0 +1,107 @@
+/**
+ * \file gerador_corpus.hpp
+ * \brief Definições do gerador de corpus sintético em português para testes de escala.
+ *
+ * O gerador produz, a partir de uma semente, sempre o mesmo texto: o sorteio usa um gerador
+ * pseudoaleatório próprio (SplitMix64) e não as distribuições da biblioteca padrão, cujo resultado
+ * varia entre implementações. O vocabulário é formado por sílabas do português e sorteado segundo
+ * a lei de Zipf, com as palavras mais curtas nas posições mais frequentes.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef GERADOR_CORPUS_HPP_
+#define GERADOR_CORPUS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Parâmetros do corpus gerado.
+ */
+struct ConfiguracaoCorpus {
+    std::uint64_t semente = 1;          ///< Semente; a mesma configuração produz o mesmo texto.
+    std::uint64_t tamanho = 1 << 20;    ///< Tamanho mínimo do texto, em bytes.
+    std::size_t vocabulario = 50000;    ///< Número de palavras distintas do vocabulário.
+    double expoente_zipf = 1.0;         ///< Expoente da lei de Zipf; zero sorteia uniformemente.
+    double densidade_acentos = 0.2;     ///< Fração das palavras do vocabulário com acento ou cedilha.
+    double densidade_pontuacao = 0.1;   ///< Probabilidade de um sinal de pontuação após cada palavra.
+    std::size_t linha_minima = 40;      ///< Comprimento mínimo das linhas, em bytes.
+    std::size_t linha_maxima = 120;     ///< Comprimento máximo das linhas, em bytes (aproximado).
+    double taxa_invalidos = 0.0;        ///< Probabilidade de uma sequência UTF-8 inválida após cada palavra.
+};
+
+/**
+ * \brief Gerador de corpus em blocos, para produzir textos maiores que a memória.
+ *
+ * O texto é uma sequência de palavras separadas por espaços e quebras de linha, com pontuação
+ * colada ao fim das palavras e a primeira palavra de cada frase em maiúscula. As sequências
+ * inválidas, quando pedidas, são bytes de continuação soltos, sequências truncadas, codificações
+ * longas demais ou bytes que nunca ocorrem em UTF-8.
+ */
+class GeradorCorpus {
+ public:
+    /**
+     * \brief Monta o vocabulário e a tabela de sorteio.
+     *
+     * \param configuracao Os parâmetros do corpus.
+     * \throws std::invalid_argument Se algum parâmetro estiver fora do intervalo válido.
+     */
+    explicit GeradorCorpus(const ConfiguracaoCorpus& configuracao);
+
+    /**
+     * \brief Gera o próximo bloco do texto.
+     *
+     * O texto termina em uma quebra de linha, no primeiro fim de palavra depois de
+     * `configuracao.tamanho` bytes.
+     *
+     * \param bloco Recebe o bloco, substituindo o conteúdo anterior.
+     * \param tamanho_bloco O tamanho aproximado do bloco, em bytes.
+     * \return Falso se o texto já terminou; nesse caso o bloco fica vazio.
+     */
+    bool gerar(std::string& bloco, std::size_t tamanho_bloco = 1 << 16);
+
+    /**
+     * \brief Retorna o vocabulário, da palavra mais frequente para a menos frequente.
+     */
+    const std::vector<std::string>& vocabulario() const { return vocabulario_; }
+
+    /**
+     * \brief Retorna o número de bytes gerados até agora.
+     */
+    std::uint64_t gerados() const { return gerados_; }
+
+ private:
+    std::uint64_t sortear();
+    double sortear_real();
+    std::size_t sortear_abaixo(std::size_t limite);
+    std::size_t sortear_palavra();
+    void montar_vocabulario();
+    void montar_tabela();
+    void acrescentar_palavra(std::string& bloco);
+
+    ConfiguracaoCorpus configuracao_;
+    std::uint64_t estado_;
+    std::vector<std::string> vocabulario_;
+    std::vector<double> probabilidades_;
+    std::vector<std::uint32_t> aliases_;
+    std::uint64_t gerados_;
+    std::size_t linha_;
+    std::size_t alvo_linha_;
+    bool inicio_frase_;
+};
+
+/**
+ * \brief Função para gravar um corpus inteiro em um descritor, em blocos.
+ *
+ * \param configuracao Os parâmetros do corpus.
+ * \param descritor O descritor de destino (arquivo, pipe ou saída padrão).
+ * \return O número de bytes gravados.
+ * \throws std::invalid_argument Se algum parâmetro estiver fora do intervalo válido.
+ * \throws std::ios_base::failure Se a gravação falhar.
+ */
+std::uint64_t gravar_corpus(const ConfiguracaoCorpus& configuracao, int descritor);
+
+#endif  // GERADOR_CORPUS_HPP_
@@ -0,0 +1,312 @@
+/**
+ * \file indice.cpp
+ * \brief Implementação do índice invertido com as posições das palavras.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "indice.hpp"
+
+#include <sys/mman.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "codificacao.hpp"
+#include "conta_palavras.hpp"
+#include "fluxo.hpp"
+#include "vocabulario.hpp"
+
+/**
+ * \brief Assinatura gravada no início de todo índice.
+ */
+static const char ASSINATURA_INDICE[8] = {'C', 'P', 'I', 'N', 'D', 'E', 'X', '1'};
+
+/**
+ * \brief Versão do formato gravada no cabeçalho.
+ */
+static const std::uint32_t VERSAO_INDICE = 1;
+
+/**
+ * \brief Tamanho do cabeçalho, em bytes.
+ */
+static const std::size_t TAMANHO_CABECALHO_INDICE = 64;
+
+/**
+ * \brief Quantidade de bytes acumulada antes de uma escrita no arquivo.
+ */
+static const std::size_t TAMANHO_BUFFER_INDICE = 1 << 20;
+
+IndexadorPosicoes::IndexadorPosicoes(std::uint32_t configuracao) : contador_(configuracao), inicio_arquivo_(0) {
+    contador_.observar_palavras([this](const std::wstring& palavra, std::uint64_t deslocamento) {
+        registrar(palavra, deslocamento);
+    });
+}
+
+/**
+ * \brief Conta as palavras de um arquivo e registra as suas posições.
+ *
+ * O contador é compartilhado entre os arquivos; o deslocamento de cada ocorrência é calculado a
+ * partir do total de bytes entregue ao contador antes do arquivo.
+ *
+ * \param nome_arquivo O nome do arquivo.
+ * \return O número atribuído ao arquivo no índice.
+ * \throws std::ios_base::failure Se o arquivo não puder ser lido.
+ */
+std::uint32_t IndexadorPosicoes::adicionar_arquivo(const std::string& nome_arquivo) {
+    Arquivo arquivo = abrir_arquivo(nome_arquivo);
+    arquivos_.push_back(nome_arquivo);
+    inicio_arquivo_ = contador_.bytes_processados();
+    alimentar_contador(arquivo.descritor(), contador_);
+    return static_cast<std::uint32_t>(arquivos_.size() - 1);
+}
+
+/**
+ * \brief Acrescenta uma ocorrência à lista da palavra, codificada em relação à anterior.
+ *
+ * \param palavra A palavra encerrada pelo contador.
+ * \param deslocamento O deslocamento da palavra desde o início do texto entregue ao contador.
+ */
+void IndexadorPosicoes::registrar(const std::wstring& palavra, std::uint64_t deslocamento) {
+    std::uint32_t arquivo = static_cast<std::uint32_t>(arquivos_.size() - 1);
+    deslocamento -= inicio_arquivo_;
+    auto posicao = listas_.lower_bound(palavra);
+    if (posicao == listas_.end() || posicao->first != palavra) {
+        ListaOcorrencias vazia = {0, 0, 0, std::string()};
+        posicao = listas_.emplace_hint(posicao, palavra, vazia);
+    }
+    ListaOcorrencias& lista = posicao->second;
+    bool mesmo_arquivo = lista.quantidade > 0 && lista.arquivo == arquivo;
+    acrescentar_varint(lista.dados, arquivo - lista.arquivo);
+    acrescentar_varint(lista.dados, mesmo_arquivo ? deslocamento - lista.deslocamento : deslocamento);
+    lista.arquivo = arquivo;
+    lista.deslocamento = deslocamento;
+    ++lista.quantidade;
+}
+
+/**
+ * \brief Grava o instantâneo de vocabulário e o índice correspondente.
+ *
+ * As listas são percorridas na mesma ordem das palavras do vocabulário, então a i-ésima lista do
+ * índice é a da palavra na posição i. O índice é escrito em um nome temporário e renomeado no fim.
+ *
+ * \param nome_vocabulario O nome do instantâneo de vocabulário.
+ * \param nome_indice O nome do índice.
+ * \throws std::ios_base::failure Se algum dos arquivos não puder ser gravado.
+ */
+void IndexadorPosicoes::gravar(const std::string& nome_vocabulario,
+                               const std::string& nome_indice) const {
+    gravar_vocabulario(contador_.contagem(), nome_vocabulario, contador_.configuracao());
+
+    std::string temporario = nome_indice + ".tmp";
+    std::ofstream saida(temporario, std::ios::binary | std::ios::trunc);
+    if (!saida.is_open()) {
+        throw std::ios_base::failure("Nao foi possivel criar o arquivo.");
+    }
+    char vazio[TAMANHO_CABECALHO_INDICE] = {};
+    saida.write(vazio, sizeof(vazio));
+
+    uLong crc = crc32(0, Z_NULL, 0);
+    std::string buffer;
+    auto descarregar = [&saida, &buffer, &crc]() {
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(buffer.data()), static_cast<uInt>(buffer.size()));
+        saida.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    };
+
+    for (const auto& arquivo : arquivos_) {
+        acrescentar_varint(buffer, arquivo.size());
+        buffer += arquivo;
+    }
+    std::uint64_t bytes_nomes = buffer.size();
+
+    std::vector<std::uint64_t> inicios;
+    inicios.reserve(listas_.size() + 1);
+    std::uint64_t bytes_listas = 0;
+    for (const auto& par : listas_) {
+        inicios.push_back(bytes_listas);
+        std::size_t antes = buffer.size();
+        acrescentar_varint(buffer, par.second.quantidade);
+        buffer += par.second.dados;
+        bytes_listas += buffer.size() - antes;
+        if (buffer.size() >= TAMANHO_BUFFER_INDICE) {
+            descarregar();
+        }
+    }
+    inicios.push_back(bytes_listas);
+
+    unsigned char valor[8];
+    for (std::uint64_t inicio : inicios) {
+        escrever_u64(valor, inicio);
+        buffer.append(reinterpret_cast<const char*>(valor), sizeof(valor));
+        if (buffer.size() >= TAMANHO_BUFFER_INDICE) {
+            descarregar();
+        }
+    }
+    descarregar();
+
+    unsigned char cabecalho[TAMANHO_CABECALHO_INDICE] = {};
+    std::memcpy(cabecalho, ASSINATURA_INDICE, sizeof(ASSINATURA_INDICE));
+    escrever_u32(cabecalho + 8, VERSAO_INDICE);
+    escrever_u32(cabecalho + 12, static_cast<std::uint32_t>(arquivos_.size()));
+    escrever_u64(cabecalho + 16, listas_.size());
+    escrever_u64(cabecalho + 24, bytes_nomes);
+    escrever_u64(cabecalho + 32, bytes_listas);
+    escrever_u32(cabecalho + 40, static_cast<std::uint32_t>(crc));
+    saida.seekp(0);
+    saida.write(reinterpret_cast<const char*>(cabecalho), sizeof(cabecalho));
+    saida.close();
+    if (!saida || std::rename(temporario.c_str(), nome_indice.c_str()) != 0) {
+        std::remove(temporario.c_str());
+        throw std::ios_base::failure("Erro ao gravar o indice.");
+    }
+}
+
+/**
+ * \brief Mapeia um índice na memória.
+ *
+ * O cabeçalho é conferido e os nomes dos arquivos são decodificados; as listas são decodificadas
+ * sob demanda.
+ *
+ * \param nome_arquivo O nome do arquivo do índice.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto ou não for um índice válido.
+ */
+IndicePosicoes::IndicePosicoes(const std::string& nome_arquivo)
+    : mapeamento_(MAP_FAILED), tamanho_mapeamento_(0) {
+    Arquivo arquivo = abrir_arquivo(nome_arquivo);
+    tamanho_mapeamento_ = arquivo.tamanho();
+    if (tamanho_mapeamento_ < TAMANHO_CABECALHO_INDICE) {
+        throw std::ios_base::failure("Arquivo nao e um indice valido.");
+    }
+    mapeamento_ = ::mmap(nullptr, tamanho_mapeamento_, PROT_READ, MAP_PRIVATE,
+                         arquivo.descritor(), 0);
+    if (mapeamento_ == MAP_FAILED) {
+        throw std::ios_base::failure("Nao foi possivel mapear o indice.");
+    }
+
+    const unsigned char* base = static_cast<const unsigned char*>(mapeamento_);
+    std::uint32_t quantidade_arquivos = ler_u32(base + 12);
+    palavras_ = ler_u64(base + 16);
+    std::uint64_t bytes_nomes = ler_u64(base + 24);
+    bytes_listas_ = ler_u64(base + 32);
+    crc_ = ler_u32(base + 40);
+
+    std::uint64_t disponivel = tamanho_mapeamento_ - TAMANHO_CABECALHO_INDICE;
+    bool valido = std::memcmp(base, ASSINATURA_INDICE, sizeof(ASSINATURA_INDICE)) == 0 &&
+                  ler_u32(base + 8) == VERSAO_INDICE && bytes_nomes <= disponivel &&
+                  bytes_listas_ <= disponivel - bytes_nomes &&
+                  (disponivel - bytes_nomes - bytes_listas_) / 8 == palavras_ + 1 &&
+                  (disponivel - bytes_nomes - bytes_listas_) % 8 == 0;
+    if (valido) {
+        const unsigned char* cursor = base + TAMANHO_CABECALHO_INDICE;
+        const unsigned char* fim = cursor + bytes_nomes;
+        try {
+            for (std::uint32_t i = 0; valido && i < quantidade_arquivos; ++i) {
+                std::uint64_t tamanho = ler_varint(cursor, fim);
+                valido = tamanho <= static_cast<std::uint64_t>(fim - cursor);
+                if (valido) {
+                    arquivos_.emplace_back(reinterpret_cast<const char*>(cursor), tamanho);
+                    cursor += tamanho;
+                }
+            }
+        } catch (const std::ios_base::failure&) {
+            valido = false;
+        }
+        listas_ = fim;
+        tabela_ = listas_ + bytes_listas_;
+    }
+    if (!valido) {
+        ::munmap(mapeamento_, tamanho_mapeamento_);
+        throw std::ios_base::failure("Arquivo nao e um indice valido.");
+    }
+}
+
+IndicePosicoes::~IndicePosicoes() {
+    ::munmap(mapeamento_, tamanho_mapeamento_);
+}
+
+/**
+ * \brief Confere o CRC-32 de todo o conteúdo do índice.
+ *
+ * \return Verdadeiro se o conteúdo corresponde ao CRC-32 do cabeçalho.
+ */
+bool IndicePosicoes::verificar() const {
+    const unsigned char* base = static_cast<const unsigned char*>(mapeamento_);
+    uLong crc = crc32(0, Z_NULL, 0);
+    std::size_t restante = tamanho_mapeamento_ - TAMANHO_CABECALHO_INDICE;
+    const unsigned char* cursor = base + TAMANHO_CABECALHO_INDICE;
+    while (restante > 0) {
+        uInt parte = static_cast<uInt>(std::min<std::size_t>(restante, 1u << 30));
+        crc = crc32(crc, cursor, parte);
+        cursor += parte;
+        restante -= parte;
+    }
+    return static_cast<std::uint32_t>(crc) == crc_;
+}
+
+/**
+ * \brief Retorna as ocorrências da palavra em uma posição do vocabulário.
+ *
+ * \param posicao A posição da palavra no vocabulário.
+ * \return As ocorrências, em ordem de arquivo e de deslocamento.
+ * \throws std::out_of_range Se a posição não existir no índice.
+ * \throws std::ios_base::failure Se a lista estiver corrompida.
+ */
+std::vector<Ocorrencia> IndicePosicoes::ocorrencias(std::uint64_t posicao) const {
+    if (posicao >= palavras_) {
+        throw std::out_of_range("Posicao fora do indice.");
+    }
+    std::uint64_t inicio = ler_u64(tabela_ + 8 * posicao);
+    std::uint64_t fim_lista = ler_u64(tabela_ + 8 * (posicao + 1));
+    if (inicio > fim_lista || fim_lista > bytes_listas_) {
+        throw std::ios_base::failure("Arquivo binario corrompido.");
+    }
+    const unsigned char* cursor = listas_ + inicio;
+    const unsigned char* fim = listas_ + fim_lista;
+
+    std::uint64_t quantidade = ler_varint(cursor, fim);
+    std::vector<Ocorrencia> resultado;
+    resultado.reserve(static_cast<std::size_t>(
+        std::min<std::uint64_t>(quantidade, static_cast<std::uint64_t>(fim - cursor))));
+    Ocorrencia atual = {0, 0};
+    for (std::uint64_t i = 0; i < quantidade; ++i) {
+        std::uint64_t diferenca_arquivo = ler_varint(cursor, fim);
+        std::uint64_t deslocamento = ler_varint(cursor, fim);
+        if (i == 0 || diferenca_arquivo > 0) {
+            atual.deslocamento = deslocamento;
+        } else {
+            atual.deslocamento += deslocamento;
+        }
+        atual.arquivo += static_cast<std::uint32_t>(diferenca_arquivo);
+        resultado.push_back(atual);
+    }
+    return resultado;
+}
+
+/**
+ * \brief Retorna as ocorrências de uma palavra, localizando-a no vocabulário.
+ *
+ * \param vocabulario O instantâneo de vocabulário gravado junto com o índice.
+ * \param chave A palavra em UTF-8.
+ * \return As ocorrências, ou uma lista vazia se a palavra não estiver no vocabulário.
+ * \throws std::invalid_argument Se o vocabulário não corresponder ao índice.
+ */
+std::vector<Ocorrencia> IndicePosicoes::ocorrencias(const Vocabulario& vocabulario,
+                                                    const std::string& chave) const {
+    if (vocabulario.tamanho() != palavras_) {
+        throw std::invalid_argument("Vocabulario nao corresponde ao indice.");
+    }
+    Vocabulario::Iterador iterador = vocabulario.limite_inferior(chave);
+    if (!iterador.valido() || iterador.chave() != chave) {
+        return std::vector<Ocorrencia>();
+    }
+    return ocorrencias(iterador.posicao());
+}
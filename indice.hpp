@@ -0,0 +1,170 @@
+/**
+ * \file indice.hpp
+ * \brief Definições do índice invertido com as posições das palavras.
+ *
+ * Este arquivo contém as declarações do indexador, que registra durante a contagem o arquivo e o
+ * deslocamento de cada ocorrência de cada palavra, e do leitor do índice gravado em disco, que
+ * responde onde uma palavra ocorre sem reler os arquivos.
+ *
+ * O índice acompanha um instantâneo de vocabulário gravado junto com ele: a lista de ocorrências
+ * de uma palavra é localizada pela posição da palavra no vocabulário.
+ *
+ * Layout do arquivo (inteiros em little-endian):
+ * - Cabeçalho de 64 bytes: assinatura "CPINDEX1", versão, número de arquivos, número de palavras,
+ *   tamanho da seção de nomes, tamanho da seção de listas e CRC-32 das seções seguintes.
+ * - Nomes dos arquivos indexados: varint do tamanho seguido dos bytes do nome.
+ * - Listas de ocorrências, na ordem do vocabulário: varint do número de ocorrências e, para cada
+ *   ocorrência, varint da diferença de arquivo em relação à anterior e varint do deslocamento,
+ *   relativo à ocorrência anterior no mesmo arquivo ou absoluto no primeiro uso de um arquivo.
+ * - Tabela de listas: deslocamento de 64 bits, dentro da seção de listas, do início de cada lista,
+ *   com uma entrada a mais marcando o fim da última.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef INDICE_HPP_
+#define INDICE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "fluxo.hpp"
+#include "vocabulario.hpp"
+
+/**
+ * \brief Uma ocorrência de uma palavra.
+ */
+struct Ocorrencia {
+    std::uint32_t arquivo;       ///< Número do arquivo, na ordem em que foi indexado.
+    std::uint64_t deslocamento;  ///< Deslocamento do primeiro byte da palavra no arquivo (descomprimido).
+};
+
+/**
+ * \brief Indexador que conta as palavras e registra as posições das ocorrências.
+ *
+ * As listas de ocorrências são mantidas em memória já codificadas com diferenças e varint, de
+ * forma que cada ocorrência ocupa poucos bytes.
+ */
+class IndexadorPosicoes {
+ public:
+    /**
+     * \brief Cria um indexador vazio.
+     *
+     * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+     */
+    explicit IndexadorPosicoes(std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+    IndexadorPosicoes(const IndexadorPosicoes&) = delete;
+    IndexadorPosicoes& operator=(const IndexadorPosicoes&) = delete;
+
+    /**
+     * \brief Conta as palavras de um arquivo e registra as suas posições.
+     *
+     * \param nome_arquivo O nome do arquivo; arquivos compactados são descomprimidos e os
+     * deslocamentos referem-se ao conteúdo descomprimido.
+     * \return O número atribuído ao arquivo no índice.
+     * \throws std::ios_base::failure Se o arquivo não puder ser lido.
+     */
+    std::uint32_t adicionar_arquivo(const std::string& nome_arquivo);
+
+    /**
+     * \brief Retorna a contagem de todos os arquivos adicionados.
+     */
+    const std::map<std::wstring, int>& contagem() const { return contador_.contagem(); }
+
+    /**
+     * \brief Grava o instantâneo de vocabulário e o índice correspondente.
+     *
+     * \param nome_vocabulario O nome do instantâneo de vocabulário.
+     * \param nome_indice O nome do índice.
+     * \throws std::ios_base::failure Se algum dos arquivos não puder ser gravado.
+     */
+    void gravar(const std::string& nome_vocabulario, const std::string& nome_indice) const;
+
+ private:
+    /**
+     * \brief Lista de ocorrências de uma palavra, codificada à medida que cresce.
+     */
+    struct ListaOcorrencias {
+        std::uint64_t quantidade;
+        std::uint32_t arquivo;
+        std::uint64_t deslocamento;
+        std::string dados;
+    };
+
+    void registrar(const std::wstring& palavra, std::uint64_t deslocamento);
+
+    ContadorIncremental contador_;
+    std::map<std::wstring, ListaOcorrencias> listas_;
+    std::vector<std::string> arquivos_;
+    std::uint64_t inicio_arquivo_;
+};
+
+/**
+ * \brief Índice de posições mapeado na memória, somente para leitura.
+ */
+class IndicePosicoes {
+ public:
+    /**
+     * \brief Mapeia um índice na memória.
+     *
+     * \param nome_arquivo O nome do arquivo do índice.
+     * \throws std::ios_base::failure Se o arquivo não puder ser aberto ou não for um índice válido.
+     */
+    explicit IndicePosicoes(const std::string& nome_arquivo);
+    ~IndicePosicoes();
+
+    IndicePosicoes(const IndicePosicoes&) = delete;
+    IndicePosicoes& operator=(const IndicePosicoes&) = delete;
+
+    /**
+     * \brief Confere o CRC-32 de todo o conteúdo do índice.
+     *
+     * \return Verdadeiro se o conteúdo corresponde ao CRC-32 do cabeçalho.
+     */
+    bool verificar() const;
+
+    /**
+     * \brief Retorna os nomes dos arquivos indexados, na ordem dos seus números.
+     */
+    const std::vector<std::string>& arquivos() const { return arquivos_; }
+
+    /**
+     * \brief Retorna o número de palavras do índice, igual ao do vocabulário correspondente.
+     */
+    std::uint64_t tamanho() const { return palavras_; }
+
+    /**
+     * \brief Retorna as ocorrências da palavra em uma posição do vocabulário.
+     *
+     * \param posicao A posição da palavra no vocabulário (`Vocabulario::Iterador::posicao`).
+     * \return As ocorrências, em ordem de arquivo e de deslocamento.
+     * \throws std::out_of_range Se a posição não existir no índice.
+     */
+    std::vector<Ocorrencia> ocorrencias(std::uint64_t posicao) const;
+
+    /**
+     * \brief Retorna as ocorrências de uma palavra.
+     *
+     * \param vocabulario O instantâneo de vocabulário gravado junto com o índice.
+     * \param chave A palavra em UTF-8.
+     * \return As ocorrências, ou uma lista vazia se a palavra não estiver no vocabulário.
+     * \throws std::invalid_argument Se o vocabulário não corresponder ao índice.
+     */
+    std::vector<Ocorrencia> ocorrencias(const Vocabulario& vocabulario, const std::string& chave) const;
+
+ private:
+    void* mapeamento_;
+    std::size_t tamanho_mapeamento_;
+    const unsigned char* listas_;
+    const unsigned char* tabela_;
+    std::uint64_t palavras_;
+    std::uint64_t bytes_listas_;
+    std::uint32_t crc_;
+    std::vector<std::string> arquivos_;
+};
+
+#endif  // INDICE_HPP_
@@ -0,0 +1,578 @@
+/**
+ * \file main.cpp
+ * \brief Programa de linha de comando para contar as palavras de um arquivo ou da entrada padrão.
+ *
+ * Uso: `conta_palavras [opções] [arquivo]`. Sem arquivo, ou com `-` no lugar do arquivo, as
+ * palavras são lidas da entrada padrão em fluxo, o que permite alimentar o programa por um pipe
+ * (por exemplo, `zcat corpus.gz | ./conta_palavras`).
+ *
+ * Opções:
+ * - `--top K`: exibe apenas as K palavras mais frequentes.
+ * - `--follow`: acompanha o arquivo, exibindo a contagem atualizada sempre que ele crescer.
+ * - `--intervalo MS`: intervalo mínimo entre duas exibições no modo `--follow` (padrão: 1000).
+ * - `--gravar ARQ`: grava a contagem como instantâneo de vocabulário em ARQ.
+ * - `--vocabulario ARQ`: carrega a contagem de um instantâneo, sem ler nem contar o texto.
+ * - `--consulta PALAVRA`: exibe apenas a contagem de PALAVRA (pode ser repetida).
+ * - `--memoria MB`: limita a tabela de contagem a MB megabytes, descarregando contagens parciais em
+ *   arquivos temporários e intercalando-as no fim. A contagem completa é exibida na ordem do
+ *   instantâneo (bytes UTF-8), pois reordená-la sem acentos exigiria o vocabulário inteiro na memória.
+ * - `--indice ARQ`: ao contar arquivos (um ou mais) com `--gravar`, grava também um índice com as
+ *   posições das palavras; com `--vocabulario` e `--consulta`, exibe onde cada palavra ocorre.
+ * - `--servir SOCKET`: com `--vocabulario`, atende consultas pelo socket Unix SOCKET até receber
+ *   SIGINT ou SIGTERM.
+ * - `--conectar SOCKET`: envia `--consulta`, `--prefixo PREFIXO` ou `--top K` a um servidor.
+ * - `--prefixo PREFIXO`: exibe, em ordem, as palavras que começam com PREFIXO (no máximo K com `--top`).
+ *   Com `--vocabulario`, a trie usada na consulta é gravada ao lado do instantâneo (ARQ.trie) e
+ *   carregada nas consultas seguintes.
+ * - `--sem-acentos`: `--consulta` encontra também as formas da palavra com ou sem acentos.
+ * - `--cache DIR`: conta vários arquivos como um corpus, recontando apenas os que mudaram desde a
+ *   última execução com o mesmo DIR.
+ * - `--pontuacao remover|separar`: remove a pontuação do início e do fim das palavras ("teste." conta
+ *   como "teste") ou trata a pontuação como separador ("guarda-chuva" conta "guarda" e "chuva").
+ * - `--sem-numeros`: descarta as palavras sem nenhuma letra, como números e datas.
+ * - `--agrupar-acentos`: conta as palavras sem os acentos ("será" e "sera" contam juntas como "sera").
+ * - `--formas`: como `--agrupar-acentos`, mas exibe cada palavra na forma em que mais apareceu no texto
+ *   ("será", se for mais frequente que "sera"). Conta a entrada inteira, sem instantâneos nem consultas.
+ * - `--forma-normal nfc|nfd`: converte cada palavra para a forma normal NFC ou NFD do Unicode antes da
+ *   contagem ("é" pré-composto e "e" seguido do acento combinante contam juntos).
+ * - `--sem-palavras-vazias`: não conta as palavras vazias do português ("de", "que", "o", "é"...).
+ * - `--palavras-vazias ARQ`: como `--sem-palavras-vazias`, com a lista lida de ARQ (uma palavra por linha).
+ * - `--radicais`: conta os radicais do português (RSLP) em vez das palavras ("gatinhos" e "gato" contam
+ *   juntos como "gat"). Conta a entrada inteira, sem instantâneos nem consultas.
+ * - `--ngramas N`: conta as sequências de N palavras consecutivas (2 ou 3) em vez das palavras, com a
+ *   mesma ordem e o mesmo `--top` das palavras. Conta a entrada inteira, sem instantâneos nem consultas.
+ * - `--uax29`: delimita as palavras pelas fronteiras do UAX #29 em vez de apenas pelos espaços
+ *   ("d'água" e "3,5" continuam uma palavra; aspas e parênteses em volta não são contados).
+ * - `--stats`: ao sair, exibe na saída de erros, em JSON, o tempo de relógio e de CPU, os bytes, as
+ *   palavras e as alocações de cada etapa, as buscas na tabela de contagem e, com `--ngramas`, as
+ *   posições examinadas pelas sondagens das tabelas de dispersão.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ios>
+#include <iostream>
+#include <locale>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "acompanhamento.hpp"
+#include "agregacao.hpp"
+#include "conta_palavras.hpp"
+#include "corpus.hpp"
+#include "estatisticas.hpp"
+#include "fluxo.hpp"
+#include "formas.hpp"
+#include "indice.hpp"
+#include "ngramas.hpp"
+#include "palavras_vazias.hpp"
+#include "radicais.hpp"
+#include "servidor.hpp"
+#include "trie.hpp"
+#include "vocabulario.hpp"
+
+/**
+ * \brief Exibe a forma de uso do programa na saída de erros.
+ */
+static void exibir_uso() {
+    std::cerr << "Uso: conta_palavras [--top K] [--follow] [--intervalo MS] [--gravar ARQ] [--memoria MB]\n"
+                 "                      [--vocabulario ARQ] [--consulta PALAVRA]... [--indice ARQ] [--prefixo PREFIXO]\n"
+                 "                      [--sem-acentos] [--pontuacao remover|separar] [--sem-numeros] [--uax29]\n"
+                 "                      [--agrupar-acentos] [--formas] [--forma-normal nfc|nfd] [--stats]\n"
+                 "                      [--sem-palavras-vazias] [--palavras-vazias ARQ] [--radicais] [--ngramas N]\n"
+                 "                      [arquivo | -]\n"
+                 "       conta_palavras --cache DIR [opcoes] arquivo...\n"
+                 "       conta_palavras --gravar ARQ --indice ARQ [opcoes] arquivo...\n"
+                 "       conta_palavras --vocabulario ARQ --servir SOCKET\n"
+                 "       conta_palavras --conectar SOCKET [--consulta PALAVRA | --prefixo PREFIXO | --top K]"
+              << std::endl;
+}
+
+/**
+ * \brief Cria um arquivo temporário vazio em `TMPDIR` (ou `/tmp`) e retorna o seu nome.
+ *
+ * \throws std::ios_base::failure Se o arquivo não puder ser criado.
+ */
+static std::string criar_temporario() {
+    const char* diretorio = std::getenv("TMPDIR");
+    std::string modelo = std::string(diretorio != nullptr && *diretorio != '\0' ? diretorio : "/tmp") +
+                         "/conta_palavras.XXXXXX";
+    int descritor = ::mkstemp(&modelo[0]);
+    if (descritor < 0) {
+        throw std::ios_base::failure("Nao foi possivel criar o arquivo temporario.");
+    }
+    ::close(descritor);
+    return modelo;
+}
+
+/**
+ * \brief Exibe a contagem a partir de um instantâneo, sem carregá-lo inteiro na memória.
+ *
+ * \param instantaneo O instantâneo de vocabulário.
+ * \param consultas As palavras a consultar; se vazia, exibe a contagem completa ou as mais frequentes.
+ * \param top_k O número de palavras mais frequentes a exibir; zero exibe todas, na ordem do
+ * instantâneo (bytes UTF-8), e não na ordem sem acentos de `imprimir_contagem`.
+ */
+static void exibir_instantaneo(const Vocabulario& instantaneo, const std::vector<std::string>& consultas,
+                               std::size_t top_k) {
+    if (!consultas.empty()) {
+        for (const auto& consulta : consultas) {
+            std::wcout << de_utf8(consulta) << L": " << instantaneo.contagem(instantaneo.chave_consulta(consulta))
+                       << L'\n';
+        }
+    } else if (top_k > 0) {
+        for (const auto& par : mais_frequentes(instantaneo, top_k)) {
+            std::wcout << de_utf8(par.first) << L": " << par.second << L'\n';
+        }
+    } else {
+        for (Vocabulario::Iterador iterador = instantaneo.inicio(); iterador.valido(); iterador.avancar()) {
+            std::wcout << de_utf8(iterador.chave()) << L": " << iterador.contagem() << L'\n';
+        }
+    }
+    std::wcout.flush();
+}
+
+/**
+ * \brief Exibe as buscas sem acentos e as palavras com um prefixo, percorrendo a trie compacta.
+ *
+ * \param trie A trie do vocabulário.
+ * \param consultas As palavras a buscar ignorando os acentos.
+ * \param prefixo O prefixo a consultar, se não for vazio.
+ * \param top_k O número máximo de palavras com o prefixo; zero não limita.
+ * \param configuracao A configuração com que as palavras foram contadas, usada para normalizar as
+ * consultas e o prefixo como as chaves.
+ */
+static void exibir_trie(const TrieCompacta& trie, const std::vector<std::string>& consultas,
+                        const std::string& prefixo, std::size_t top_k, std::uint32_t configuracao) {
+    TrieCompacta::Resultados resultados;
+    for (const auto& consulta : consultas) {
+        TrieCompacta::Resultados encontradas =
+            trie.buscar_sem_acentos(normalizar_consulta(de_utf8(consulta), configuracao));
+        resultados.insert(resultados.end(), encontradas.begin(), encontradas.end());
+    }
+    if (!prefixo.empty()) {
+        TrieCompacta::Resultados encontradas =
+            trie.prefixo(para_utf8(normalizar_consulta(de_utf8(prefixo), configuracao)), top_k);
+        resultados.insert(resultados.end(), encontradas.begin(), encontradas.end());
+    }
+    for (const auto& par : resultados) {
+        std::wcout << de_utf8(par.first) << L": " << par.second << L'\n';
+    }
+    std::wcout.flush();
+}
+
+/**
+ * \brief Servidor em execução, parado pelos sinais de término.
+ */
+static ServidorConsultas* servidor_ativo = nullptr;
+
+/**
+ * \brief Trata SIGINT e SIGTERM pedindo que o servidor pare.
+ */
+static void tratar_termino(int) {
+    if (servidor_ativo != nullptr) {
+        servidor_ativo->parar();
+    }
+}
+
+/**
+ * \brief Envia as consultas a um servidor e exibe as respostas.
+ *
+ * \param caminho O caminho do socket do servidor.
+ * \param consultas As palavras cuja contagem deve ser consultada.
+ * \param prefixo O prefixo a consultar, se não for vazio.
+ * \param top_k O número de palavras mais frequentes a consultar, se não for zero.
+ */
+static void consultar_servidor(const std::string& caminho, const std::vector<std::string>& consultas,
+                               const std::string& prefixo, std::size_t top_k) {
+    ClienteConsultas cliente(caminho);
+    for (const auto& consulta : consultas) {
+        std::cout << consulta << ": " << cliente.contagem(consulta) << '\n';
+    }
+    if (!prefixo.empty()) {
+        for (const auto& par : cliente.prefixo(prefixo, top_k > 0 ? top_k : UINT32_MAX)) {
+            std::cout << par.first << ": " << par.second << '\n';
+        }
+    } else if (top_k > 0) {
+        for (const auto& par : cliente.mais_frequentes(top_k)) {
+            std::cout << par.first << ": " << par.second << '\n';
+        }
+    }
+    std::cout.flush();
+}
+
+/**
+ * \brief Exibe o relatório de estatísticas quando `main` retorna, por qualquer caminho.
+ */
+struct RelatorioEstatisticas {
+    bool ativo = false;
+    ~RelatorioEstatisticas() {
+        if (ativo) {
+            imprimir_estatisticas(std::cerr);
+        }
+    }
+};
+
+/**
+ * \brief Função principal do programa.
+ *
+ * \param argc O número de argumentos.
+ * \param argv Os argumentos da linha de comando.
+ * \return Zero em caso de sucesso, um em caso de erro.
+ */
+int main(int argc, char* argv[]) {
+    try {
+        std::locale::global(std::locale(""));
+    } catch (const std::runtime_error&) {
+        // Localidade do ambiente inválida: mantém a localidade "C"
+    }
+
+    bool acompanhar = false;
+    int intervalo_ms = 1000;
+    std::size_t top_k = 0;
+    std::size_t memoria_mb = 0;
+    std::string entrada = "-";
+    std::string gravar;
+    std::string vocabulario;
+    std::string cache;
+    std::string indice;
+    std::string servir;
+    std::string conectar;
+    std::string prefixo;
+    std::string lista_vazias;
+    bool sem_acentos = false;
+    bool formas = false;
+    bool radicais = false;
+    std::size_t ngramas = 0;
+    bool estatisticas = false;
+    std::uint32_t configuracao = CONFIGURACAO_PADRAO;
+    std::vector<std::string> arquivos;
+    std::vector<std::string> consultas;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string argumento = argv[i];
+            if (argumento == "--follow") {
+                acompanhar = true;
+            } else if (argumento == "--sem-acentos") {
+                sem_acentos = true;
+            } else if (argumento == "--sem-numeros") {
+                configuracao |= TOKENIZADOR_IGNORAR_NUMEROS;
+            } else if (argumento == "--agrupar-acentos") {
+                configuracao |= TOKENIZADOR_SEM_ACENTOS;
+            } else if (argumento == "--formas") {
+                formas = true;
+                configuracao |= TOKENIZADOR_SEM_ACENTOS;
+            } else if (argumento == "--sem-palavras-vazias") {
+                configuracao |= TOKENIZADOR_SEM_PALAVRAS_VAZIAS;
+            } else if (argumento == "--palavras-vazias" && i + 1 < argc) {
+                lista_vazias = argv[++i];
+                configuracao |= TOKENIZADOR_SEM_PALAVRAS_VAZIAS;
+            } else if (argumento == "--ngramas" && i + 1 < argc) {
+                ngramas = std::stoul(argv[++i]);
+                if (ngramas < 2 || ngramas > MAXIMO_NGRAMA) {
+                    exibir_uso();
+                    return 1;
+                }
+            } else if (argumento == "--radicais") {
+                radicais = true;
+            } else if (argumento == "--uax29") {
+                configuracao |= TOKENIZADOR_UAX29;
+            } else if (argumento == "--pontuacao" && i + 1 < argc) {
+                std::string modo = argv[++i];
+                if (modo == "remover") {
+                    configuracao |= TOKENIZADOR_REMOVER_PONTUACAO;
+                } else if (modo == "separar") {
+                    configuracao |= TOKENIZADOR_SEPARAR_PONTUACAO;
+                } else {
+                    exibir_uso();
+                    return 1;
+                }
+            } else if (argumento == "--forma-normal" && i + 1 < argc) {
+                std::string forma = argv[++i];
+                configuracao &= ~static_cast<std::uint32_t>(TOKENIZADOR_NFC | TOKENIZADOR_NFD);
+                if (forma == "nfc") {
+                    configuracao |= TOKENIZADOR_NFC;
+                } else if (forma == "nfd") {
+                    configuracao |= TOKENIZADOR_NFD;
+                } else {
+                    exibir_uso();
+                    return 1;
+                }
+            } else if (argumento == "--stats") {
+                estatisticas = estatisticas_disponiveis();
+                if (!estatisticas) {
+                    std::cerr << "O programa foi compilado sem estatisticas." << std::endl;
+                }
+            } else if (argumento == "--top" && i + 1 < argc) {
+                top_k = std::stoul(argv[++i]);
+            } else if (argumento == "--intervalo" && i + 1 < argc) {
+                intervalo_ms = std::stoi(argv[++i]);
+                if (intervalo_ms <= 0) {
+                    exibir_uso();
+                    return 1;
+                }
+            } else if (argumento == "--gravar" && i + 1 < argc) {
+                gravar = argv[++i];
+            } else if (argumento == "--vocabulario" && i + 1 < argc) {
+                vocabulario = argv[++i];
+            } else if (argumento == "--consulta" && i + 1 < argc) {
+                consultas.push_back(argv[++i]);
+            } else if (argumento == "--memoria" && i + 1 < argc) {
+                memoria_mb = std::stoul(argv[++i]);
+            } else if (argumento == "--servir" && i + 1 < argc) {
+                servir = argv[++i];
+            } else if (argumento == "--conectar" && i + 1 < argc) {
+                conectar = argv[++i];
+            } else if (argumento == "--prefixo" && i + 1 < argc) {
+                prefixo = argv[++i];
+            } else if (argumento == "--indice" && i + 1 < argc) {
+                indice = argv[++i];
+            } else if (argumento == "--cache" && i + 1 < argc) {
+                cache = argv[++i];
+            } else if (argumento.size() > 1 && argumento[0] == '-') {
+                exibir_uso();
+                return 1;
+            } else {
+                entrada = argumento;
+                arquivos.push_back(argumento);
+            }
+        }
+    } catch (const std::logic_error&) {
+        exibir_uso();
+        return 1;
+    }
+    if (arquivos.size() > 1 && cache.empty() && indice.empty()) {
+        // Só o corpus e o índice contam vários arquivos; nos outros modos, os anteriores seriam ignorados
+        exibir_uso();
+        return 1;
+    }
+    RelatorioEstatisticas relatorio;
+    relatorio.ativo = estatisticas;
+    ativar_estatisticas(estatisticas);
+
+    try {
+        if (!lista_vazias.empty()) {
+            definir_palavras_vazias(ler_palavras_vazias(lista_vazias));
+        }
+        if (formas) {
+            if (radicais || ngramas > 0 || acompanhar || memoria_mb > 0 || !gravar.empty() || !vocabulario.empty() ||
+                !cache.empty() || !indice.empty() || !servir.empty() || !conectar.empty() || !consultas.empty() ||
+                !prefixo.empty()) {
+                std::cerr << "A opcao --formas so pode ser usada com --top e com as opcoes de contagem." << std::endl;
+                return 1;
+            }
+            // A contagem agrupada já sai na ordem sem acentos, com as formas mais frequentes
+            int descritor = STDIN_FILENO;
+            std::unique_ptr<Arquivo> arquivo;
+            if (entrada != "-") {
+                arquivo.reset(new Arquivo(abrir_arquivo(entrada)));
+                descritor = arquivo->descritor();
+            }
+            ContagemFormas contagem = contar_formas_fluxo(descritor, configuracao);
+            if (top_k > 0) {
+                for (const auto& par : mais_frequentes(contagem, top_k)) {
+                    std::wcout << par.first << L": " << par.second << L'\n';
+                }
+                std::wcout.flush();
+            } else {
+                imprimir_contagem(contagem);
+            }
+            return 0;
+        }
+
+        if (radicais) {
+            if (ngramas > 0 || acompanhar || memoria_mb > 0 || !gravar.empty() || !vocabulario.empty() ||
+                !cache.empty() || !indice.empty() || !servir.empty() || !conectar.empty() || !consultas.empty() ||
+                !prefixo.empty()) {
+                std::cerr << "A opcao --radicais so pode ser usada com --top e com as opcoes de contagem." << std::endl;
+                return 1;
+            }
+            // Os radicais são extraídos uma vez por palavra distinta, depois da contagem
+            std::map<std::wstring, int> contagem = entrada == "-" ? contar_palavras_fluxo(STDIN_FILENO, configuracao)
+                                                                  : contar_palavras_arquivo(entrada, configuracao);
+            contagem = contar_radicais(contagem, configuracao);
+            if (top_k > 0) {
+                imprimir_mais_frequentes(contagem, top_k);
+            } else {
+                imprimir_contagem(contagem, configuracao);
+            }
+            return 0;
+        }
+
+        if (ngramas > 0) {
+            if (acompanhar || memoria_mb > 0 || !gravar.empty() || !vocabulario.empty() || !cache.empty() ||
+                !indice.empty() || !servir.empty() || !conectar.empty() || !consultas.empty() || !prefixo.empty()) {
+                std::cerr << "A opcao --ngramas so pode ser usada com --top e com as opcoes de contagem." << std::endl;
+                return 1;
+            }
+            int descritor = STDIN_FILENO;
+            std::unique_ptr<Arquivo> arquivo;
+            if (entrada != "-") {
+                arquivo.reset(new Arquivo(abrir_arquivo(entrada)));
+                descritor = arquivo->descritor();
+            }
+            ContagemNgramas contagem = contar_ngramas_fluxo(descritor, ngramas, configuracao);
+            if (top_k > 0) {
+                // Só os n-gramas selecionados são montados como texto
+                for (const auto& par : contagem.mais_frequentes(top_k)) {
+                    std::wcout << par.first << L": " << par.second << L'\n';
+                }
+                std::wcout.flush();
+            } else {
+                imprimir_contagem(contagem.para_mapa(), configuracao);
+            }
+            return 0;
+        }
+
+        if (acompanhar) {
+            if (entrada == "-") {
+                std::cerr << "O modo --follow precisa de um arquivo." << std::endl;
+                return 1;
+            }
+            acompanhar_arquivo(entrada, intervalo_ms, top_k, configuracao);
+        }
+
+        if (!cache.empty()) {
+            // O corpus vira um instantâneo global, consultado como um --vocabulario
+            vocabulario = cache + "/corpus.voc";
+            ResultadoCorpus resultado = atualizar_corpus(arquivos, cache, vocabulario, configuracao);
+            std::cerr << resultado.recontados << " recontados, " << resultado.reaproveitados
+                      << " reaproveitados, " << resultado.removidos << " removidos" << std::endl;
+        }
+
+        if (!conectar.empty()) {
+            consultar_servidor(conectar, consultas, prefixo, top_k);
+            return 0;
+        }
+
+        if (!servir.empty()) {
+            if (vocabulario.empty()) {
+                std::cerr << "A opcao --servir precisa de --vocabulario." << std::endl;
+                return 1;
+            }
+            ServidorConsultas servidor(vocabulario, servir);
+            servidor_ativo = &servidor;
+            ::signal(SIGINT, tratar_termino);
+            ::signal(SIGTERM, tratar_termino);
+            servidor.executar();
+            servidor_ativo = nullptr;
+            return 0;
+        }
+
+        if (!indice.empty() && !vocabulario.empty()) {
+            // Ocorrências vêm do índice, sem reler os arquivos
+            Vocabulario instantaneo(vocabulario);
+            IndicePosicoes posicoes(indice);
+            for (const auto& consulta : consultas) {
+                for (const auto& ocorrencia : posicoes.ocorrencias(instantaneo, instantaneo.chave_consulta(consulta))) {
+                    std::cout << posicoes.arquivos()[ocorrencia.arquivo] << ':' << ocorrencia.deslocamento
+                              << ": " << consulta << '\n';
+                }
+            }
+            std::cout.flush();
+            return 0;
+        }
+
+        if (!indice.empty()) {
+            if (gravar.empty() || arquivos.empty()) {
+                std::cerr << "A opcao --indice precisa de --gravar e de arquivos." << std::endl;
+                return 1;
+            }
+            IndexadorPosicoes indexador(configuracao);
+            for (const auto& arquivo : arquivos) {
+                indexador.adicionar_arquivo(arquivo);
+            }
+            indexador.gravar(gravar, indice);
+            if (top_k > 0) {
+                imprimir_mais_frequentes(indexador.contagem(), top_k);
+            } else {
+                imprimir_contagem(indexador.contagem(), configuracao);
+            }
+            return 0;
+        }
+
+        if (memoria_mb > 0 && vocabulario.empty()) {
+            // O resultado só existe como instantâneo: sem --gravar, usa um arquivo temporário
+            std::string destino = gravar;
+            if (destino.empty()) {
+                destino = criar_temporario();
+            }
+            try {
+                int descritor = STDIN_FILENO;
+                std::unique_ptr<Arquivo> arquivo;
+                if (entrada != "-") {
+                    arquivo.reset(new Arquivo(abrir_arquivo(entrada)));
+                    descritor = arquivo->descritor();
+                }
+                contar_palavras_limitado(descritor, memoria_mb << 20, destino, configuracao);
+                exibir_instantaneo(Vocabulario(destino), consultas, top_k);
+            } catch (...) {
+                if (gravar.empty()) {
+                    std::remove(destino.c_str());
+                }
+                throw;
+            }
+            if (gravar.empty()) {
+                std::remove(destino.c_str());
+            }
+            return 0;
+        }
+
+        if (!vocabulario.empty() && gravar.empty() && prefixo.empty() && !sem_acentos &&
+            (!consultas.empty() || top_k > 0)) {
+            // Consultas e mais frequentes leem o instantâneo diretamente, sem convertê-lo para um mapa
+            exibir_instantaneo(Vocabulario(vocabulario), consultas, top_k);
+            return 0;
+        }
+
+        if (!vocabulario.empty() && gravar.empty() && (!prefixo.empty() || (sem_acentos && !consultas.empty()))) {
+            // A trie é gravada ao lado do instantâneo na primeira consulta e carregada nas seguintes
+            Vocabulario instantaneo(vocabulario);
+            exibir_trie(carregar_trie(instantaneo, vocabulario), consultas, prefixo, top_k,
+                        instantaneo.configuracao());
+            return 0;
+        }
+
+        std::map<std::wstring, int> contagem;
+        if (!vocabulario.empty()) {
+            Vocabulario instantaneo(vocabulario);
+            contagem = instantaneo.para_mapa();
+            configuracao = instantaneo.configuracao();
+        } else if (entrada == "-") {
+            contagem = contar_palavras_fluxo(STDIN_FILENO, configuracao);
+        } else {
+            contagem = contar_palavras_arquivo(entrada, configuracao);
+        }
+        if (!gravar.empty()) {
+            gravar_vocabulario(contagem, gravar, configuracao);
+        }
+
+        if (!prefixo.empty() || (sem_acentos && !consultas.empty())) {
+            // Prefixos e buscas sem acentos percorrem a trie compacta do vocabulário
+            exibir_trie(TrieCompacta(contagem), consultas, prefixo, top_k, configuracao);
+        } else if (!consultas.empty()) {
+            for (const auto& consulta : consultas) {
+                auto encontrada = contagem.find(normalizar_consulta(de_utf8(consulta), configuracao));
+                std::wcout << de_utf8(consulta) << L": " << (encontrada == contagem.end() ? 0 : encontrada->second)
+                           << L'\n';
+            }
+        } else if (top_k > 0) {
+            imprimir_mais_frequentes(contagem, top_k);
+        } else {
+            imprimir_contagem(contagem, configuracao);
+        }
+    } catch (const std::exception& erro) {
+        std::cerr << erro.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
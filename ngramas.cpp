@@ -0,0 +1,391 @@
+/**
+ * \file ngramas.cpp
+ * \brief Implementação da contagem de n-gramas sobre identificadores de palavras.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "ngramas.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "estatisticas.hpp"
+#include "fluxo.hpp"
+#include "palavras_vazias.hpp"
+
+namespace {
+
+/**
+ * \brief Base do hash polinomial das janelas.
+ */
+const std::uint64_t BASE_HASH_NGRAMA = 0x100000001B3ull;
+
+/**
+ * \brief Número de posições da tabela na primeira inserção.
+ */
+const std::size_t POSICOES_INICIAIS_NGRAMAS = 1024;
+
+/**
+ * \brief Número de posições da tabela de identificadores na primeira palavra.
+ */
+const std::size_t IDENTIFICADORES_INICIAIS = 256;
+
+/**
+ * \brief Calcula o hash FNV-1a dos caracteres de uma palavra.
+ */
+inline std::uint32_t hash_palavra(const wchar_t* inicio, const wchar_t* fim) {
+    std::uint32_t hash = 2166136261u;
+    for (; inicio != fim; ++inicio) {
+        hash = (hash ^ static_cast<std::uint32_t>(*inicio)) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * \brief Espalha os bits do hash polinomial antes de escolher a posição na tabela.
+ */
+inline std::uint64_t misturar_hash(std::uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    return hash ^ (hash >> 33);
+}
+
+/**
+ * \brief Retorna quantas posições a sondagem linear examinou para chegar a uma posição.
+ */
+inline std::uint64_t comprimento_sondagem(std::size_t posicao, std::uint64_t hash, std::size_t mascara) {
+    return ((posicao - (static_cast<std::size_t>(misturar_hash(hash)) & mascara)) & mascara) + 1;
+}
+
+}  // namespace
+
+/**
+ * \brief Cria uma contagem vazia.
+ *
+ * \param n O número de palavras de cada n-grama, de 2 a `MAXIMO_NGRAMA`.
+ * \throws std::invalid_argument Se `n` estiver fora do intervalo.
+ */
+ContagemNgramas::ContagemNgramas(std::size_t n)
+    : n_(n), ocupadas_(0), total_(0), buscas_(0), sondagens_(0), janela_(), na_janela_(0), hash_(0), peso_saida_(1) {
+    if (n < 2 || n > MAXIMO_NGRAMA) {
+        throw std::invalid_argument("Tamanho de n-grama invalido.");
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        peso_saida_ *= BASE_HASH_NGRAMA;
+    }
+}
+
+/**
+ * \brief Acrescenta a próxima palavra do texto, contando o n-grama que ela completa.
+ *
+ * Com a janela cheia, a palavra mais antiga sai do hash subtraindo-se o seu termo, de peso
+ * `BASE_HASH_NGRAMA` elevado a `n - 1`, e a nova entra como o termo de peso um.
+ *
+ * \param palavra A palavra, já normalizada como chave.
+ */
+void ContagemNgramas::adicionar(const std::wstring& palavra) {
+    std::uint32_t identificador = identificar(palavra);
+    if (na_janela_ == n_) {
+        hash_ -= (janela_[0] + 1ull) * peso_saida_;
+        std::copy(janela_ + 1, janela_ + n_, janela_);
+        --na_janela_;
+    }
+    janela_[na_janela_++] = identificador;
+    hash_ = hash_ * BASE_HASH_NGRAMA + identificador + 1;
+    if (na_janela_ == n_) {
+        contar_janela();
+    }
+}
+
+/**
+ * \brief Esvazia a janela.
+ */
+void ContagemNgramas::interromper() {
+    na_janela_ = 0;
+    hash_ = 0;
+}
+
+/**
+ * \brief Retorna quantas vezes um n-grama foi contado.
+ *
+ * \param ngrama As palavras do n-grama, separadas por um espaço.
+ */
+int ContagemNgramas::contagem(const std::wstring& ngrama) const {
+    std::uint32_t palavras[MAXIMO_NGRAMA];
+    std::size_t quantidade = 0;
+    std::size_t inicio = 0;
+    if (identificadores_.empty()) {
+        return 0;
+    }
+    while (inicio <= ngrama.size()) {
+        std::size_t fim = std::min(ngrama.find(L' ', inicio), ngrama.size());
+        const wchar_t* dados = ngrama.data();
+        const Identificador& encontrada =
+            identificadores_[procurar_palavra(dados + inicio, dados + fim, hash_palavra(dados + inicio, dados + fim))];
+        if (quantidade == n_ || encontrada.indice == 0) {
+            return 0;
+        }
+        palavras[quantidade++] = encontrada.indice - 1;
+        inicio = fim + 1;
+    }
+    if (quantidade != n_ || tabela_.empty()) {
+        return 0;
+    }
+    return tabela_[procurar(palavras, hash_tupla(palavras))].contagem;
+}
+
+/**
+ * \brief Converte a contagem para um mapa de n-gramas.
+ */
+std::map<std::wstring, int> ContagemNgramas::para_mapa() const {
+    std::map<std::wstring, int> mapa;
+    for (const Entrada& entrada : tabela_) {
+        if (entrada.contagem != 0) {
+            mapa.emplace(texto(entrada), entrada.contagem);
+        }
+    }
+    return mapa;
+}
+
+/**
+ * \brief Seleciona os n-gramas mais frequentes.
+ *
+ * Os empates são desfeitos comparando as palavras uma a uma, o que dá a mesma ordem das strings
+ * com as palavras separadas por espaços, sem montá-las.
+ *
+ * \param k O número de n-gramas desejado; zero seleciona todos.
+ * \return Um vetor de pares (n-grama, contagem), em ordem decrescente de contagem.
+ */
+std::vector<std::pair<std::wstring, int>> ContagemNgramas::mais_frequentes(std::size_t k) const {
+    std::vector<const Entrada*> entradas;
+    entradas.reserve(ocupadas_);
+    for (const Entrada& entrada : tabela_) {
+        if (entrada.contagem != 0) {
+            entradas.push_back(&entrada);
+        }
+    }
+    if (k == 0 || k > entradas.size()) {
+        k = entradas.size();
+    }
+
+    std::partial_sort(entradas.begin(), entradas.begin() + k, entradas.end(),
+                      [this](const Entrada* a, const Entrada* b) {
+                          if (a->contagem != b->contagem) {
+                              return a->contagem > b->contagem;
+                          }
+                          for (std::size_t i = 0; i < n_; ++i) {
+                              if (a->palavras[i] != b->palavras[i]) {
+                                  return palavras_[a->palavras[i]] < palavras_[b->palavras[i]];
+                              }
+                          }
+                          return false;
+                      });
+
+    std::vector<std::pair<std::wstring, int>> resultado;
+    resultado.reserve(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        resultado.emplace_back(texto(*entradas[i]), entradas[i]->contagem);
+    }
+    return resultado;
+}
+
+/**
+ * \brief Retorna o identificador de uma palavra, atribuindo o próximo se ela for nova.
+ */
+std::uint32_t ContagemNgramas::identificar(const std::wstring& palavra) {
+    if (2 * (palavras_.size() + 1) > identificadores_.size()) {
+        crescer_identificadores();
+    }
+    const wchar_t* inicio = palavra.data();
+    const wchar_t* fim = inicio + palavra.size();
+    std::uint32_t hash = hash_palavra(inicio, fim);
+    std::size_t encontrada = procurar_palavra(inicio, fim, hash);
+    ++buscas_;
+    sondagens_ += comprimento_sondagem(encontrada, hash, identificadores_.size() - 1);
+    Identificador& posicao = identificadores_[encontrada];
+    if (posicao.indice == 0) {
+        palavras_.push_back(palavra);
+        posicao.hash = hash;
+        posicao.indice = static_cast<std::uint32_t>(palavras_.size());
+    }
+    return posicao.indice - 1;
+}
+
+/**
+ * \brief Procura uma palavra na tabela de identificadores por sondagem linear.
+ *
+ * \param inicio O primeiro caractere da palavra.
+ * \param fim O caractere seguinte ao último.
+ * \param hash O hash da palavra.
+ * \return A posição da palavra, ou a posição vazia onde ela deve ser inserida.
+ */
+std::size_t ContagemNgramas::procurar_palavra(const wchar_t* inicio, const wchar_t* fim, std::uint32_t hash) const {
+    const std::size_t mascara = identificadores_.size() - 1;
+    const std::size_t tamanho = static_cast<std::size_t>(fim - inicio);
+    std::size_t posicao = static_cast<std::size_t>(misturar_hash(hash)) & mascara;
+    while (identificadores_[posicao].indice != 0) {
+        const Identificador& atual = identificadores_[posicao];
+        if (atual.hash == hash) {
+            const std::wstring& palavra = palavras_[atual.indice - 1];
+            if (palavra.size() == tamanho && std::equal(inicio, fim, palavra.data())) {
+                break;
+            }
+        }
+        posicao = (posicao + 1) & mascara;
+    }
+    return posicao;
+}
+
+/**
+ * \brief Dobra a tabela de identificadores, reinserindo as palavras pelo hash guardado.
+ */
+void ContagemNgramas::crescer_identificadores() {
+    std::vector<Identificador> anterior(std::max(IDENTIFICADORES_INICIAIS, 2 * identificadores_.size()),
+                                        Identificador());
+    anterior.swap(identificadores_);
+    const std::size_t mascara = identificadores_.size() - 1;
+    for (const Identificador& identificador : anterior) {
+        if (identificador.indice != 0) {
+            std::size_t posicao = static_cast<std::size_t>(misturar_hash(identificador.hash)) & mascara;
+            while (identificadores_[posicao].indice != 0) {
+                posicao = (posicao + 1) & mascara;
+            }
+            identificadores_[posicao] = identificador;
+        }
+    }
+}
+
+/**
+ * \brief Calcula o hash polinomial de uma tupla, o mesmo mantido para a janela por `adicionar`.
+ */
+std::uint64_t ContagemNgramas::hash_tupla(const std::uint32_t* palavras) const {
+    std::uint64_t hash = 0;
+    for (std::size_t i = 0; i < n_; ++i) {
+        hash = hash * BASE_HASH_NGRAMA + palavras[i] + 1;
+    }
+    return hash;
+}
+
+/**
+ * \brief Procura uma tupla na tabela por sondagem linear.
+ *
+ * \param palavras Os identificadores da tupla.
+ * \param hash O hash polinomial da tupla.
+ * \return A posição da tupla, ou a posição vazia onde ela deve ser inserida.
+ */
+std::size_t ContagemNgramas::procurar(const std::uint32_t* palavras, std::uint64_t hash) const {
+    const std::size_t mascara = tabela_.size() - 1;
+    std::size_t posicao = static_cast<std::size_t>(misturar_hash(hash)) & mascara;
+    while (tabela_[posicao].contagem != 0 && !std::equal(palavras, palavras + n_, tabela_[posicao].palavras)) {
+        posicao = (posicao + 1) & mascara;
+    }
+    return posicao;
+}
+
+/**
+ * \brief Conta o n-grama da janela cheia.
+ *
+ * A tabela é mantida no máximo meio cheia, de forma que as sondagens são curtas.
+ */
+void ContagemNgramas::contar_janela() {
+    if (2 * (ocupadas_ + 1) > tabela_.size()) {
+        crescer();
+    }
+    ++total_;
+    std::size_t posicao = procurar(janela_, hash_);
+    ++buscas_;
+    sondagens_ += comprimento_sondagem(posicao, hash_, tabela_.size() - 1);
+    Entrada& entrada = tabela_[posicao];
+    if (entrada.contagem == 0) {
+        std::copy(janela_, janela_ + n_, entrada.palavras);
+        ++ocupadas_;
+    }
+    ++entrada.contagem;
+}
+
+/**
+ * \brief Dobra a tabela, reinserindo as tuplas pelo seu hash.
+ */
+void ContagemNgramas::crescer() {
+    std::vector<Entrada> anterior(std::max(POSICOES_INICIAIS_NGRAMAS, 2 * tabela_.size()), Entrada());
+    anterior.swap(tabela_);
+    for (const Entrada& entrada : anterior) {
+        if (entrada.contagem != 0) {
+            tabela_[procurar(entrada.palavras, hash_tupla(entrada.palavras))] = entrada;
+        }
+    }
+}
+
+/**
+ * \brief Reconstitui o texto de um n-grama, com as palavras separadas por um espaço.
+ */
+std::wstring ContagemNgramas::texto(const Entrada& entrada) const {
+    std::wstring resultado = palavras_[entrada.palavras[0]];
+    for (std::size_t i = 1; i < n_; ++i) {
+        resultado += L' ';
+        resultado += palavras_[entrada.palavras[i]];
+    }
+    return resultado;
+}
+
+/**
+ * \brief Função para contar os n-gramas de um texto.
+ *
+ * \param texto O texto.
+ * \param n O número de palavras de cada n-grama.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return A contagem dos n-gramas.
+ * \throws std::invalid_argument Se `n` estiver fora do intervalo.
+ */
+ContagemNgramas contar_ngramas(const std::wstring& texto, std::size_t n, std::uint32_t configuracao) {
+    MedicaoEtapa medicao(ETAPA_CONTAGEM);
+    ContagemNgramas contagem(n);
+    std::shared_ptr<const FiltroPalavrasVazias> filtro = filtro_palavras_vazias(configuracao);
+    std::wstring chave;
+    std::wstring normalizada;
+    std::uint64_t palavras = 0;
+    percorrer_palavras(texto.data(), texto.data() + texto.size(), configuracao,
+                       [&](const wchar_t* inicio, const wchar_t* fim) {
+                           aplicar_forma_normal(inicio, fim, configuracao, normalizada);
+                           normalizar_chave(inicio, fim, configuracao, chave);
+                           if (chave.empty() || filtro->contem(chave)) {
+                               return;
+                           }
+                           contagem.adicionar(chave);
+                           ++palavras;
+                       });
+    medicao.palavras(palavras);
+    registrar_tabela(contagem.total(), contagem.tamanho());
+    registrar_sondagens(contagem.buscas(), contagem.sondagens());
+    return contagem;
+}
+
+/**
+ * \brief Função para contar os n-gramas do texto lido de um descritor.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param n O número de palavras de cada n-grama.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return A contagem dos n-gramas.
+ * \throws std::invalid_argument Se `n` estiver fora do intervalo.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+ContagemNgramas contar_ngramas_fluxo(int descritor, std::size_t n, std::uint32_t configuracao) {
+    ContagemNgramas contagem(n);
+    ContadorIncremental contador(configuracao);
+    // A contagem de n-gramas é a única: o contador só separa e normaliza as palavras
+    contador.observar_palavras([&contagem](const std::wstring& palavra, std::uint64_t) {
+        contagem.adicionar(palavra);
+    }, false);
+    alimentar_contador(descritor, contador);
+    registrar_tabela(contagem.total(), contagem.tamanho());
+    registrar_sondagens(contagem.buscas(), contagem.sondagens());
+    return contagem;
+}
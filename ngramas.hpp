@@ -0,0 +1,183 @@
+/**
+ * \file ngramas.hpp
+ * \brief Definições da contagem de n-gramas (pares e trios de palavras consecutivas).
+ *
+ * Concatenar as palavras de cada janela em uma string e contá-la em um mapa custaria uma cópia e
+ * uma comparação de strings por ocorrência. Na contagem de n-gramas, cada palavra recebe um
+ * identificador na primeira vez em que aparece, e cada n-grama é uma tupla de tamanho fixo de
+ * identificadores, guardada em uma tabela de dispersão aberta própria. Os identificadores também
+ * ficam em uma tabela aberta, com o hash de cada palavra ao lado do identificador, de forma que a
+ * busca só compara os caracteres da palavra com hash igual. O hash da janela é
+ * polinomial nos identificadores e é atualizado a cada palavra, tirando a palavra que sai da
+ * janela e acrescentando a que entra, sem percorrer a janela de novo. As palavras só são
+ * reconstituídas para a exibição.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef NGRAMAS_HPP_
+#define NGRAMAS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tokenizador.hpp"
+
+/**
+ * \brief O maior número de palavras de um n-grama.
+ */
+const std::size_t MAXIMO_NGRAMA = 3;
+
+/**
+ * \brief Contagem dos n-gramas de uma sequência de palavras.
+ *
+ * As palavras são entregues uma a uma, na ordem do texto, por `adicionar`. Cada n-grama é exibido
+ * com as palavras separadas por um espaço.
+ */
+class ContagemNgramas {
+ public:
+    /**
+     * \brief Cria uma contagem vazia.
+     *
+     * \param n O número de palavras de cada n-grama, de 2 a `MAXIMO_NGRAMA`.
+     * \throws std::invalid_argument Se `n` estiver fora do intervalo.
+     */
+    explicit ContagemNgramas(std::size_t n);
+
+    /**
+     * \brief Acrescenta a próxima palavra do texto, contando o n-grama que ela completa.
+     *
+     * \param palavra A palavra, já normalizada como chave.
+     */
+    void adicionar(const std::wstring& palavra);
+
+    /**
+     * \brief Esvazia a janela, de forma que nenhum n-grama junte as palavras de antes e de depois.
+     */
+    void interromper();
+
+    /**
+     * \brief Retorna o número de palavras de cada n-grama.
+     */
+    std::size_t ordem() const { return n_; }
+
+    /**
+     * \brief Retorna o número de n-gramas distintos.
+     */
+    std::size_t tamanho() const { return ocupadas_; }
+
+    /**
+     * \brief Retorna o número de ocorrências de n-gramas contadas.
+     */
+    std::uint64_t total() const { return total_; }
+
+    /**
+     * \brief Retorna o número de buscas feitas nas tabelas de identificadores e de n-gramas.
+     */
+    std::uint64_t buscas() const { return buscas_; }
+
+    /**
+     * \brief Retorna o número de posições examinadas pelas buscas, a partir da posição do hash.
+     */
+    std::uint64_t sondagens() const { return sondagens_; }
+
+    /**
+     * \brief Retorna quantas vezes um n-grama foi contado.
+     *
+     * \param ngrama As palavras do n-grama, separadas por um espaço.
+     */
+    int contagem(const std::wstring& ngrama) const;
+
+    /**
+     * \brief Converte a contagem para um mapa de n-gramas, para as funções de exibição das palavras.
+     */
+    std::map<std::wstring, int> para_mapa() const;
+
+    /**
+     * \brief Seleciona os n-gramas mais frequentes, como `mais_frequentes` para as palavras.
+     *
+     * Apenas as `k` primeiras posições são ordenadas, e apenas os n-gramas selecionados são
+     * reconstituídos como texto; empates ficam em ordem alfabética.
+     *
+     * \param k O número de n-gramas desejado; zero seleciona todos.
+     * \return Um vetor de pares (n-grama, contagem), em ordem decrescente de contagem.
+     */
+    std::vector<std::pair<std::wstring, int>> mais_frequentes(std::size_t k) const;
+
+ private:
+    /**
+     * \brief Uma posição da tabela: a tupla de identificadores e a sua contagem (zero se vazia).
+     */
+    struct Entrada {
+        std::uint32_t palavras[MAXIMO_NGRAMA];
+        int contagem;
+    };
+
+    /**
+     * \brief Uma posição da tabela de identificadores: o hash da palavra e o identificador mais um
+     * (zero se vazia).
+     */
+    struct Identificador {
+        std::uint32_t hash;
+        std::uint32_t indice;
+    };
+
+    std::uint32_t identificar(const std::wstring& palavra);
+    std::size_t procurar_palavra(const wchar_t* inicio, const wchar_t* fim, std::uint32_t hash) const;
+    void crescer_identificadores();
+    std::uint64_t hash_tupla(const std::uint32_t* palavras) const;
+    std::size_t procurar(const std::uint32_t* palavras, std::uint64_t hash) const;
+    void contar_janela();
+    void crescer();
+    std::wstring texto(const Entrada& entrada) const;
+
+    std::size_t n_;
+    std::vector<Identificador> identificadores_;
+    std::vector<std::wstring> palavras_;
+    std::vector<Entrada> tabela_;
+    std::size_t ocupadas_;
+    std::uint64_t total_;
+    std::uint64_t buscas_;
+    std::uint64_t sondagens_;
+    std::uint32_t janela_[MAXIMO_NGRAMA];
+    std::size_t na_janela_;
+    std::uint64_t hash_;
+    std::uint64_t peso_saida_;
+};
+
+/**
+ * \brief Função para contar os n-gramas de um texto.
+ *
+ * As palavras são separadas e normalizadas como em `contar_palavras`; as palavras descartadas,
+ * como as palavras vazias, não entram nas janelas.
+ *
+ * \param texto O texto.
+ * \param n O número de palavras de cada n-grama.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return A contagem dos n-gramas.
+ * \throws std::invalid_argument Se `n` estiver fora do intervalo.
+ */
+ContagemNgramas contar_ngramas(const std::wstring& texto, std::size_t n,
+                               std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+/**
+ * \brief Função para contar os n-gramas do texto lido de um descritor.
+ *
+ * Lê o descritor em blocos, com as mesmas regras de `contar_palavras_fluxo`, e recebe as
+ * palavras, na ordem, como observador de um `ContadorIncremental` que não monta a sua própria
+ * contagem de palavras.
+ *
+ * \param descritor O descritor a ser lido.
+ * \param n O número de palavras de cada n-grama.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return A contagem dos n-gramas.
+ * \throws std::invalid_argument Se `n` estiver fora do intervalo.
+ * \throws std::ios_base::failure Se ocorrer um erro durante a leitura ou a descompressão.
+ */
+ContagemNgramas contar_ngramas_fluxo(int descritor, std::size_t n, std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+#endif  // NGRAMAS_HPP_
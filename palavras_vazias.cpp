@@ -0,0 +1,331 @@
+/**
+ * \file palavras_vazias.cpp
+ * \brief Implementação do filtro de palavras vazias com hash perfeito mínimo.
+ *
+ * O hash perfeito segue o método de hash e deslocamento (Belazzougui, Botelho e Dietzfelbinger):
+ * o hash de cada palavra escolhe um grupo, e cada grupo recebe um deslocamento, procurado a
+ * partir dos grupos maiores, que leva todas as suas palavras a posições ainda livres da tabela.
+ * A consulta calcula o hash dos caracteres uma vez e só mistura o deslocamento do grupo nele.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "palavras_vazias.hpp"
+
+#include <algorithm>
+#include <codecvt>
+#include <cwchar>
+#include <fstream>
+#include <ios>
+#include <locale>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tokenizador.hpp"
+
+namespace {
+
+/**
+ * \brief Tentativas de deslocamento por grupo antes de recomeçar com outra semente.
+ */
+const std::uint32_t MAXIMO_DESLOCAMENTOS = 1u << 16;
+
+/**
+ * \brief Número médio de palavras por grupo.
+ */
+const std::size_t PALAVRAS_POR_GRUPO = 4;
+
+/**
+ * \brief A lista padrão de palavras vazias do português.
+ */
+const wchar_t* const PALAVRAS_VAZIAS_PORTUGUES[] = {
+    L"a", L"à", L"ao", L"aos", L"aquela", L"aquelas", L"aquele", L"aqueles", L"aquilo", L"as", L"às", L"até",
+    L"com", L"como", L"da", L"das", L"de", L"dela", L"delas", L"dele", L"deles", L"depois", L"do", L"dos",
+    L"e", L"é", L"ela", L"elas", L"ele", L"eles", L"em", L"entre", L"era", L"eram", L"éramos", L"essa",
+    L"essas", L"esse", L"esses", L"esta", L"está", L"estamos", L"estão", L"estar", L"estas", L"estava",
+    L"estavam", L"estávamos", L"este", L"esteja", L"estejam", L"estejamos", L"estes", L"esteve", L"estive",
+    L"estivemos", L"estiver", L"estivera", L"estiveram", L"estivéramos", L"estiverem", L"estivermos",
+    L"estivesse", L"estivessem", L"estivéssemos", L"estou", L"eu", L"foi", L"fomos", L"for", L"fora",
+    L"foram", L"fôramos", L"forem", L"formos", L"fosse", L"fossem", L"fôssemos", L"fui", L"há", L"haja",
+    L"hajam", L"hajamos", L"hão", L"havemos", L"haver", L"hei", L"houve", L"houvemos", L"houver",
+    L"houvera", L"houverá", L"houveram", L"houvéramos", L"houverão", L"houverei", L"houverem",
+    L"houveremos", L"houveria", L"houveriam", L"houveríamos", L"houvermos", L"houvesse", L"houvessem",
+    L"houvéssemos", L"isso", L"isto", L"já", L"lhe", L"lhes", L"mais", L"mas", L"me", L"mesmo", L"meu",
+    L"meus", L"minha", L"minhas", L"muito", L"na", L"não", L"nas", L"nem", L"no", L"nos", L"nós", L"nossa",
+    L"nossas", L"nosso", L"nossos", L"num", L"numa", L"o", L"os", L"ou", L"para", L"pela", L"pelas",
+    L"pelo", L"pelos", L"por", L"qual", L"quando", L"que", L"quem", L"são", L"se", L"seja", L"sejam",
+    L"sejamos", L"sem", L"ser", L"será", L"serão", L"serei", L"seremos", L"seria", L"seriam", L"seríamos",
+    L"seu", L"seus", L"só", L"somos", L"sou", L"sua", L"suas", L"também", L"te", L"tem", L"têm", L"temos",
+    L"tenha", L"tenham", L"tenhamos", L"tenho", L"terá", L"terão", L"terei", L"teremos", L"teria",
+    L"teriam", L"teríamos", L"teu", L"teus", L"teve", L"tinha", L"tinham", L"tínhamos", L"tive",
+    L"tivemos", L"tiver", L"tivera", L"tiveram", L"tivéramos", L"tiverem", L"tivermos", L"tivesse",
+    L"tivessem", L"tivéssemos", L"tu", L"tua", L"tuas", L"um", L"uma", L"você", L"vocês", L"vos"};
+
+/**
+ * \brief Retorna a lista em uso, inicializada com a lista padrão.
+ */
+std::vector<std::wstring>& lista_palavras_vazias() {
+    static std::vector<std::wstring> lista(std::begin(PALAVRAS_VAZIAS_PORTUGUES),
+                                           std::end(PALAVRAS_VAZIAS_PORTUGUES));
+    return lista;
+}
+
+/**
+ * \brief Os bits da configuração que mudam a normalização das chaves e, portanto, o filtro.
+ */
+const std::uint32_t NORMALIZACAO_FILTRO =
+    TOKENIZADOR_MINUSCULAS | TOKENIZADOR_SEM_ACENTOS | TOKENIZADOR_NFC | TOKENIZADOR_NFD;
+
+/**
+ * \brief Os filtros já compilados para a lista em uso, por normalização das chaves.
+ *
+ * O mapa não move os filtros ao inserir, de forma que as referências entregues continuam válidas.
+ */
+struct FiltrosCompilados {
+    std::mutex mutex;
+    std::map<std::uint32_t, std::shared_ptr<const FiltroPalavrasVazias>> filtros;
+};
+
+/**
+ * \brief Retorna os filtros compilados.
+ */
+FiltrosCompilados& filtros_compilados() {
+    static FiltrosCompilados compilados;
+    return compilados;
+}
+
+/**
+ * \brief Calcula o hash de uma palavra (FNV-1a de 64 bits, com a semente e uma mistura final).
+ */
+inline std::uint64_t hash_palavra(const wchar_t* inicio, const wchar_t* fim, std::uint64_t semente) {
+    std::uint64_t hash = 14695981039346656037ull ^ semente;
+    for (; inicio != fim; ++inicio) {
+        hash = (hash ^ static_cast<std::uint32_t>(*inicio)) * 1099511628211ull;
+    }
+    hash ^= hash >> 32;
+    hash *= 0xD6E8FEB86659FD93ull;
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * \brief Retorna o grupo de um hash.
+ */
+inline std::size_t grupo_hash(std::uint64_t hash, std::size_t grupos) {
+    return static_cast<std::size_t>(hash >> 32) % grupos;
+}
+
+/**
+ * \brief Retorna a posição de um hash na tabela com um deslocamento.
+ */
+inline std::size_t posicao_hash(std::uint64_t hash, std::uint32_t deslocamento, std::size_t posicoes) {
+    std::uint64_t misturado = (hash ^ deslocamento) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(misturado >> 32) % posicoes;
+}
+
+/**
+ * \brief Procura um deslocamento para cada grupo, dos maiores para os menores.
+ *
+ * \param hashes O hash de cada palavra.
+ * \param grupos O número de grupos.
+ * \param deslocamentos Recebe o deslocamento de cada grupo.
+ * \return Falso se algum grupo não encontrar posições livres para todas as suas palavras.
+ */
+bool distribuir_grupos(const std::vector<std::uint64_t>& hashes, std::size_t grupos,
+                       std::vector<std::uint32_t>& deslocamentos) {
+    const std::size_t posicoes = hashes.size();
+    std::vector<std::vector<std::size_t>> membros(grupos);
+    for (std::size_t i = 0; i < posicoes; ++i) {
+        membros[grupo_hash(hashes[i], grupos)].push_back(i);
+    }
+    std::vector<std::size_t> ordem(grupos);
+    for (std::size_t g = 0; g < grupos; ++g) {
+        ordem[g] = g;
+    }
+    std::stable_sort(ordem.begin(), ordem.end(),
+                     [&membros](std::size_t a, std::size_t b) { return membros[a].size() > membros[b].size(); });
+
+    std::vector<bool> ocupada(posicoes, false);
+    std::vector<std::size_t> escolhidas;
+    deslocamentos.assign(grupos, 0);
+    for (std::size_t g : ordem) {
+        if (membros[g].empty()) {
+            break;
+        }
+        bool encontrado = false;
+        for (std::uint32_t deslocamento = 0; !encontrado && deslocamento < MAXIMO_DESLOCAMENTOS; ++deslocamento) {
+            escolhidas.clear();
+            encontrado = true;
+            for (std::size_t i : membros[g]) {
+                std::size_t posicao = posicao_hash(hashes[i], deslocamento, posicoes);
+                if (ocupada[posicao] || std::find(escolhidas.begin(), escolhidas.end(), posicao) != escolhidas.end()) {
+                    encontrado = false;
+                    break;
+                }
+                escolhidas.push_back(posicao);
+            }
+            if (encontrado) {
+                deslocamentos[g] = deslocamento;
+            }
+        }
+        if (!encontrado) {
+            return false;
+        }
+        for (std::size_t posicao : escolhidas) {
+            ocupada[posicao] = true;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+/**
+ * \brief Cria um filtro vazio.
+ */
+FiltroPalavrasVazias::FiltroPalavrasVazias() : semente_(0), maior_(0) {}
+
+/**
+ * \brief Cria o filtro de uma lista de palavras.
+ *
+ * As palavras são normalizadas como as chaves da contagem e as repetidas são descartadas. Se
+ * algum grupo não encontrar um deslocamento, ou se duas palavras tiverem o mesmo hash, a
+ * construção recomeça com outra semente.
+ *
+ * \param palavras As palavras, como aparecem no texto.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` das chaves que serão consultadas.
+ */
+FiltroPalavrasVazias::FiltroPalavrasVazias(const std::vector<std::wstring>& palavras, std::uint32_t configuracao)
+    : semente_(0), maior_(0) {
+    std::vector<std::wstring> normalizadas;
+    std::wstring normalizada;
+    std::wstring chave;
+    for (const std::wstring& palavra : palavras) {
+        const wchar_t* inicio = palavra.data();
+        const wchar_t* fim = inicio + palavra.size();
+        aplicar_forma_normal(inicio, fim, configuracao, normalizada);
+        normalizar_chave(inicio, fim, configuracao, chave);
+        if (!chave.empty()) {
+            normalizadas.push_back(chave);
+        }
+    }
+    std::sort(normalizadas.begin(), normalizadas.end());
+    normalizadas.erase(std::unique(normalizadas.begin(), normalizadas.end()), normalizadas.end());
+    if (normalizadas.empty()) {
+        return;
+    }
+
+    const std::size_t posicoes = normalizadas.size();
+    const std::size_t grupos = (posicoes + PALAVRAS_POR_GRUPO - 1) / PALAVRAS_POR_GRUPO;
+    std::vector<std::uint64_t> hashes(posicoes);
+    for (;; ++semente_) {
+        for (std::size_t i = 0; i < posicoes; ++i) {
+            hashes[i] = hash_palavra(normalizadas[i].data(), normalizadas[i].data() + normalizadas[i].size(), semente_);
+        }
+        if (distribuir_grupos(hashes, grupos, deslocamentos_)) {
+            break;
+        }
+    }
+
+    chaves_.resize(posicoes);
+    for (std::size_t i = 0; i < posicoes; ++i) {
+        std::uint64_t hash = hashes[i];
+        chaves_[posicao_hash(hash, deslocamentos_[grupo_hash(hash, grupos)], posicoes)] = normalizadas[i];
+        maior_ = std::max(maior_, normalizadas[i].size());
+    }
+}
+
+/**
+ * \brief Indica se uma chave está no filtro.
+ *
+ * \param inicio O primeiro caractere da chave.
+ * \param fim O caractere seguinte ao último.
+ */
+bool FiltroPalavrasVazias::contem(const wchar_t* inicio, const wchar_t* fim) const {
+    const std::size_t tamanho = static_cast<std::size_t>(fim - inicio);
+    if (chaves_.empty() || tamanho > maior_) {
+        return false;
+    }
+    std::uint64_t hash = hash_palavra(inicio, fim, semente_);
+    std::uint32_t deslocamento = deslocamentos_[grupo_hash(hash, deslocamentos_.size())];
+    const std::wstring& chave = chaves_[posicao_hash(hash, deslocamento, chaves_.size())];
+    return chave.size() == tamanho && std::wmemcmp(chave.data(), inicio, tamanho) == 0;
+}
+
+/**
+ * \brief Retorna a lista de palavras vazias em uso.
+ */
+const std::vector<std::wstring>& palavras_vazias() {
+    return lista_palavras_vazias();
+}
+
+/**
+ * \brief Substitui a lista de palavras vazias usada pelas contagens seguintes.
+ *
+ * \param palavras As novas palavras vazias.
+ */
+void definir_palavras_vazias(const std::vector<std::wstring>& palavras) {
+    FiltrosCompilados& compilados = filtros_compilados();
+    std::lock_guard<std::mutex> trava(compilados.mutex);
+    compilados.filtros.clear();
+    lista_palavras_vazias() = palavras;
+}
+
+/**
+ * \brief Lê uma lista de palavras vazias de um arquivo em UTF-8.
+ *
+ * \param nome_arquivo O nome do arquivo.
+ * \return As palavras lidas, sem os espaços em volta.
+ * \throws std::ios_base::failure Se o arquivo não puder ser lido ou não estiver em UTF-8.
+ */
+std::vector<std::wstring> ler_palavras_vazias(const std::string& nome_arquivo) {
+    std::ifstream arquivo(nome_arquivo, std::ios::binary);
+    if (!arquivo.is_open()) {
+        throw std::ios_base::failure("Nao foi possivel abrir o arquivo de palavras vazias.");
+    }
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> convert;
+    std::vector<std::wstring> palavras;
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        const std::size_t inicio = linha.find_first_not_of(" \t\r");
+        if (inicio == std::string::npos || linha[inicio] == '#') {
+            continue;
+        }
+        const std::size_t fim = linha.find_last_not_of(" \t\r") + 1;
+        try {
+            palavras.push_back(convert.from_bytes(linha.substr(inicio, fim - inicio)));
+        } catch (const std::range_error&) {
+            throw std::ios_base::failure("Arquivo de palavras vazias fora do UTF-8.");
+        }
+    }
+    if (arquivo.bad()) {
+        throw std::ios_base::failure("Erro ao ler o arquivo de palavras vazias.");
+    }
+    return palavras;
+}
+
+/**
+ * \brief Retorna o filtro de palavras vazias de uma configuração, compilando-o na primeira vez.
+ *
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` da contagem.
+ * \return O filtro da lista em uso, ou um filtro vazio sem `TOKENIZADOR_SEM_PALAVRAS_VAZIAS`.
+ */
+std::shared_ptr<const FiltroPalavrasVazias> filtro_palavras_vazias(std::uint32_t configuracao) {
+    static const std::shared_ptr<const FiltroPalavrasVazias> vazio = std::make_shared<const FiltroPalavrasVazias>();
+    if ((configuracao & TOKENIZADOR_SEM_PALAVRAS_VAZIAS) == 0) {
+        return vazio;
+    }
+    const std::uint32_t normalizacao = configuracao & NORMALIZACAO_FILTRO;
+    FiltrosCompilados& compilados = filtros_compilados();
+    std::lock_guard<std::mutex> trava(compilados.mutex);
+    auto posicao = compilados.filtros.find(normalizacao);
+    if (posicao == compilados.filtros.end()) {
+        auto filtro = std::make_shared<const FiltroPalavrasVazias>(palavras_vazias(), normalizacao);
+        posicao = compilados.filtros.emplace(normalizacao, filtro).first;
+    }
+    return posicao->second;
+}
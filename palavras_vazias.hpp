@@ -0,0 +1,122 @@
+/**
+ * \file palavras_vazias.hpp
+ * \brief Definições do filtro de palavras vazias ("de", "que", "o", "é"...) aplicado na contagem.
+ *
+ * As palavras vazias são uma parcela grande das ocorrências de qualquer texto e, quando só são
+ * removidas do resultado, custam uma atualização da tabela de contagem cada uma. Com
+ * `TOKENIZADOR_SEM_PALAVRAS_VAZIAS`, a lista é compilada em um hash perfeito mínimo (pelo método
+ * de hash e deslocamento): cada palavra da lista ocupa uma posição própria de uma tabela com
+ * exatamente uma posição por palavra, e uma palavra do texto é recusada com um único hash dos
+ * seus caracteres e uma comparação, antes de chegar à tabela de contagem.
+ *
+ * A lista usada é a lista padrão do português, ou a que for definida por `definir_palavras_vazias`
+ * (normalmente lida de um arquivo com `ler_palavras_vazias`). O filtro de cada normalização das
+ * chaves é compilado na primeira contagem que o usa e reaproveitado pelas seguintes, até que a
+ * lista seja substituída. A lista não faz parte da
+ * configuração gravada nos instantâneos: contagens feitas com listas diferentes não são
+ * distinguidas.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef PALAVRAS_VAZIAS_HPP_
+#define PALAVRAS_VAZIAS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Conjunto fixo de palavras com busca por hash perfeito mínimo.
+ *
+ * As palavras são normalizadas com a configuração do tokenizador da contagem, de forma que são
+ * comparadas diretamente com as chaves da contagem: com `TOKENIZADOR_SEM_ACENTOS`, por exemplo,
+ * "é" é guardada como "e". Um filtro vazio, o criado sem argumentos, não recusa nenhuma palavra.
+ */
+class FiltroPalavrasVazias {
+ public:
+    /**
+     * \brief Cria um filtro vazio.
+     */
+    FiltroPalavrasVazias();
+
+    /**
+     * \brief Cria o filtro de uma lista de palavras.
+     *
+     * \param palavras As palavras, como aparecem no texto.
+     * \param configuracao Os bits de `ConfiguracaoTokenizador` das chaves que serão consultadas.
+     */
+    FiltroPalavrasVazias(const std::vector<std::wstring>& palavras, std::uint32_t configuracao);
+
+    /**
+     * \brief Indica se uma chave está no filtro.
+     *
+     * As chaves mais longas que a maior palavra do filtro são recusadas sem calcular o hash.
+     *
+     * \param inicio O primeiro caractere da chave.
+     * \param fim O caractere seguinte ao último.
+     */
+    bool contem(const wchar_t* inicio, const wchar_t* fim) const;
+
+    /**
+     * \brief Indica se uma chave está no filtro.
+     */
+    bool contem(const std::wstring& chave) const { return contem(chave.data(), chave.data() + chave.size()); }
+
+    /**
+     * \brief Retorna o número de palavras distintas do filtro, depois da normalização.
+     */
+    std::size_t tamanho() const { return chaves_.size(); }
+
+ private:
+    std::vector<std::wstring> chaves_;          ///< Cada palavra na posição dada pelo hash perfeito.
+    std::vector<std::uint32_t> deslocamentos_;  ///< O deslocamento escolhido para cada grupo.
+    std::uint64_t semente_;                     ///< A semente do hash dos caracteres.
+    std::size_t maior_;                         ///< O tamanho da maior palavra.
+};
+
+/**
+ * \brief Retorna a lista de palavras vazias em uso.
+ *
+ * Até uma chamada a `definir_palavras_vazias`, é a lista padrão do português.
+ */
+const std::vector<std::wstring>& palavras_vazias();
+
+/**
+ * \brief Substitui a lista de palavras vazias usada pelas contagens seguintes.
+ *
+ * Descarta os filtros já compilados; quem ainda guarda um filtro retornado por
+ * `filtro_palavras_vazias`, como uma contagem em andamento, continua usando a lista anterior.
+ *
+ * \param palavras As novas palavras vazias.
+ */
+void definir_palavras_vazias(const std::vector<std::wstring>& palavras);
+
+/**
+ * \brief Lê uma lista de palavras vazias de um arquivo em UTF-8.
+ *
+ * O arquivo tem uma palavra por linha; as linhas vazias e as começadas por `#` são ignoradas.
+ *
+ * \param nome_arquivo O nome do arquivo.
+ * \return As palavras lidas.
+ * \throws std::ios_base::failure Se o arquivo não puder ser lido ou não estiver em UTF-8.
+ */
+std::vector<std::wstring> ler_palavras_vazias(const std::string& nome_arquivo);
+
+/**
+ * \brief Retorna o filtro de palavras vazias de uma configuração.
+ *
+ * O filtro é compilado uma única vez para cada normalização das chaves (minúsculas, acentos e
+ * forma normal) e guardado; as configurações que só diferem nas demais regras compartilham o mesmo
+ * filtro.
+ *
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` da contagem.
+ * \return O filtro da lista em uso, normalizada com a configuração, se ela tiver
+ * `TOKENIZADOR_SEM_PALAVRAS_VAZIAS`; caso contrário, um filtro vazio. O filtro continua válido
+ * depois de uma chamada a `definir_palavras_vazias`, enquanto alguém o guardar.
+ */
+std::shared_ptr<const FiltroPalavrasVazias> filtro_palavras_vazias(std::uint32_t configuracao);
+
+#endif  // PALAVRAS_VAZIAS_HPP_
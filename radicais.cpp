@@ -0,0 +1,484 @@
+/**
+ * \file radicais.cpp
+ * \brief Implementação da extração de radicais do português (RSLP) e da contagem por radical.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "radicais.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cwchar>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "estatisticas.hpp"
+#include "tokenizador.hpp"
+
+namespace {
+
+/**
+ * \brief Uma regra do RSLP como é escrita nas tabelas.
+ */
+struct DefinicaoRegra {
+    const wchar_t* sufixo;                 ///< O sufixo procurado no fim da palavra.
+    std::size_t minimo;                    ///< O tamanho mínimo do radical sem o sufixo.
+    const wchar_t* substituto;             ///< O que entra no lugar do sufixo.
+    std::vector<const wchar_t*> excecoes;  ///< As palavras às quais a regra não se aplica.
+};
+
+/**
+ * \brief Redução do plural, aplicada às palavras terminadas em "s".
+ */
+const DefinicaoRegra REGRAS_PLURAL[] = {
+    {L"ns", 1, L"m", {}},
+    {L"ões", 3, L"ão", {}},
+    {L"ães", 1, L"ão", {L"mães"}},
+    {L"ais", 1, L"al", {L"cais", L"mais"}},
+    {L"éis", 2, L"el", {}},
+    {L"eis", 2, L"el", {}},
+    {L"óis", 2, L"ol", {}},
+    {L"is", 2, L"il", {L"lápis", L"cais", L"mais", L"crúcis", L"biquínis", L"pois", L"depois", L"dois", L"leis"}},
+    {L"les", 3, L"l", {}},
+    {L"res", 3, L"r", {L"árvores"}},
+    {L"s", 2, L"", {L"aliás", L"pires", L"lápis", L"cais", L"mais", L"mas", L"menos", L"férias", L"fezes",
+                    L"pêsames", L"crúcis", L"gás", L"atrás", L"moisés", L"através", L"convés", L"ês", L"país",
+                    L"após", L"ambas", L"ambos", L"messias", L"depois"}},
+};
+
+/**
+ * \brief Redução do feminino, aplicada às palavras terminadas em "a" ou "ã".
+ */
+const DefinicaoRegra REGRAS_FEMININO[] = {
+    {L"ona", 3, L"ão", {L"abandona", L"lona", L"iona", L"cortisona", L"monótona", L"maratona", L"acetona",
+                        L"detona", L"carona"}},
+    {L"ã", 2, L"ão", {L"amanhã", L"arapuã", L"fã", L"divã"}},
+    {L"ora", 3, L"or", {}},
+    {L"na", 4, L"no", {L"carona", L"abandona", L"lona", L"iona", L"cortisona", L"monótona", L"maratona",
+                       L"acetona", L"detona", L"guiana", L"campana", L"grana", L"caravana", L"banana",
+                       L"paisana"}},
+    {L"inha", 3, L"inho", {L"rainha", L"linha", L"minha"}},
+    {L"esa", 3, L"ês", {L"mesa", L"obesa", L"princesa", L"turquesa", L"ilesa", L"pesa", L"presa"}},
+    {L"osa", 3, L"oso", {L"mucosa", L"prosa"}},
+    {L"íaca", 3, L"íaco", {}},
+    {L"ica", 3, L"ico", {L"dica"}},
+    {L"ada", 2, L"ado", {L"pitada"}},
+    {L"ida", 3, L"ido", {L"vida"}},
+    {L"ída", 3, L"ido", {L"recaída", L"saída", L"dúvida"}},
+    {L"ima", 3, L"imo", {L"vítima"}},
+    {L"iva", 3, L"ivo", {L"saliva", L"oliva"}},
+    {L"eira", 3, L"eiro", {L"beira", L"cadeira", L"frigideira", L"bandeira", L"feira", L"capoeira", L"barreira",
+                           L"fronteira", L"besteira", L"poeira"}},
+};
+
+/**
+ * \brief Redução dos aumentativos e diminutivos.
+ */
+const DefinicaoRegra REGRAS_AUMENTATIVO[] = {
+    {L"díssimo", 5, L"", {}},
+    {L"abilíssimo", 5, L"", {}},
+    {L"íssimo", 3, L"", {}},
+    {L"ésimo", 3, L"", {}},
+    {L"érrimo", 4, L"", {}},
+    {L"zinho", 2, L"", {}},
+    {L"quinho", 4, L"c", {}},
+    {L"uinho", 4, L"", {}},
+    {L"adinho", 3, L"", {}},
+    {L"inho", 3, L"", {L"caminho", L"cominho"}},
+    {L"alhão", 4, L"", {}},
+    {L"uça", 4, L"", {}},
+    {L"aço", 4, L"", {L"antebraço"}},
+    {L"aça", 4, L"", {}},
+    {L"adão", 4, L"", {}},
+    {L"idão", 4, L"", {}},
+    {L"ázio", 3, L"", {L"topázio"}},
+    {L"arraz", 4, L"", {}},
+    {L"zarrão", 3, L"", {}},
+    {L"arrão", 4, L"", {}},
+    {L"zão", 2, L"", {L"coalizão"}},
+    {L"ão", 3, L"", {L"camarão", L"chimarrão", L"canção", L"coração", L"embrião", L"grotão", L"glutão",
+                     L"ficção", L"fogão", L"feição", L"furacão", L"gamão", L"lampião", L"leão", L"macacão", L"nação",
+                     L"órfão", L"orgão", L"patrão", L"portão", L"quinhão", L"rincão", L"tração", L"falcão",
+                     L"espião", L"mamão", L"folião", L"cordão", L"aptidão", L"campeão", L"colchão", L"limão",
+                     L"leilão", L"melão", L"barão", L"milhão", L"bilhão", L"fusão", L"cristão", L"ilusão",
+                     L"capitão", L"estação", L"senão"}},
+};
+
+/**
+ * \brief Redução dos advérbios.
+ */
+const DefinicaoRegra REGRAS_ADVERBIO[] = {
+    {L"mente", 4, L"", {L"experimente"}},
+};
+
+/**
+ * \brief Remoção dos sufixos nominais.
+ */
+const DefinicaoRegra REGRAS_NOMINAL[] = {
+    {L"encialista", 4, L"", {}},
+    {L"alista", 5, L"", {}},
+    {L"agem", 3, L"", {L"coragem", L"chantagem", L"vantagem", L"carruagem"}},
+    {L"iamento", 4, L"", {}},
+    {L"amento", 3, L"", {L"firmamento", L"fundamento", L"departamento"}},
+    {L"imento", 3, L"", {}},
+    {L"mento", 6, L"", {L"firmamento", L"elemento", L"complemento", L"instrumento", L"departamento"}},
+    {L"alizado", 4, L"", {}},
+    {L"atizado", 4, L"", {}},
+    {L"tizado", 4, L"", {L"alfabetizado"}},
+    {L"izado", 5, L"", {L"organizado", L"pulverizado"}},
+    {L"ativo", 4, L"", {L"pejorativo", L"relativo"}},
+    {L"tivo", 4, L"", {L"relativo"}},
+    {L"ivo", 4, L"", {L"passivo", L"possessivo", L"pejorativo", L"positivo"}},
+    {L"ado", 2, L"", {L"grado"}},
+    {L"ido", 3, L"", {L"cândido", L"consolido", L"rápido", L"decido", L"tímido", L"duvido", L"marido"}},
+    {L"ador", 3, L"", {}},
+    {L"edor", 3, L"", {}},
+    {L"idor", 4, L"", {L"ouvidor"}},
+    {L"dor", 4, L"", {L"ouvidor"}},
+    {L"sor", 4, L"", {L"assessor"}},
+    {L"atoria", 5, L"", {}},
+    {L"tor", 3, L"", {L"benfeitor", L"leitor", L"editor", L"pastor", L"produtor", L"promotor", L"consultor"}},
+    {L"or", 2, L"", {L"motor", L"melhor", L"redor", L"rigor", L"sensor", L"tambor", L"tumor", L"assessor",
+                     L"benfeitor", L"pastor", L"terior", L"favor", L"autor"}},
+    {L"abilidade", 5, L"", {}},
+    {L"icionista", 4, L"", {}},
+    {L"cionista", 5, L"", {}},
+    {L"ionista", 5, L"", {}},
+    {L"ionar", 5, L"", {}},
+    {L"ional", 4, L"", {}},
+    {L"ência", 3, L"", {}},
+    {L"ância", 4, L"", {L"ambulância"}},
+    {L"edouro", 3, L"", {}},
+    {L"queiro", 3, L"c", {}},
+    {L"adeiro", 4, L"", {L"desfiladeiro"}},
+    {L"eiro", 3, L"", {L"desfiladeiro", L"pioneiro", L"mosteiro"}},
+    {L"uoso", 3, L"", {}},
+    {L"oso", 3, L"", {L"precioso"}},
+    {L"alizaç", 5, L"", {}},
+    {L"atizaç", 5, L"", {}},
+    {L"tizaç", 5, L"", {}},
+    {L"izaç", 5, L"", {L"organizaç"}},
+    {L"aç", 3, L"", {L"equaç"}},
+    {L"iç", 3, L"", {L"eleiç"}},
+    {L"ário", 3, L"", {L"voluntário", L"salário", L"aniversário", L"diário", L"lionário", L"armário"}},
+    {L"atório", 3, L"", {}},
+    {L"rio", 5, L"", {L"voluntário", L"salário", L"aniversário", L"diário", L"compulsório", L"lionário",
+                      L"próprio", L"stério", L"armário"}},
+    {L"ério", 6, L"", {}},
+    {L"ês", 4, L"", {}},
+    {L"eza", 3, L"", {}},
+    {L"ez", 4, L"", {}},
+    {L"esco", 4, L"", {}},
+    {L"ante", 2, L"", {L"gigante", L"elefante", L"adiante", L"possante", L"instante", L"restaurante"}},
+    {L"ástico", 4, L"", {L"eclesiástico"}},
+    {L"alístico", 3, L"", {}},
+    {L"áutico", 4, L"", {}},
+    {L"êutico", 4, L"", {}},
+    {L"tico", 3, L"", {L"político", L"eclesiástico", L"diagnostico", L"prático", L"doméstico", L"diagnóstico",
+                       L"idêntico", L"alopático", L"artístico", L"autêntico", L"eclético", L"crítico",
+                       L"critico"}},
+    {L"ico", 4, L"", {L"tico", L"público", L"explico"}},
+    {L"ividade", 5, L"", {}},
+    {L"idade", 4, L"", {L"autoridade", L"comunidade"}},
+    {L"oria", 4, L"", {L"categoria"}},
+    {L"encial", 5, L"", {}},
+    {L"ista", 4, L"", {}},
+    {L"auta", 5, L"", {}},
+    {L"quice", 4, L"c", {}},
+    {L"ice", 4, L"", {L"cúmplice"}},
+    {L"íaco", 3, L"", {}},
+    {L"ente", 4, L"", {L"freqüente", L"alimente", L"acrescente", L"permanente", L"oriente", L"aparente"}},
+    {L"ense", 5, L"", {}},
+    {L"inal", 3, L"", {}},
+    {L"ano", 4, L"", {}},
+    {L"ável", 2, L"", {L"afável", L"razoável", L"potável", L"vulnerável"}},
+    {L"ível", 3, L"", {L"possível"}},
+    {L"vel", 5, L"", {L"possível", L"vulnerável", L"solúvel"}},
+    {L"bil", 3, L"vel", {}},
+    {L"ura", 4, L"", {L"imatura", L"acupuntura", L"costura"}},
+    {L"ural", 4, L"", {}},
+    {L"ual", 3, L"", {L"bissexual", L"virtual", L"visual", L"pontual"}},
+    {L"ial", 3, L"", {}},
+    {L"al", 4, L"", {L"afinal", L"animal", L"estatal", L"bissexual", L"desleal", L"fiscal", L"formal", L"pessoal",
+                     L"liberal", L"postal", L"virtual", L"visual", L"pontual", L"sideral", L"sucursal"}},
+    {L"alismo", 4, L"", {}},
+    {L"ivismo", 4, L"", {}},
+    {L"ismo", 3, L"", {L"cinismo"}},
+};
+
+/**
+ * \brief Remoção dos sufixos verbais, tentada se nenhum sufixo nominal for removido.
+ */
+const DefinicaoRegra REGRAS_VERBAL[] = {
+    {L"aríamo", 2, L"", {}},
+    {L"ássemo", 2, L"", {}},
+    {L"eríamo", 2, L"", {}},
+    {L"êssemo", 2, L"", {}},
+    {L"iríamo", 3, L"", {}},
+    {L"íssemo", 3, L"", {}},
+    {L"áramo", 2, L"", {}},
+    {L"árei", 2, L"", {}},
+    {L"aremo", 2, L"", {}},
+    {L"ariam", 2, L"", {}},
+    {L"aríei", 2, L"", {}},
+    {L"ássei", 2, L"", {}},
+    {L"assem", 2, L"", {}},
+    {L"ávamo", 2, L"", {}},
+    {L"êramo", 3, L"", {}},
+    {L"eremo", 3, L"", {}},
+    {L"eriam", 3, L"", {}},
+    {L"eríei", 3, L"", {}},
+    {L"êssei", 3, L"", {}},
+    {L"essem", 3, L"", {}},
+    {L"íramo", 3, L"", {}},
+    {L"iremo", 3, L"", {}},
+    {L"iriam", 3, L"", {}},
+    {L"iríei", 3, L"", {}},
+    {L"íssei", 3, L"", {}},
+    {L"issem", 3, L"", {}},
+    {L"ando", 2, L"", {}},
+    {L"endo", 3, L"", {}},
+    {L"indo", 3, L"", {}},
+    {L"ondo", 3, L"", {}},
+    {L"aram", 2, L"", {}},
+    {L"arão", 2, L"", {}},
+    {L"arde", 2, L"", {}},
+    {L"arei", 2, L"", {}},
+    {L"arem", 2, L"", {}},
+    {L"aria", 2, L"", {}},
+    {L"armo", 2, L"", {}},
+    {L"asse", 2, L"", {}},
+    {L"aste", 2, L"", {}},
+    {L"avam", 2, L"", {L"agravam"}},
+    {L"ávei", 2, L"", {}},
+    {L"eram", 3, L"", {}},
+    {L"erão", 3, L"", {}},
+    {L"erde", 3, L"", {}},
+    {L"erei", 3, L"", {}},
+    {L"êrei", 3, L"", {}},
+    {L"erem", 3, L"", {}},
+    {L"eria", 3, L"", {}},
+    {L"ermo", 3, L"", {}},
+    {L"esse", 3, L"", {}},
+    {L"este", 3, L"", {L"faroeste", L"agreste"}},
+    {L"íamo", 3, L"", {}},
+    {L"iram", 3, L"", {}},
+    {L"íram", 3, L"", {}},
+    {L"irão", 2, L"", {}},
+    {L"irde", 2, L"", {}},
+    {L"irei", 3, L"", {L"admirei"}},
+    {L"irem", 3, L"", {L"adquirem"}},
+    {L"iria", 3, L"", {}},
+    {L"irmo", 3, L"", {}},
+    {L"isse", 3, L"", {}},
+    {L"iste", 4, L"", {}},
+    {L"iava", 4, L"", {L"ampliava"}},
+    {L"amo", 2, L"", {}},
+    {L"iona", 3, L"", {}},
+    {L"ara", 2, L"", {L"arara", L"prepara"}},
+    {L"ará", 2, L"", {L"alvará"}},
+    {L"are", 2, L"", {L"prepare"}},
+    {L"ava", 2, L"", {L"agrava"}},
+    {L"emo", 2, L"", {}},
+    {L"era", 3, L"", {L"acelera", L"espera"}},
+    {L"erá", 3, L"", {}},
+    {L"ere", 3, L"", {L"espere"}},
+    {L"iam", 3, L"", {L"enfiam", L"ampliam", L"elogiam", L"ensaiam"}},
+    {L"íei", 3, L"", {}},
+    {L"imo", 3, L"", {L"reprimo", L"intimo", L"íntimo", L"nimo", L"queimo", L"ximo"}},
+    {L"ira", 3, L"", {L"fronteira", L"sátira"}},
+    {L"ído", 3, L"", {}},
+    {L"irá", 3, L"", {}},
+    {L"tizar", 4, L"", {L"alfabetizar"}},
+    {L"izar", 5, L"", {L"organizar"}},
+    {L"itar", 5, L"", {L"acreditar", L"explicitar", L"estreitar"}},
+    {L"ire", 3, L"", {L"adquire"}},
+    {L"omo", 3, L"", {}},
+    {L"ai", 2, L"", {}},
+    {L"am", 2, L"", {}},
+    {L"ear", 4, L"", {L"alardear", L"nuclear"}},
+    {L"ar", 2, L"", {L"azar", L"bazaar", L"patamar"}},
+    {L"uei", 3, L"", {}},
+    {L"uía", 5, L"u", {}},
+    {L"ei", 3, L"", {}},
+    {L"guem", 3, L"g", {}},
+    {L"em", 2, L"", {L"alem", L"virgem"}},
+    {L"er", 2, L"", {L"éter", L"pier"}},
+    {L"eu", 3, L"", {L"chapeu"}},
+    {L"ia", 3, L"", {L"estória", L"fatia", L"acia", L"praia", L"elogia", L"mania", L"lábia", L"aprecia",
+                     L"polícia", L"arredia", L"cheia", L"ásia"}},
+    {L"ir", 3, L"", {L"freir"}},
+    {L"iu", 3, L"", {}},
+    {L"eou", 5, L"", {}},
+    {L"ou", 3, L"", {}},
+    {L"i", 3, L"", {}},
+};
+
+/**
+ * \brief Remoção da vogal final, tentada se nenhum sufixo nominal ou verbal for removido.
+ */
+const DefinicaoRegra REGRAS_VOGAL[] = {
+    {L"bil", 2, L"vel", {}},
+    {L"gue", 2, L"g", {L"gangue", L"jegue"}},
+    {L"á", 3, L"", {}},
+    {L"ê", 3, L"", {L"bebê"}},
+    {L"a", 3, L"", {L"ásia"}},
+    {L"e", 3, L"", {}},
+    {L"o", 3, L"", {L"ão"}},
+};
+
+/**
+ * \brief Normaliza um texto das regras como as chaves da configuração.
+ */
+std::wstring normalizar_regra(const wchar_t* texto, std::uint32_t configuracao) {
+    std::wstring original(texto);
+    const wchar_t* inicio = original.data();
+    const wchar_t* fim = inicio + original.size();
+    std::wstring normalizada;
+    std::wstring chave;
+    aplicar_forma_normal(inicio, fim, configuracao, normalizada);
+    normalizar_chave(inicio, fim, configuracao, chave);
+    return chave;
+}
+
+/**
+ * \brief As regras de uma etapa.
+ */
+struct TabelaEtapa {
+    const DefinicaoRegra* regras;  ///< A primeira regra.
+    std::size_t numero;            ///< O número de regras.
+};
+
+/**
+ * \brief As tabelas de cada etapa, na ordem de `ExtratorRadicais::Etapa`.
+ */
+const TabelaEtapa TABELAS_ETAPAS[] = {
+    {REGRAS_PLURAL, sizeof(REGRAS_PLURAL) / sizeof(REGRAS_PLURAL[0])},
+    {REGRAS_FEMININO, sizeof(REGRAS_FEMININO) / sizeof(REGRAS_FEMININO[0])},
+    {REGRAS_AUMENTATIVO, sizeof(REGRAS_AUMENTATIVO) / sizeof(REGRAS_AUMENTATIVO[0])},
+    {REGRAS_ADVERBIO, sizeof(REGRAS_ADVERBIO) / sizeof(REGRAS_ADVERBIO[0])},
+    {REGRAS_NOMINAL, sizeof(REGRAS_NOMINAL) / sizeof(REGRAS_NOMINAL[0])},
+    {REGRAS_VERBAL, sizeof(REGRAS_VERBAL) / sizeof(REGRAS_VERBAL[0])},
+    {REGRAS_VOGAL, sizeof(REGRAS_VOGAL) / sizeof(REGRAS_VOGAL[0])},
+};
+
+/**
+ * \brief Indica se uma palavra termina com um sufixo.
+ */
+inline bool termina_com(const std::wstring& palavra, const std::wstring& sufixo) {
+    return palavra.size() >= sufixo.size() &&
+           palavra.compare(palavra.size() - sufixo.size(), sufixo.size(), sufixo) == 0;
+}
+
+}  // namespace
+
+/**
+ * \brief Cria o extrator para as chaves de uma configuração.
+ *
+ * Com a remoção dos acentos, as regras cujo sufixo é uma única vogal acentuada são descartadas.
+ *
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+ */
+ExtratorRadicais::ExtratorRadicais(std::uint32_t configuracao) {
+    for (int etapa = 0; etapa < NUMERO_ETAPAS_RADICAL; ++etapa) {
+        const TabelaEtapa& tabela = TABELAS_ETAPAS[etapa];
+        for (std::size_t i = 0; i < tabela.numero; ++i) {
+            const DefinicaoRegra& definicao = tabela.regras[i];
+            Regra regra;
+            regra.sufixo = normalizar_regra(definicao.sufixo, configuracao);
+            if ((configuracao & TOKENIZADOR_SEM_ACENTOS) && std::wcslen(definicao.sufixo) == 1 &&
+                regra.sufixo != definicao.sufixo) {
+                // Sem o acento, "ã" e "á" seriam regras para qualquer palavra terminada em "a"
+                continue;
+            }
+            regra.minimo = definicao.minimo;
+            regra.substituto = normalizar_regra(definicao.substituto, configuracao);
+            for (const wchar_t* excecao : definicao.excecoes) {
+                regra.excecoes.push_back(normalizar_regra(excecao, configuracao));
+            }
+            std::sort(regra.excecoes.begin(), regra.excecoes.end());
+            etapas_[etapa].push_back(regra);
+        }
+    }
+}
+
+/**
+ * \brief Aplica a primeira regra de uma etapa que servir à palavra.
+ *
+ * Uma regra serve se a palavra terminar com o sufixo, se o radical que sobra tiver o tamanho
+ * mínimo e se a palavra não for uma das exceções.
+ *
+ * \param etapa A etapa.
+ * \param palavra A palavra, que recebe a substituição.
+ * \return Verdadeiro se alguma regra foi aplicada.
+ */
+bool ExtratorRadicais::aplicar(Etapa etapa, std::wstring& palavra) const {
+    for (const Regra& regra : etapas_[etapa]) {
+        if (!termina_com(palavra, regra.sufixo) || palavra.size() < regra.sufixo.size() + regra.minimo ||
+            std::binary_search(regra.excecoes.begin(), regra.excecoes.end(), palavra)) {
+            continue;
+        }
+        palavra.replace(palavra.size() - regra.sufixo.size(), regra.sufixo.size(), regra.substituto);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * \brief Extrai o radical de uma palavra.
+ *
+ * O plural só é reduzido nas palavras terminadas em "s", e o feminino nas terminadas em "a" ou
+ * "ã". Os sufixos verbais só são tentados se nenhum sufixo nominal for removido, e a vogal final
+ * só se nenhum dos dois for.
+ *
+ * \param palavra A palavra, em minúsculas, normalizada como as chaves da configuração.
+ * \return O radical, sem acentos.
+ */
+std::wstring ExtratorRadicais::radical(const std::wstring& palavra) const {
+    std::wstring radical = palavra;
+    if (!radical.empty() && radical.back() == L's') {
+        aplicar(PLURAL, radical);
+    }
+    if (!radical.empty() && (radical.back() == L'a' || radical.back() == L'\u00E3')) {
+        aplicar(FEMININO, radical);
+    }
+    aplicar(AUMENTATIVO, radical);
+    aplicar(ADVERBIO, radical);
+    if (!aplicar(NOMINAL, radical) && !aplicar(VERBAL, radical)) {
+        aplicar(VOGAL, radical);
+    }
+    std::size_t tamanho = 0;
+    for (wchar_t caractere : radical) {
+        caractere = remover_acento(caractere);
+        if (caractere != 0) {
+            radical[tamanho++] = caractere;
+        }
+    }
+    radical.resize(tamanho);
+    return radical;
+}
+
+/**
+ * \brief Função para agrupar uma contagem de palavras pelos radicais.
+ *
+ * A contagem das palavras já tem uma entrada por palavra distinta, de forma que ela serve de
+ * memória para a extração: cada radical é extraído uma vez por entrada, e não por ocorrência.
+ *
+ * \param contagem A contagem das palavras.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+ * \return A contagem de cada radical.
+ */
+std::map<std::wstring, int> contar_radicais(const std::map<std::wstring, int>& contagem, std::uint32_t configuracao) {
+    MedicaoEtapa medicao(ETAPA_CONTAGEM);
+    ExtratorRadicais extrator(configuracao);
+    std::map<std::wstring, int> radicais;
+    for (const auto& par : contagem) {
+        radicais[extrator.radical(par.first)] += par.second;
+    }
+    medicao.palavras(contagem.size());
+    registrar_tabela(contagem.size(), radicais.size());
+    return radicais;
+}
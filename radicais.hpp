@@ -0,0 +1,86 @@
+/**
+ * \file radicais.hpp
+ * \brief Definições da extração de radicais do português (RSLP) e da contagem por radical.
+ *
+ * O extrator segue o RSLP (Removedor de Sufixos da Língua Portuguesa, de Orengo e Huyck): reduz o
+ * plural, o feminino, os aumentativos e diminutivos e os advérbios, remove um sufixo nominal ou,
+ * se não houver, um sufixo verbal ou a vogal final, e por fim remove os acentos. Cada etapa é uma
+ * lista de regras com o sufixo, o tamanho mínimo do radical que sobra, a substituição e as
+ * palavras que são exceções.
+ *
+ * Extrair o radical de cada ocorrência repetiria o mesmo trabalho a cada "de" e a cada "casa" do
+ * texto. A contagem por radical conta primeiro as palavras e depois extrai o radical de cada
+ * palavra distinta uma única vez, somando as contagens das palavras de mesmo radical: o custo
+ * além da contagem de palavras é proporcional ao vocabulário, não ao texto.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef RADICAIS_HPP_
+#define RADICAIS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Extrator de radicais do RSLP, com as regras normalizadas para uma configuração.
+ *
+ * As regras são escritas em minúsculas e com acentos; na construção, os sufixos, as substituições
+ * e as exceções passam pela mesma normalização das chaves da contagem (forma normal e remoção dos
+ * acentos), de forma que as regras se aplicam diretamente às chaves. Sem os acentos, as regras
+ * que só se distinguiam por eles se confundem, e o resultado é uma aproximação do RSLP.
+ */
+class ExtratorRadicais {
+ public:
+    /**
+     * \brief Cria o extrator para as chaves de uma configuração.
+     *
+     * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+     */
+    explicit ExtratorRadicais(std::uint32_t configuracao);
+
+    /**
+     * \brief Extrai o radical de uma palavra.
+     *
+     * \param palavra A palavra, em minúsculas, normalizada como as chaves da configuração.
+     * \return O radical, sem acentos.
+     */
+    std::wstring radical(const std::wstring& palavra) const;
+
+ private:
+    /**
+     * \brief Uma regra de remoção de sufixo, já normalizada.
+     */
+    struct Regra {
+        std::wstring sufixo;                ///< O sufixo procurado no fim da palavra.
+        std::size_t minimo;                 ///< O tamanho mínimo do radical sem o sufixo.
+        std::wstring substituto;            ///< O que entra no lugar do sufixo.
+        std::vector<std::wstring> excecoes; ///< As palavras às quais a regra não se aplica, em ordem.
+    };
+
+    /**
+     * \brief As etapas do RSLP, na ordem em que as regras estão definidas.
+     */
+    enum Etapa { PLURAL, FEMININO, AUMENTATIVO, ADVERBIO, NOMINAL, VERBAL, VOGAL, NUMERO_ETAPAS_RADICAL };
+
+    bool aplicar(Etapa etapa, std::wstring& palavra) const;
+
+    std::vector<Regra> etapas_[NUMERO_ETAPAS_RADICAL];
+};
+
+/**
+ * \brief Função para agrupar uma contagem de palavras pelos radicais.
+ *
+ * O radical de cada palavra distinta é extraído uma única vez, e as contagens das palavras com o
+ * mesmo radical são somadas.
+ *
+ * \param contagem A contagem das palavras.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+ * \return A contagem de cada radical.
+ */
+std::map<std::wstring, int> contar_radicais(const std::map<std::wstring, int>& contagem, std::uint32_t configuracao);
+
+#endif  // RADICAIS_HPP_
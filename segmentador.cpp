@@ -0,0 +1,210 @@
+/**
+ * \file segmentador.cpp
+ * \brief Implementação do segmentador de palavras do UAX #29.
+ *
+ * As regras de dois caracteres (WB5 a WB13b) vêm da tabela `PARES_UNIDOS`; as que dependem do
+ * contexto (WB3 a WB4, WB6/WB7, WB7b/WB7c, WB11/WB12 e WB15/WB16) são aplicadas aqui. Os
+ * caracteres de extensão e de formatação são ignorados conforme WB4: a regra seguinte compara
+ * o último caractere significativo com o atual.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "segmentador.hpp"
+
+#include <string>
+#include <vector>
+
+#include "tokenizador.hpp"
+
+namespace {
+
+/**
+ * \brief Retorna a classe Word_Break sem o bit de pictograma.
+ */
+inline unsigned classe_simples(wchar_t caractere) {
+    return classe_quebra(caractere) & ~QUEBRA_PICTOGRAFICO;
+}
+
+/**
+ * \brief Classes ignoradas pela regra WB4.
+ */
+inline bool ignoravel(unsigned classe) {
+    return classe == QUEBRA_EXTENSAO || classe == QUEBRA_FORMATO || classe == QUEBRA_ZWJ;
+}
+
+/**
+ * \brief Classes de AHLetter (letras comuns e hebraicas).
+ */
+inline bool letra(unsigned classe) {
+    return classe == QUEBRA_LETRA || classe == QUEBRA_HEBRAICA;
+}
+
+/**
+ * \brief Classes que sempre quebram antes e depois (WB3a e WB3b).
+ */
+inline bool quebra_linha(unsigned classe) {
+    return classe == QUEBRA_CR || classe == QUEBRA_LF || classe == QUEBRA_NOVA_LINHA;
+}
+
+/**
+ * \brief Letras e dígitos ASCII, que nunca quebram entre si.
+ */
+inline bool alfanumerico_ascii(wchar_t caractere) {
+    return (caractere >= L'a' && caractere <= L'z') || (caractere >= L'A' && caractere <= L'Z') ||
+           (caractere >= L'0' && caractere <= L'9');
+}
+
+/**
+ * \brief Retorna o próximo caractere significativo a partir de `atual`, pulando os ignorados por WB4.
+ */
+const wchar_t* pular_ignoraveis(const wchar_t* atual, const wchar_t* fim) {
+    while (atual != fim && ignoravel(classe_simples(*atual))) {
+        ++atual;
+    }
+    return atual;
+}
+
+/**
+ * \brief Aplica as regras que olham um caractere adiante (WB6/WB7, WB7b/WB7c e WB11/WB12).
+ *
+ * \param significativa A classe do último caractere significativo.
+ * \param classe A classe do caractere em `atual`, candidato a separador interno.
+ * \param atual O caractere candidato a separador.
+ * \param fim O fim do texto.
+ * \return O próximo caractere significativo depois do separador, se ele une as duas partes, ou
+ * `nullptr` se não une.
+ */
+const wchar_t* pular_separador(unsigned significativa, unsigned classe, const wchar_t* atual,
+                               const wchar_t* fim) {
+    bool entre_letras = letra(significativa) &&
+                        (classe == QUEBRA_MEIO_LETRA || classe == QUEBRA_MEIO_NUMERO_LETRA ||
+                         classe == QUEBRA_ASPAS_SIMPLES);
+    bool entre_hebraicas = significativa == QUEBRA_HEBRAICA && classe == QUEBRA_ASPAS_DUPLAS;
+    bool entre_numeros = significativa == QUEBRA_NUMERO &&
+                         (classe == QUEBRA_MEIO_NUMERO || classe == QUEBRA_MEIO_NUMERO_LETRA ||
+                          classe == QUEBRA_ASPAS_SIMPLES);
+    if (!entre_letras && !entre_hebraicas && !entre_numeros) {
+        return nullptr;
+    }
+    const wchar_t* seguinte = pular_ignoraveis(atual + 1, fim);
+    if (seguinte == fim) {
+        return nullptr;
+    }
+    unsigned depois = classe_simples(*seguinte);
+    if ((entre_letras && letra(depois)) || (entre_hebraicas && depois == QUEBRA_HEBRAICA) ||
+        (entre_numeros && depois == QUEBRA_NUMERO)) {
+        return seguinte;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+/**
+ * \brief Encontra o fim do segmento que começa em `inicio`.
+ *
+ * Guarda a classe do caractere anterior, usada pelas regras anteriores a WB4, e a do último
+ * caractere significativo, usada pelas demais. As regras que olham um caractere adiante (WB6,
+ * WB7b e WB12) consomem de uma vez o separador interno e os caracteres ignorados que o seguem.
+ *
+ * \param inicio O primeiro caractere do segmento.
+ * \param fim O fim do texto.
+ * \return O caractere seguinte ao último do segmento (a próxima fronteira).
+ */
+const wchar_t* fim_segmento(const wchar_t* inicio, const wchar_t* fim) {
+    const wchar_t* atual = inicio;
+    while (atual != fim && alfanumerico_ascii(*atual)) {
+        ++atual;
+    }
+    if (atual == fim) {
+        return fim;
+    }
+
+    unsigned anterior;
+    if (atual == inicio) {
+        anterior = classe_quebra(*atual++);
+    } else {
+        anterior = classe_quebra(atual[-1]);
+    }
+    unsigned significativa = anterior & ~QUEBRA_PICTOGRAFICO;
+    unsigned regionais = significativa == QUEBRA_REGIONAL ? 1 : 0;
+
+    while (atual != fim) {
+        unsigned completa = classe_quebra(*atual);
+        unsigned classe = completa & ~QUEBRA_PICTOGRAFICO;
+        unsigned imediata = anterior & ~QUEBRA_PICTOGRAFICO;
+
+        if (quebra_linha(imediata) || quebra_linha(classe)) {
+            if (imediata != QUEBRA_CR || classe != QUEBRA_LF) {  // WB3, WB3a, WB3b
+                return atual;
+            }
+        } else if (imediata == QUEBRA_ZWJ && (completa & QUEBRA_PICTOGRAFICO)) {  // WB3c
+        } else if (imediata == QUEBRA_ESPACO && classe == QUEBRA_ESPACO) {  // WB3d
+        } else if (ignoravel(classe)) {  // WB4
+            anterior = completa;
+            ++atual;
+            continue;
+        } else if (const wchar_t* seguinte = pular_separador(significativa, classe, atual, fim)) {
+            // O separador e os ignorados seguintes ficam no segmento; a letra ou o número
+            // seguinte é unido pela regra de pares na próxima volta
+            anterior = classe_quebra(seguinte[-1]);
+            atual = seguinte;
+            continue;
+        } else if ((PARES_UNIDOS[significativa] >> classe) & 1) {  // WB5, WB7a, WB8-WB10, WB13-WB13b
+        } else if (classe == QUEBRA_REGIONAL && significativa == QUEBRA_REGIONAL) {  // WB15, WB16
+            if (regionais % 2 == 0) {
+                return atual;
+            }
+        } else {
+            return atual;
+        }
+
+        regionais = classe == QUEBRA_REGIONAL ? regionais + 1 : 0;
+        anterior = completa;
+        significativa = classe;
+        ++atual;
+    }
+    return fim;
+}
+
+/**
+ * \brief Indica se um segmento é uma palavra, isto é, se contém letras ou números.
+ *
+ * Além das classes de letras e números do UAX #29, conta como palavra o segmento com uma letra
+ * de classe `QUEBRA_OUTRO`, como os ideogramas, que o UAX #29 separa um a um.
+ *
+ * \param inicio O primeiro caractere do segmento.
+ * \param fim O caractere seguinte ao último.
+ */
+bool segmento_palavra(const wchar_t* inicio, const wchar_t* fim) {
+    for (; inicio != fim; ++inicio) {
+        if (alfanumerico_ascii(*inicio)) {
+            return true;
+        }
+        unsigned classe = classe_simples(*inicio);
+        if (letra(classe) || classe == QUEBRA_NUMERO || classe == QUEBRA_KATAKANA ||
+            (classe == QUEBRA_OUTRO && classe_caractere(*inicio) == CLASSE_LETRA)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief Função para dividir um texto em todos os seus segmentos, inclusive espaços e pontuação.
+ *
+ * \param texto O texto a ser dividido.
+ * \return Os segmentos, cuja concatenação é o texto.
+ */
+std::vector<std::wstring> segmentar(const std::wstring& texto) {
+    std::vector<std::wstring> segmentos;
+    const wchar_t* inicio = texto.data();
+    const wchar_t* fim = inicio + texto.size();
+    while (inicio != fim) {
+        const wchar_t* final = fim_segmento(inicio, fim);
+        segmentos.emplace_back(inicio, final);
+        inicio = final;
+    }
+    return segmentos;
+}
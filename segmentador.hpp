@@ -0,0 +1,65 @@
+/**
+ * \file segmentador.hpp
+ * \brief Definições do segmentador de palavras do UAX #29 (Unicode Text Segmentation).
+ *
+ * O segmentador aplica as regras de fronteira de palavra do UAX #29 sobre a propriedade Word_Break,
+ * consultada nas tabelas geradas em `tabelas_unicode.cpp`, sem depender de bibliotecas externas.
+ * Assim "d'água", "3,5" e "www.exemplo.com" formam uma única palavra, e a pontuação em volta das
+ * palavras forma segmentos próprios, que não são contados. O hífen é tratado como separador
+ * interno de letras, de forma que "guarda-chuva" continua uma palavra.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef SEGMENTADOR_HPP_
+#define SEGMENTADOR_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tabelas_unicode.hpp"
+
+/**
+ * \brief Retorna a classe Word_Break de um caractere, com o bit `QUEBRA_PICTOGRAFICO` quando houver.
+ */
+inline unsigned char classe_quebra(wchar_t caractere) {
+    std::uint32_t ponto_codigo = static_cast<std::uint32_t>(caractere);
+    if (ponto_codigo >= MAXIMO_PONTO_CODIGO) {
+        return QUEBRA_OUTRO;
+    }
+    return BLOCOS_QUEBRA[INDICE_QUEBRA[ponto_codigo >> DESLOCAMENTO_BLOCO_QUEBRA]]
+                        [ponto_codigo & ((1u << DESLOCAMENTO_BLOCO_QUEBRA) - 1)];
+}
+
+/**
+ * \brief Encontra o fim do segmento que começa em `inicio`.
+ *
+ * Sequências de letras e dígitos ASCII são percorridas sem consultar as tabelas; as regras
+ * completas só são aplicadas a partir do primeiro caractere de outro tipo.
+ *
+ * \param inicio O primeiro caractere do segmento.
+ * \param fim O fim do texto.
+ * \return O caractere seguinte ao último do segmento (a próxima fronteira).
+ */
+const wchar_t* fim_segmento(const wchar_t* inicio, const wchar_t* fim);
+
+/**
+ * \brief Indica se um segmento é uma palavra, isto é, se contém letras ou números.
+ *
+ * Segmentos formados apenas por espaços, pontuação, símbolos ou emojis não são palavras.
+ *
+ * \param inicio O primeiro caractere do segmento.
+ * \param fim O caractere seguinte ao último.
+ */
+bool segmento_palavra(const wchar_t* inicio, const wchar_t* fim);
+
+/**
+ * \brief Função para dividir um texto em todos os seus segmentos, inclusive espaços e pontuação.
+ *
+ * \param texto O texto a ser dividido.
+ * \return Os segmentos, cuja concatenação é o texto.
+ */
+std::vector<std::wstring> segmentar(const std::wstring& texto);
+
+#endif  // SEGMENTADOR_HPP_
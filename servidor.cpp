@@ -0,0 +1,452 @@
+/**
+ * \file servidor.cpp
+ * \brief Implementação do servidor de consultas sobre um instantâneo de vocabulário residente.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "servidor.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <ios>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "codificacao.hpp"
+#include "vocabulario.hpp"
+
+/**
+ * \brief Tamanho do cabeçalho de requisições e respostas: 1 byte de operação ou situação e 4 de tamanho.
+ */
+static const std::size_t TAMANHO_CABECALHO_MENSAGEM = 5;
+
+/**
+ * \brief Tamanho das respostas pendentes a partir do qual uma conexão deixa de ser lida.
+ */
+static const std::size_t LIMITE_SAIDA_CONEXAO = 1 << 20;
+
+/**
+ * \brief Preenche o endereço de um socket Unix.
+ *
+ * \throws std::ios_base::failure Se o caminho não couber no endereço.
+ */
+static sockaddr_un endereco_socket(const std::string& caminho) {
+    sockaddr_un endereco;
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (caminho.empty() || caminho.size() >= sizeof(endereco.sun_path)) {
+        throw std::ios_base::failure("Caminho do socket invalido.");
+    }
+    std::memcpy(endereco.sun_path, caminho.data(), caminho.size());
+    return endereco;
+}
+
+/**
+ * \brief Acrescenta uma lista de palavras e contagens no formato das respostas.
+ */
+static void acrescentar_lista(std::string& destino,
+                              const std::vector<std::pair<std::string, std::uint64_t>>& lista) {
+    acrescentar_u32(destino, static_cast<std::uint32_t>(lista.size()));
+    for (const auto& par : lista) {
+        acrescentar_u32(destino, static_cast<std::uint32_t>(par.first.size()));
+        destino += par.first;
+        acrescentar_u64(destino, par.second);
+    }
+}
+
+/**
+ * \brief Mapeia o instantâneo e começa a escutar no socket.
+ *
+ * \param nome_vocabulario O nome do instantâneo de vocabulário.
+ * \param caminho_socket O caminho do socket Unix; um socket antigo no mesmo caminho é removido.
+ * \throws std::ios_base::failure Se o instantâneo não puder ser carregado ou o socket criado.
+ */
+ServidorConsultas::ServidorConsultas(const std::string& nome_vocabulario,
+                                     const std::string& caminho_socket)
+    : vocabulario_(nome_vocabulario), caminho_(caminho_socket), escuta_(-1), frequentes_k_(0) {
+    sockaddr_un endereco = endereco_socket(caminho_);
+    if (::pipe2(aviso_, O_NONBLOCK | O_CLOEXEC) != 0) {
+        throw std::ios_base::failure("Nao foi possivel criar o servidor.");
+    }
+    escuta_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    ::unlink(caminho_.c_str());
+    if (escuta_ < 0 || ::bind(escuta_, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) != 0 ||
+        ::listen(escuta_, SOMAXCONN) != 0) {
+        if (escuta_ >= 0) {
+            ::close(escuta_);
+        }
+        ::close(aviso_[0]);
+        ::close(aviso_[1]);
+        throw std::ios_base::failure("Nao foi possivel criar o socket.");
+    }
+}
+
+ServidorConsultas::~ServidorConsultas() {
+    ::close(escuta_);
+    ::unlink(caminho_.c_str());
+    ::close(aviso_[0]);
+    ::close(aviso_[1]);
+}
+
+/**
+ * \brief Pede que `executar` retorne, escrevendo no pipe de aviso.
+ */
+void ServidorConsultas::parar() {
+    char sinal = 0;
+    ssize_t escritos = ::write(aviso_[1], &sinal, 1);
+    (void)escritos;  // Pipe cheio: já há um aviso pendente
+}
+
+/**
+ * \brief Atende os clientes até que `parar` seja chamado.
+ *
+ * A cada volta do laço, `poll` espera pelo pipe de aviso, pelo socket de escuta e por todas as
+ * conexões; as conexões com respostas pendentes também esperam poder escrever. Uma conexão com
+ * mais de `LIMITE_SAIDA_CONEXAO` bytes pendentes só volta a ser lida, e a ter as requisições já
+ * recebidas respondidas, à medida que o cliente lê as respostas.
+ *
+ * \throws std::ios_base::failure Se ocorrer um erro no laço de eventos.
+ */
+void ServidorConsultas::executar() {
+    std::vector<Conexao> conexoes;
+    std::vector<pollfd> eventos;
+    char buffer[1 << 16];
+    for (;;) {
+        eventos.clear();
+        eventos.push_back({aviso_[0], POLLIN, 0});
+        eventos.push_back({escuta_, POLLIN, 0});
+        for (const auto& conexao : conexoes) {
+            short interesse = 0;
+            if (!conexao.fim_entrada && conexao.saida.size() < LIMITE_SAIDA_CONEXAO) {
+                interesse |= POLLIN;
+            }
+            if (!conexao.saida.empty()) {
+                interesse |= POLLOUT;
+            }
+            eventos.push_back({conexao.descritor, interesse, 0});
+        }
+        if (::poll(eventos.data(), eventos.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::ios_base::failure("Erro no laco de eventos do servidor.");
+        }
+
+        if (eventos[0].revents != 0) {
+            while (::read(aviso_[0], buffer, sizeof(buffer)) > 0) {
+            }
+            for (const auto& conexao : conexoes) {
+                ::close(conexao.descritor);
+            }
+            return;
+        }
+
+        // As conexões aceitas agora entram no poll da próxima volta
+        std::size_t atendidas = conexoes.size();
+        if (eventos[1].revents & POLLIN) {
+            int cliente;
+            while ((cliente = ::accept4(escuta_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                conexoes.push_back({cliente, std::string(), std::string(), false});
+            }
+        }
+
+        for (std::size_t i = 0; i < atendidas; ++i) {
+            Conexao& conexao = conexoes[i];
+            short ocorridos = eventos[i + 2].revents;
+            bool aberta = (ocorridos & (POLLERR | POLLNVAL)) == 0;
+            if (aberta && (ocorridos & (POLLIN | POLLHUP)) && !conexao.fim_entrada) {
+                while (aberta && conexao.saida.size() < LIMITE_SAIDA_CONEXAO) {
+                    ssize_t lidos = ::read(conexao.descritor, buffer, sizeof(buffer));
+                    if (lidos <= 0) {
+                        // Fim da entrada: as requisições já recebidas ainda são respondidas
+                        conexao.fim_entrada = lidos == 0 ||
+                                              (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+                        break;
+                    }
+                    conexao.entrada.append(buffer, static_cast<std::size_t>(lidos));
+                    aberta = processar(conexao);
+                }
+            }
+            // Cada parte enviada abre espaço para responder as requisições que ficaram na entrada
+            while (aberta) {
+                if (conexao.saida.size() < LIMITE_SAIDA_CONEXAO) {
+                    aberta = processar(conexao);
+                }
+                if (!aberta || conexao.saida.empty()) {
+                    break;
+                }
+                ssize_t enviados = ::send(conexao.descritor, conexao.saida.data(), conexao.saida.size(),
+                                          MSG_NOSIGNAL);
+                if (enviados > 0) {
+                    conexao.saida.erase(0, static_cast<std::size_t>(enviados));
+                } else {
+                    aberta = enviados < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+                    break;
+                }
+            }
+            if (!aberta || (conexao.fim_entrada && conexao.saida.empty())) {
+                ::close(conexao.descritor);
+                conexao.descritor = -1;
+            }
+        }
+        conexoes.erase(std::remove_if(conexoes.begin(), conexoes.end(),
+                                      [](const Conexao& conexao) { return conexao.descritor < 0; }),
+                       conexoes.end());
+    }
+}
+
+/**
+ * \brief Responde as requisições completas recebidas por uma conexão.
+ *
+ * Para quando as respostas pendentes chegam a `LIMITE_SAIDA_CONEXAO`; as requisições restantes
+ * ficam na entrada até que o cliente leia as respostas.
+ *
+ * \param conexao A conexão.
+ * \return Falso se a conexão deve ser encerrada por enviar uma requisição grande demais.
+ */
+bool ServidorConsultas::processar(Conexao& conexao) {
+    std::size_t inicio = 0;
+    while (conexao.saida.size() < LIMITE_SAIDA_CONEXAO &&
+           conexao.entrada.size() - inicio >= TAMANHO_CABECALHO_MENSAGEM) {
+        const char* cabecalho = conexao.entrada.data() + inicio;
+        std::uint32_t tamanho = ler_u32(reinterpret_cast<const unsigned char*>(cabecalho + 1));
+        if (tamanho > TAMANHO_MAXIMO_REQUISICAO) {
+            return false;
+        }
+        if (conexao.entrada.size() - inicio - TAMANHO_CABECALHO_MENSAGEM < tamanho) {
+            break;
+        }
+        responder(static_cast<unsigned char>(cabecalho[0]), cabecalho + TAMANHO_CABECALHO_MENSAGEM,
+                  tamanho, conexao.saida);
+        inicio += TAMANHO_CABECALHO_MENSAGEM + tamanho;
+    }
+    conexao.entrada.erase(0, inicio);
+    return true;
+}
+
+/**
+ * \brief Acrescenta à saída a resposta de uma requisição.
+ *
+ * A palavra e o prefixo são normalizados como as chaves, com a configuração gravada no
+ * instantâneo, e as listas são limitadas a `MAXIMO_PALAVRAS_RESPOSTA` palavras. Um erro ao ler o
+ * instantâneo ou uma resposta maior que `TAMANHO_MAXIMO_RESPOSTA` vira uma resposta de erro, sem
+ * afetar as demais requisições e conexões.
+ *
+ * \param operacao A operação pedida.
+ * \param dados Os dados da requisição.
+ * \param tamanho O tamanho dos dados.
+ * \param saida O buffer de saída da conexão.
+ */
+void ServidorConsultas::responder(unsigned char operacao, const char* dados, std::uint32_t tamanho,
+                                  std::string& saida) {
+    std::string resposta;
+    std::string erro;
+    try {
+        if (operacao == CONSULTA_CONTAGEM) {
+            acrescentar_u64(resposta, vocabulario_.contagem(vocabulario_.chave_consulta(std::string(dados, tamanho))));
+        } else if (operacao == CONSULTA_PREFIXO && tamanho >= 4) {
+            std::uint32_t limite = std::min(ler_u32(reinterpret_cast<const unsigned char*>(dados)),
+                                            MAXIMO_PALAVRAS_RESPOSTA);
+            std::string prefixo = vocabulario_.chave_consulta(std::string(dados + 4, tamanho - 4));
+            std::vector<std::pair<std::string, std::uint64_t>> lista;
+            for (Vocabulario::Iterador iterador = vocabulario_.limite_inferior(prefixo);
+                 lista.size() < limite && iterador.valido() &&
+                 iterador.chave().compare(0, prefixo.size(), prefixo) == 0;
+                 iterador.avancar()) {
+                lista.emplace_back(iterador.chave(), iterador.contagem());
+            }
+            acrescentar_lista(resposta, lista);
+        } else if (operacao == CONSULTA_MAIS_FREQUENTES && tamanho == 4) {
+            std::size_t k = std::min(ler_u32(reinterpret_cast<const unsigned char*>(dados)),
+                                     MAXIMO_PALAVRAS_RESPOSTA);
+            const std::vector<std::pair<std::string, std::uint64_t>>& frequentes = mais_frequentes(k);
+            std::vector<std::pair<std::string, std::uint64_t>> lista(
+                frequentes.begin(), frequentes.begin() + std::min(k, frequentes.size()));
+            acrescentar_lista(resposta, lista);
+        } else {
+            erro = "Consulta invalida.";
+        }
+        if (resposta.size() > TAMANHO_MAXIMO_RESPOSTA) {
+            erro = "Resposta grande demais.";
+        }
+    } catch (const std::exception& excecao) {
+        erro = excecao.what();
+    }
+
+    const std::string& dados_resposta = erro.empty() ? resposta : erro;
+    saida += static_cast<char>(erro.empty() ? RESPOSTA_OK : RESPOSTA_ERRO);
+    acrescentar_u32(saida, static_cast<std::uint32_t>(dados_resposta.size()));
+    saida += dados_resposta;
+}
+
+/**
+ * \brief Retorna ao menos as k palavras mais frequentes, calculando-as só quando k cresce.
+ *
+ * \param k O número de palavras desejado.
+ */
+const std::vector<std::pair<std::string, std::uint64_t>>& ServidorConsultas::mais_frequentes(std::size_t k) {
+    k = std::min<std::size_t>(k, static_cast<std::size_t>(vocabulario_.tamanho()));
+    if (k > frequentes_k_) {
+        // Calcula com folga para que pedidos um pouco maiores não percorram o vocabulário de novo
+        frequentes_k_ = std::min<std::size_t>(std::max<std::size_t>(k, 2 * frequentes_k_),
+                                              static_cast<std::size_t>(vocabulario_.tamanho()));
+        frequentes_ = ::mais_frequentes(vocabulario_, frequentes_k_);
+    }
+    return frequentes_;
+}
+
+/**
+ * \brief Conecta ao servidor.
+ *
+ * \param caminho_socket O caminho do socket Unix do servidor.
+ * \throws std::ios_base::failure Se não for possível conectar.
+ */
+ClienteConsultas::ClienteConsultas(const std::string& caminho_socket) : descritor_(-1) {
+    sockaddr_un endereco = endereco_socket(caminho_socket);
+    descritor_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descritor_ < 0 ||
+        ::connect(descritor_, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) != 0) {
+        if (descritor_ >= 0) {
+            ::close(descritor_);
+        }
+        throw std::ios_base::failure("Nao foi possivel conectar ao servidor.");
+    }
+}
+
+ClienteConsultas::~ClienteConsultas() {
+    ::close(descritor_);
+}
+
+/**
+ * \brief Envia uma requisição e espera a resposta.
+ *
+ * \param operacao A operação.
+ * \param dados Os dados da requisição.
+ * \return Os dados da resposta.
+ * \throws std::ios_base::failure Se a conexão falhar ou o servidor responder com erro.
+ */
+std::string ClienteConsultas::consultar(unsigned char operacao, const std::string& dados) {
+    std::string requisicao(1, static_cast<char>(operacao));
+    acrescentar_u32(requisicao, static_cast<std::uint32_t>(dados.size()));
+    requisicao += dados;
+    std::size_t enviados = 0;
+    while (enviados < requisicao.size()) {
+        ssize_t n = ::send(descritor_, requisicao.data() + enviados, requisicao.size() - enviados,
+                           MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            throw std::ios_base::failure("Erro ao enviar a consulta.");
+        }
+        enviados += static_cast<std::size_t>(n);
+    }
+
+    auto receber = [this](char* destino, std::size_t tamanho) {
+        std::size_t recebidos = 0;
+        while (recebidos < tamanho) {
+            ssize_t n = ::read(descritor_, destino + recebidos, tamanho - recebidos);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::ios_base::failure("Erro ao receber a resposta.");
+            }
+            recebidos += static_cast<std::size_t>(n);
+        }
+    };
+    char cabecalho[TAMANHO_CABECALHO_MENSAGEM];
+    receber(cabecalho, sizeof(cabecalho));
+    std::string resposta(ler_u32(reinterpret_cast<const unsigned char*>(cabecalho + 1)), '\0');
+    if (!resposta.empty()) {
+        receber(&resposta[0], resposta.size());
+    }
+    if (static_cast<unsigned char>(cabecalho[0]) != RESPOSTA_OK) {
+        throw std::ios_base::failure(resposta);
+    }
+    return resposta;
+}
+
+/**
+ * \brief Decodifica uma lista de palavras e contagens de uma resposta.
+ *
+ * \throws std::ios_base::failure Se a resposta estiver truncada.
+ */
+static std::vector<std::pair<std::string, std::uint64_t>> decodificar_lista(const std::string& resposta) {
+    const unsigned char* cursor = reinterpret_cast<const unsigned char*>(resposta.data());
+    const unsigned char* fim = cursor + resposta.size();
+    std::vector<std::pair<std::string, std::uint64_t>> lista;
+    if (fim - cursor < 4) {
+        throw std::ios_base::failure("Resposta do servidor invalida.");
+    }
+    std::uint32_t quantidade = ler_u32(cursor);
+    cursor += 4;
+    for (std::uint32_t i = 0; i < quantidade; ++i) {
+        if (fim - cursor < 4) {
+            throw std::ios_base::failure("Resposta do servidor invalida.");
+        }
+        std::uint32_t tamanho = ler_u32(cursor);
+        cursor += 4;
+        if (static_cast<std::size_t>(fim - cursor) < tamanho + 8u) {
+            throw std::ios_base::failure("Resposta do servidor invalida.");
+        }
+        lista.emplace_back(std::string(reinterpret_cast<const char*>(cursor), tamanho),
+                           ler_u64(cursor + tamanho));
+        cursor += tamanho + 8;
+    }
+    return lista;
+}
+
+/**
+ * \brief Consulta a contagem de uma palavra.
+ *
+ * \param chave A palavra em UTF-8.
+ * \return A contagem, ou zero se a palavra não estiver no vocabulário.
+ * \throws std::ios_base::failure Se a conexão falhar ou o servidor responder com erro.
+ */
+std::uint64_t ClienteConsultas::contagem(const std::string& chave) {
+    std::string resposta = consultar(CONSULTA_CONTAGEM, chave);
+    if (resposta.size() != 8) {
+        throw std::ios_base::failure("Resposta do servidor invalida.");
+    }
+    return ler_u64(reinterpret_cast<const unsigned char*>(resposta.data()));
+}
+
+/**
+ * \brief Consulta as palavras que começam com um prefixo, em ordem crescente.
+ *
+ * \param prefixo O prefixo em UTF-8.
+ * \param limite O número máximo de palavras.
+ * \return As palavras e suas contagens.
+ * \throws std::ios_base::failure Se a conexão falhar ou o servidor responder com erro.
+ */
+std::vector<std::pair<std::string, std::uint64_t>> ClienteConsultas::prefixo(const std::string& prefixo,
+                                                                             std::uint32_t limite) {
+    std::string dados;
+    acrescentar_u32(dados, limite);
+    dados += prefixo;
+    return decodificar_lista(consultar(CONSULTA_PREFIXO, dados));
+}
+
+/**
+ * \brief Consulta as palavras mais frequentes.
+ *
+ * \param k O número de palavras.
+ * \return As palavras e suas contagens, da mais frequente para a menos frequente.
+ * \throws std::ios_base::failure Se a conexão falhar ou o servidor responder com erro.
+ */
+std::vector<std::pair<std::string, std::uint64_t>> ClienteConsultas::mais_frequentes(std::uint32_t k) {
+    std::string dados;
+    acrescentar_u32(dados, k);
+    return decodificar_lista(consultar(CONSULTA_MAIS_FREQUENTES, dados));
+}
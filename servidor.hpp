@@ -0,0 +1,184 @@
+/**
+ * \file servidor.hpp
+ * \brief Definições do servidor de consultas sobre um instantâneo de vocabulário residente.
+ *
+ * O servidor mapeia um instantâneo uma única vez e responde consultas por um socket Unix, de forma
+ * que cada consulta custa uma busca no instantâneo, e não a execução do programa inteiro.
+ *
+ * Protocolo (inteiros em little-endian):
+ * - Requisição: 1 byte com a operação, 4 bytes com o tamanho dos dados e os dados.
+ *   - `CONSULTA_CONTAGEM`: dados são a palavra em UTF-8.
+ *   - `CONSULTA_PREFIXO`: 4 bytes com o limite de palavras seguidos do prefixo em UTF-8.
+ *   - `CONSULTA_MAIS_FREQUENTES`: 4 bytes com o número de palavras.
+ *   O servidor normaliza a palavra e o prefixo com a configuração gravada no instantâneo e limita
+ *   as listas a `MAXIMO_PALAVRAS_RESPOSTA` palavras.
+ * - Resposta: 1 byte de situação (`RESPOSTA_OK` ou `RESPOSTA_ERRO`), 4 bytes com o tamanho dos
+ *   dados e os dados.
+ *   - Contagem: 8 bytes com a contagem.
+ *   - Prefixo e mais frequentes: 4 bytes com o número de palavras e, para cada uma, 4 bytes com o
+ *     tamanho da palavra, a palavra em UTF-8 e 8 bytes com a contagem.
+ *   - Erro: a mensagem de erro, inclusive quando a resposta passaria de `TAMANHO_MAXIMO_RESPOSTA`.
+ *
+ * Um cliente pode enviar várias requisições pela mesma conexão, inclusive sem esperar as
+ * respostas; as respostas seguem a ordem das requisições.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef SERVIDOR_HPP_
+#define SERVIDOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vocabulario.hpp"
+
+/**
+ * \brief Operações do protocolo de consultas.
+ */
+enum OperacaoConsulta : unsigned char {
+    CONSULTA_CONTAGEM = 'C',         ///< Contagem de uma palavra.
+    CONSULTA_PREFIXO = 'P',          ///< Palavras que começam com um prefixo, em ordem.
+    CONSULTA_MAIS_FREQUENTES = 'T'   ///< As palavras mais frequentes.
+};
+
+/**
+ * \brief Situação de uma resposta do protocolo de consultas.
+ */
+enum SituacaoResposta : unsigned char {
+    RESPOSTA_OK = 0,   ///< Consulta respondida.
+    RESPOSTA_ERRO = 1  ///< Consulta inválida; os dados trazem a mensagem.
+};
+
+/**
+ * \brief Tamanho máximo dos dados de uma requisição; conexões que o excedem são encerradas.
+ */
+const std::uint32_t TAMANHO_MAXIMO_REQUISICAO = 1 << 16;
+
+/**
+ * \brief Tamanho máximo dos dados de uma resposta; respostas maiores são trocadas por um erro.
+ */
+const std::uint32_t TAMANHO_MAXIMO_RESPOSTA = 1 << 26;
+
+/**
+ * \brief Número máximo de palavras das respostas de prefixo e de mais frequentes.
+ */
+const std::uint32_t MAXIMO_PALAVRAS_RESPOSTA = 100000;
+
+/**
+ * \brief Servidor de consultas sobre um instantâneo de vocabulário.
+ *
+ * Atende vários clientes ao mesmo tempo com um laço de eventos baseado em `poll`, em uma única
+ * thread: todas as consultas são leituras do instantâneo mapeado e levam microssegundos, então não
+ * há ganho em distribuí-las entre threads. As palavras mais frequentes são calculadas na primeira
+ * consulta e guardadas para as seguintes. Um cliente que envia requisições sem ler as respostas
+ * deixa de ser lido quando as suas respostas pendentes passam de um limite, de forma que a memória
+ * de cada conexão não cresce sem limite.
+ */
+class ServidorConsultas {
+ public:
+    /**
+     * \brief Mapeia o instantâneo e começa a escutar no socket.
+     *
+     * \param nome_vocabulario O nome do instantâneo de vocabulário.
+     * \param caminho_socket O caminho do socket Unix; um socket antigo no mesmo caminho é removido.
+     * \throws std::ios_base::failure Se o instantâneo não puder ser carregado ou o socket criado.
+     */
+    ServidorConsultas(const std::string& nome_vocabulario, const std::string& caminho_socket);
+    ~ServidorConsultas();
+
+    ServidorConsultas(const ServidorConsultas&) = delete;
+    ServidorConsultas& operator=(const ServidorConsultas&) = delete;
+
+    /**
+     * \brief Atende os clientes até que `parar` seja chamado.
+     *
+     * \throws std::ios_base::failure Se ocorrer um erro no laço de eventos.
+     */
+    void executar();
+
+    /**
+     * \brief Pede que `executar` retorne; pode ser chamado de outra thread ou de um sinal.
+     */
+    void parar();
+
+ private:
+    /**
+     * \brief Estado de uma conexão: bytes recebidos ainda não processados, respostas a enviar e se
+     * o cliente já encerrou o envio.
+     */
+    struct Conexao {
+        int descritor;
+        std::string entrada;
+        std::string saida;
+        bool fim_entrada;
+    };
+
+    bool processar(Conexao& conexao);
+    void responder(unsigned char operacao, const char* dados, std::uint32_t tamanho, std::string& saida);
+    const std::vector<std::pair<std::string, std::uint64_t>>& mais_frequentes(std::size_t k);
+
+    Vocabulario vocabulario_;
+    std::string caminho_;
+    int escuta_;
+    int aviso_[2];
+    std::vector<std::pair<std::string, std::uint64_t>> frequentes_;
+    std::size_t frequentes_k_;
+};
+
+/**
+ * \brief Cliente do servidor de consultas, com uma conexão aberta por toda a sua vida.
+ */
+class ClienteConsultas {
+ public:
+    /**
+     * \brief Conecta ao servidor.
+     *
+     * \param caminho_socket O caminho do socket Unix do servidor.
+     * \throws std::ios_base::failure Se não for possível conectar.
+     */
+    explicit ClienteConsultas(const std::string& caminho_socket);
+    ~ClienteConsultas();
+
+    ClienteConsultas(const ClienteConsultas&) = delete;
+    ClienteConsultas& operator=(const ClienteConsultas&) = delete;
+
+    /**
+     * \brief Consulta a contagem de uma palavra.
+     *
+     * \param chave A palavra em UTF-8.
+     * \return A contagem, ou zero se a palavra não estiver no vocabulário.
+     * \throws std::ios_base::failure Se a conexão falhar ou o servidor responder com erro.
+     */
+    std::uint64_t contagem(const std::string& chave);
+
+    /**
+     * \brief Consulta as palavras que começam com um prefixo, em ordem crescente.
+     *
+     * \param prefixo O prefixo em UTF-8.
+     * \param limite O número máximo de palavras.
+     * \return As palavras e suas contagens.
+     * \throws std::ios_base::failure Se a conexão falhar ou o servidor responder com erro.
+     */
+    std::vector<std::pair<std::string, std::uint64_t>> prefixo(const std::string& prefixo,
+                                                               std::uint32_t limite);
+
+    /**
+     * \brief Consulta as palavras mais frequentes.
+     *
+     * \param k O número de palavras.
+     * \return As palavras e suas contagens, da mais frequente para a menos frequente.
+     * \throws std::ios_base::failure Se a conexão falhar ou o servidor responder com erro.
+     */
+    std::vector<std::pair<std::string, std::uint64_t>> mais_frequentes(std::uint32_t k);
+
+ private:
+    std::string consultar(unsigned char operacao, const std::string& dados);
+
+    int descritor_;
+};
+
+#endif  // SERVIDOR_HPP_
@@ -0,0 +1,242 @@
+/**
+ * \file tabelas_unicode.hpp
+ * \brief Declarações das tabelas de propriedades Unicode geradas por `gera_tabelas.py`.
+ *
+ * As tabelas são definidas em `tabelas_unicode.cpp`, gerado a partir do banco de dados Unicode com
+ * `make tabelas`. Os módulos que as usam expõem funções de consulta próprias; este cabeçalho só
+ * descreve o formato dos dados.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef TABELAS_UNICODE_HPP_
+#define TABELAS_UNICODE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief Classe de um caractere para o tokenizador.
+ */
+enum ClasseCaractere : unsigned char {
+    CLASSE_ESPACO,     ///< Separa palavras (os mesmos espaços de `iswspace` na glibc).
+    CLASSE_LETRA,      ///< Letras e marcas combinantes; também formatação e pontos não atribuídos.
+    CLASSE_DIGITO,     ///< Números (categorias N*).
+    CLASSE_PONTUACAO   ///< Pontuação, símbolos, controles e espaços que não quebram a linha.
+};
+
+/**
+ * \brief Número de caracteres, a partir de U+0000, classificados por `TABELA_CLASSES`.
+ *
+ * Cobre o ASCII, o Latin-1 e os demais alfabetos europeus, de forma que o texto em português
+ * nunca chega aos intervalos.
+ */
+const std::uint32_t LIMITE_TABELA_CLASSES = 0x800;
+
+/**
+ * \brief Classe de cada caractere abaixo de `LIMITE_TABELA_CLASSES`, indexada pelo ponto de código.
+ */
+extern const unsigned char TABELA_CLASSES[LIMITE_TABELA_CLASSES];
+
+/**
+ * \brief Intervalo fechado de pontos de código com a mesma classe.
+ */
+struct IntervaloClasse {
+    std::uint32_t inicio;
+    std::uint32_t fim;
+    ClasseCaractere classe;
+};
+
+/**
+ * \brief Intervalos, em ordem crescente, dos caracteres acima da tabela que não são letras.
+ */
+extern const IntervaloClasse INTERVALOS_CLASSES[];
+
+/**
+ * \brief Número de elementos de `INTERVALOS_CLASSES`.
+ */
+extern const std::size_t NUMERO_INTERVALOS_CLASSES;
+
+/**
+ * \brief Cada caractere abaixo de `LIMITE_TABELA_CLASSES` sem acentos, indexado pelo ponto de código.
+ *
+ * As letras acentuadas são substituídas pela letra base da sua decomposição canônica ("é" por
+ * "e", "Ç" por "C"), e as marcas combinantes (U+0300 a U+036F) por zero, para que sejam removidas.
+ */
+extern const std::uint16_t TABELA_SEM_ACENTOS[LIMITE_TABELA_CLASSES];
+
+/**
+ * \brief Classe de um caractere na propriedade Word_Break do UAX #29.
+ *
+ * Os nomes da norma aparecem entre parênteses. O hífen (U+002D, U+2010 e U+2011) é classificado
+ * como `QUEBRA_MEIO_LETRA`, para que as palavras compostas do português não sejam divididas.
+ */
+enum QuebraPalavra : unsigned char {
+    QUEBRA_OUTRO,                 ///< (Other)
+    QUEBRA_CR,                    ///< (CR)
+    QUEBRA_LF,                    ///< (LF)
+    QUEBRA_NOVA_LINHA,            ///< (Newline)
+    QUEBRA_EXTENSAO,              ///< (Extend) Marcas combinantes.
+    QUEBRA_ZWJ,                   ///< (ZWJ)
+    QUEBRA_REGIONAL,              ///< (Regional_Indicator)
+    QUEBRA_FORMATO,               ///< (Format)
+    QUEBRA_KATAKANA,              ///< (Katakana)
+    QUEBRA_HEBRAICA,              ///< (Hebrew_Letter)
+    QUEBRA_LETRA,                 ///< (ALetter)
+    QUEBRA_ASPAS_SIMPLES,         ///< (Single_Quote)
+    QUEBRA_ASPAS_DUPLAS,          ///< (Double_Quote)
+    QUEBRA_MEIO_NUMERO_LETRA,     ///< (MidNumLet) Ponto e apóstrofo tipográfico.
+    QUEBRA_MEIO_LETRA,            ///< (MidLetter) Dois-pontos, ponto médio e hífen.
+    QUEBRA_MEIO_NUMERO,           ///< (MidNum) Vírgula e ponto e vírgula.
+    QUEBRA_NUMERO,                ///< (Numeric)
+    QUEBRA_EXTENSAO_NUMERO_LETRA, ///< (ExtendNumLet) Sublinhado.
+    QUEBRA_ESPACO,                ///< (WSegSpace)
+    NUMERO_CLASSES_QUEBRA
+};
+
+/**
+ * \brief Bit somado à classe de quebra dos caracteres com Extended_Pictographic.
+ */
+const unsigned char QUEBRA_PICTOGRAFICO = 0x80;
+
+/**
+ * \brief Primeiro valor acima do maior ponto de código Unicode.
+ */
+const std::uint32_t MAXIMO_PONTO_CODIGO = 0x110000;
+
+/**
+ * \brief Quantidade de bits do ponto de código que seleciona a posição dentro de um bloco.
+ */
+const unsigned DESLOCAMENTO_BLOCO_QUEBRA = 8;
+
+/**
+ * \brief Primeiro nível da tabela de quebras: o bloco de cada faixa de 256 pontos de código.
+ *
+ * Faixas com as mesmas classes compartilham o bloco, o que reduz a tabela a algumas dezenas de
+ * kilobytes.
+ */
+extern const unsigned char INDICE_QUEBRA[MAXIMO_PONTO_CODIGO >> DESLOCAMENTO_BLOCO_QUEBRA];
+
+/**
+ * \brief Segundo nível da tabela de quebras: a classe (mais `QUEBRA_PICTOGRAFICO`) de cada caractere.
+ */
+extern const unsigned char BLOCOS_QUEBRA[][1 << DESLOCAMENTO_BLOCO_QUEBRA];
+
+/**
+ * \brief Pares que não quebram pelas regras de dois caracteres do UAX #29 (WB5 a WB13b).
+ *
+ * O bit `b` de `PARES_UNIDOS[a]` indica que não há quebra entre um caractere da classe `a` e um
+ * da classe `b`, já ignorados os caracteres de extensão e de formatação (WB4).
+ */
+extern const std::uint32_t PARES_UNIDOS[NUMERO_CLASSES_QUEBRA];
+
+/**
+ * \brief Quantidade de bits do ponto de código que seleciona a posição dentro de um bloco de caixa.
+ */
+const unsigned DESLOCAMENTO_BLOCO_MINUSCULAS = 8;
+
+/**
+ * \brief Primeiro nível da tabela de minúsculas: o bloco de cada faixa de 256 pontos de código.
+ */
+extern const unsigned char INDICE_MINUSCULAS[MAXIMO_PONTO_CODIGO >> DESLOCAMENTO_BLOCO_MINUSCULAS];
+
+/**
+ * \brief Segundo nível da tabela de minúsculas: a diferença entre o caractere dobrado e o original.
+ *
+ * O caractere dobrado é o do Simple_Case_Folding do Unicode (CaseFolding.txt, estados C e S), que
+ * leva cada caractere a um único outro: em geral a minúscula, mas também "ς" a "σ" e "ſ" a "s".
+ * Como faixas inteiras têm a mesma diferença, poucas dezenas de blocos cobrem todo o Unicode.
+ */
+extern const std::int32_t BLOCOS_MINUSCULAS[][1 << DESLOCAMENTO_BLOCO_MINUSCULAS];
+
+/**
+ * \brief Quantidade de bits do ponto de código que seleciona a posição dentro de um bloco de normalização.
+ */
+const unsigned DESLOCAMENTO_BLOCO_NORMALIZACAO = 8;
+
+/**
+ * \brief Bit da tabela de normalização: o caractere tem decomposição canônica (NFD_Quick_Check=No).
+ */
+const std::uint16_t NORMALIZACAO_NAO_NFD = 0x100;
+
+/**
+ * \brief Bit da tabela de normalização: o caractere nunca aparece em NFC (NFC_Quick_Check=No).
+ */
+const std::uint16_t NORMALIZACAO_NAO_NFC = 0x200;
+
+/**
+ * \brief Bit da tabela de normalização: o caractere pode se compor com o anterior (NFC_Quick_Check=Maybe).
+ */
+const std::uint16_t NORMALIZACAO_TALVEZ_NFC = 0x400;
+
+/**
+ * \brief Abaixo deste ponto de código todo caractere está em NFC e tem classe de combinação zero.
+ */
+const std::uint32_t LIMITE_RAPIDO_NFC = 0x300;
+
+/**
+ * \brief Abaixo deste ponto de código todo caractere está em NFD e tem classe de combinação zero.
+ */
+const std::uint32_t LIMITE_RAPIDO_NFD = 0xC0;
+
+/**
+ * \brief Primeiro nível da tabela de normalização: o bloco de cada faixa de 256 pontos de código.
+ */
+extern const unsigned char INDICE_NORMALIZACAO[MAXIMO_PONTO_CODIGO >> DESLOCAMENTO_BLOCO_NORMALIZACAO];
+
+/**
+ * \brief Segundo nível da tabela de normalização.
+ *
+ * Os oito bits baixos são a classe de combinação canônica (Canonical_Combining_Class), e os demais
+ * são os bits `NORMALIZACAO_NAO_NFD`, `NORMALIZACAO_NAO_NFC` e `NORMALIZACAO_TALVEZ_NFC`.
+ */
+extern const std::uint16_t BLOCOS_NORMALIZACAO[][1 << DESLOCAMENTO_BLOCO_NORMALIZACAO];
+
+/**
+ * \brief Decomposição canônica completa de um caractere, em `DADOS_DECOMPOSICOES`.
+ */
+struct Decomposicao {
+    std::uint32_t ponto_codigo;
+    std::uint16_t inicio;
+    std::uint16_t tamanho;
+};
+
+/**
+ * \brief Decomposições canônicas completas, já reordenadas, em ordem crescente de ponto de código.
+ *
+ * As sílabas do hangul não estão na tabela: elas são decompostas por fórmula.
+ */
+extern const Decomposicao DECOMPOSICOES[];
+
+/**
+ * \brief Número de elementos de `DECOMPOSICOES`.
+ */
+extern const std::size_t NUMERO_DECOMPOSICOES;
+
+/**
+ * \brief Caracteres das decomposições de `DECOMPOSICOES`.
+ */
+extern const std::uint32_t DADOS_DECOMPOSICOES[];
+
+/**
+ * \brief Par de caracteres que o NFC compõe em um só (composição primária).
+ */
+struct Composicao {
+    std::uint32_t primeiro;
+    std::uint32_t segundo;
+    std::uint32_t composto;
+};
+
+/**
+ * \brief Composições primárias, sem as exclusões de composição, em ordem de `primeiro` e `segundo`.
+ *
+ * As sílabas do hangul não estão na tabela: elas são compostas por fórmula.
+ */
+extern const Composicao COMPOSICOES[];
+
+/**
+ * \brief Número de elementos de `COMPOSICOES`.
+ */
+extern const std::size_t NUMERO_COMPOSICOES;
+
+#endif  // TABELAS_UNICODE_HPP_
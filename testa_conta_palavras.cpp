@@ -13,9 +13,39 @@
 #define CATCH_CONFIG_NO_POSIX_SIGNALS  ///< Desativa o tratamento de sinais POSIX.
 
 #include "conta_palavras.hpp"
+#include "fluxo.hpp"
+#include "descompressao.hpp"
+#include "acompanhamento.hpp"
+#include "vocabulario.hpp"
+#include "corpus.hpp"
+#include "agregacao.hpp"
+#include "indice.hpp"
+#include "servidor.hpp"
+#include "trie.hpp"
+#include "gerador_corpus.hpp"
+#include "estatisticas.hpp"
+#include "tokenizador.hpp"
+#include "segmentador.hpp"
+#include "formas.hpp"
+#include "forma_normal.hpp"
+#include "palavras_vazias.hpp"
+#include "radicais.hpp"
+#include "ngramas.hpp"
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <fstream>
 #include <map>
+#include <numeric>
+#include <memory>
+#include <sstream>
+#include <thread>
 #include <vector>
 #include <iostream>
 #include "catch.hpp"
@@ -47,6 +77,44 @@ TEST_CASE("Arquivo vazio deve abrir com sucesso") {
     REQUIRE_NOTHROW(abrir_arquivo("arquivo_vazio.txt"));
 }
 
+/**
+ * \brief Testa o tamanho informado pelo arquivo aberto.
+ * 
+ * Verifica se `abrir_arquivo` retorna um arquivo cujo tamanho corresponde ao conteúdo em disco.
+ */
+TEST_CASE("Arquivo aberto informa o tamanho do conteudo") {
+    Arquivo arquivo = abrir_arquivo("exemplo.txt");
+    REQUIRE(arquivo.descritor() >= 0);
+    REQUIRE(arquivo.tamanho() == 9);
+    REQUIRE(abrir_arquivo("arquivo_vazio.txt").tamanho() == 0);
+}
+
+/**
+ * \brief Testa a leitura a partir de um arquivo já aberto.
+ * 
+ * Verifica se `ler_arquivo` reaproveita o arquivo aberto por `abrir_arquivo` sem abri-lo novamente.
+ */
+TEST_CASE("Leitura pelo arquivo ja aberto") {
+    Arquivo arquivo = abrir_arquivo("exemplo.txt");
+    REQUIRE(ler_arquivo(arquivo) == "exemplo.\n");
+}
+
+/**
+ * \brief Testa a leitura para um buffer fornecido pelo chamador.
+ * 
+ * Verifica se `ler_arquivo` substitui o conteúdo anterior do destino e informa os bytes lidos.
+ */
+TEST_CASE("Leitura para buffer reaproveitado") {
+    std::string destino = "conteudo anterior bem maior que o arquivo";
+    Arquivo exemplo = abrir_arquivo("exemplo.txt");
+    REQUIRE(ler_arquivo(exemplo, destino) == 9);
+    REQUIRE(destino == "exemplo.\n");
+
+    Arquivo vazio = abrir_arquivo("arquivo_vazio.txt");
+    REQUIRE(ler_arquivo(vazio, destino) == 0);
+    REQUIRE(destino.empty());
+}
+
 /**
  * \brief Testa a leitura de um arquivo inexistente.
  * 
@@ -204,6 +272,1297 @@ TEST_CASE("Ordenar palavras - entrada vazia", "[ordenar_palavras]") {
     REQUIRE(resultado.empty());
 }
 
+/**
+ * \brief Testa o contador incremental com o texto dividido em pedaços de um byte.
+ * 
+ * Verifica se palavras e caracteres UTF-8 divididos entre pedaços são contados como em `contar_palavras`.
+ */
+TEST_CASE("Contador incremental com pedacos de um byte", "[fluxo]") {
+    std::string texto = "Esta \xC3\xA9 uma frase de teste. Esta \xC3\xA9 uma frase de Teste.";
+    ContadorIncremental contador;
+    for (char byte : texto) {
+        contador.alimentar(&byte, 1);
+    }
+    contador.finalizar();
+    std::map<std::wstring, int> resultado_esperado = {
+        {L"esta", 2},
+        {L"é", 2},
+        {L"uma", 2},
+        {L"frase", 2},
+        {L"de", 2},
+        {L"teste.", 2}
+    };
+    REQUIRE(contador.contagem() == resultado_esperado);
+}
+
+/**
+ * \brief Testa o contador incremental com bytes que não formam UTF-8 válido.
+ * 
+ * Verifica se bytes inválidos e sequências incompletas viram U+FFFD sem interromper a contagem e
+ * se `de_utf8` substitui as mesmas sequências que o contador.
+ */
+TEST_CASE("Contador incremental com UTF-8 invalido", "[fluxo]") {
+    std::string texto = "a\xFF b \xC3";
+    ContadorIncremental contador;
+    contador.alimentar(texto.data(), texto.size());
+    contador.finalizar();
+    std::map<std::wstring, int> resultado_esperado = {
+        {L"a\xFFFD", 1},
+        {L"b", 1},
+        {L"\xFFFD", 1}
+    };
+    REQUIRE(contador.contagem() == resultado_esperado);
+
+    REQUIRE(de_utf8("\x80" "a") == L"\xFFFD" L"a");
+    REQUIRE(de_utf8("\xE2\x82" "a") == L"\xFFFD" L"a");
+    REQUIRE(de_utf8("\xE0\x80\x80") == L"\xFFFD");
+    REQUIRE(de_utf8("\xED\xA0\x80") == L"\xFFFD");
+    REQUIRE(de_utf8("\xF8\x88") == L"\xFFFD\xFFFD");
+    REQUIRE(de_utf8("\xC3\xA7" "a\xF0\x9F\x98\x80") == L"\x00E7" L"a\x1F600");
+    for (const char* sequencia : {"\x80" "a", "\xC0\xAF", "\xE2\x82" "a", "\xE0\x80\x80", "\xED\xA0\x80",
+                                  "\xF4\x90\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF\xC3"}) {
+        ContadorIncremental sem_regras(0);
+        sem_regras.alimentar(sequencia, std::strlen(sequencia));
+        sem_regras.finalizar();
+        std::map<std::wstring, int> esperado = {{de_utf8(sequencia), 1}};
+        REQUIRE(sem_regras.contagem() == esperado);
+    }
+}
+
+/**
+ * \brief Testa a contagem de palavras lidas de um pipe.
+ * 
+ * Verifica se `contar_palavras_fluxo` lê o descritor até o fim e conta as palavras.
+ */
+TEST_CASE("Contagem de palavras lidas de um pipe", "[fluxo]") {
+    int descritores[2];
+    REQUIRE(pipe(descritores) == 0);
+    std::string texto = "um dois\ndois tres tres TRES\n";
+    REQUIRE(write(descritores[1], texto.data(), texto.size()) == static_cast<ssize_t>(texto.size()));
+    close(descritores[1]);
+
+    std::map<std::wstring, int> resultado_esperado = {
+        {L"um", 1},
+        {L"dois", 2},
+        {L"tres", 3}
+    };
+    REQUIRE(contar_palavras_fluxo(descritores[0]) == resultado_esperado);
+    close(descritores[0]);
+}
+
+/**
+ * \brief Testa a detecção de formatos compactados.
+ * 
+ * Verifica se `detectar_compressao` reconhece gzip e zstd pelos bytes iniciais.
+ */
+TEST_CASE("Deteccao de formato compactado", "[descompressao]") {
+    REQUIRE(detectar_compressao("\x1F\x8B\x08\x00", 4) == FormatoCompressao::gzip);
+    REQUIRE(detectar_compressao("\x28\xB5\x2F\xFD", 4) == FormatoCompressao::zstd);
+    REQUIRE(detectar_compressao("exemplo.", 8) == FormatoCompressao::nenhum);
+    REQUIRE(detectar_compressao("\x1F", 1) == FormatoCompressao::nenhum);
+}
+
+/**
+ * \brief Testa a leitura transparente de um arquivo gzip.
+ * 
+ * Verifica se `ler_arquivo` entrega o conteúdo descomprimido de um arquivo gzip.
+ */
+TEST_CASE("Leitura de arquivo gzip", "[descompressao]") {
+    REQUIRE(ler_arquivo("exemplo.txt.gz") == "exemplo.\n");
+}
+
+/**
+ * \brief Testa a contagem em fluxo de um arquivo com membros gzip concatenados.
+ * 
+ * Verifica se todos os membros são descomprimidos e contados.
+ */
+TEST_CASE("Contagem de arquivo gzip concatenado", "[descompressao]") {
+    Arquivo arquivo = abrir_arquivo("concatenado.txt.gz");
+    std::map<std::wstring, int> resultado_esperado = {
+        {L"um", 1},
+        {L"dois", 2},
+        {L"tres", 1}
+    };
+    REQUIRE(contar_palavras_fluxo(arquivo.descritor()) == resultado_esperado);
+}
+
+/**
+ * \brief Testa a contagem em fluxo de um arquivo gzip maior que vários blocos.
+ * 
+ * Verifica se o texto descomprimido em vários buffers, na thread de descompressão, é contado por inteiro.
+ */
+TEST_CASE("Contagem de arquivo gzip com varios blocos", "[descompressao]") {
+    const int repeticoes = 300000;
+    gzFile compactado = gzopen("grande.txt.gz", "wb");
+    REQUIRE(compactado != nullptr);
+    for (int i = 0; i < repeticoes; ++i) {
+        gzputs(compactado, "alfa beta gama\n");
+    }
+    gzclose(compactado);
+
+    Arquivo arquivo = abrir_arquivo("grande.txt.gz");
+    std::map<std::wstring, int> resultado_esperado = {
+        {L"alfa", repeticoes},
+        {L"beta", repeticoes},
+        {L"gama", repeticoes}
+    };
+    REQUIRE(contar_palavras_fluxo(arquivo.descritor()) == resultado_esperado);
+    std::remove("grande.txt.gz");
+}
+
+/**
+ * \brief Testa a leitura de um arquivo gzip truncado.
+ * 
+ * Verifica se um arquivo gzip incompleto é rejeitado com uma exceção, tanto na leitura quanto no fluxo.
+ */
+TEST_CASE("Arquivo gzip truncado", "[descompressao]") {
+    std::string compactado = ler_arquivo("concatenado.txt.gz");
+    REQUIRE(compactado == "um dois\ndois tres\n");
+
+    std::ifstream original("exemplo.txt.gz", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+    std::ofstream truncado("truncado.txt.gz", std::ios::binary);
+    truncado.write(bytes.data(), bytes.size() - 4);
+    truncado.close();
+
+    REQUIRE_THROWS_AS(ler_arquivo("truncado.txt.gz"), const std::ios_base::failure&);
+    Arquivo arquivo = abrir_arquivo("truncado.txt.gz");
+    REQUIRE_THROWS_AS(contar_palavras_fluxo(arquivo.descritor()), const std::ios_base::failure&);
+    std::remove("truncado.txt.gz");
+}
+
+/**
+ * \brief Testa a seleção das palavras mais frequentes.
+ * 
+ * Verifica se `mais_frequentes` ordena por contagem decrescente, desempata em ordem alfabética e respeita k.
+ */
+TEST_CASE("Palavras mais frequentes", "[mais_frequentes]") {
+    std::map<std::wstring, int> contagem = {
+        {L"banana", 2},
+        {L"abacaxi", 2},
+        {L"laranja", 5},
+        {L"uva", 1}
+    };
+    std::vector<std::pair<std::wstring, int>> esperado = {{L"laranja", 5}, {L"abacaxi", 2}};
+    REQUIRE(mais_frequentes(contagem, 2) == esperado);
+    REQUIRE(mais_frequentes(contagem, 0).size() == 4);
+    REQUIRE(mais_frequentes(contagem, 10).back() == std::make_pair(std::wstring(L"uva"), 1));
+    REQUIRE(mais_frequentes(std::map<std::wstring, int>(), 3).empty());
+}
+
+/**
+ * \brief Testa o acompanhamento incremental de um arquivo que cresce.
+ * 
+ * Verifica se apenas os bytes acrescentados são lidos, se a palavra incompleta no fim do arquivo 
+ * espera o próximo espaço e se o truncamento reinicia a contagem.
+ */
+TEST_CASE("Acompanhamento de arquivo que cresce", "[acompanhamento]") {
+    std::ofstream escrita("acompanhado.txt");
+    escrita << "um dois do" << std::flush;
+    AcompanhadorArquivo acompanhador("acompanhado.txt");
+    REQUIRE(acompanhador.atualizar());
+    std::map<std::wstring, int> esperado = {{L"um", 1}, {L"dois", 1}};
+    REQUIRE(acompanhador.contagem() == esperado);
+    REQUIRE_FALSE(acompanhador.atualizar());
+
+    escrita << "is tres\n" << std::flush;
+    REQUIRE(acompanhador.atualizar());
+    esperado = {{L"um", 1}, {L"dois", 2}, {L"tres", 1}};
+    REQUIRE(acompanhador.contagem() == esperado);
+    REQUIRE(acompanhador.posicao() == 18);
+    escrita.close();
+
+    std::ofstream truncado("acompanhado.txt", std::ios::trunc);
+    truncado << "novo\n" << std::flush;
+    REQUIRE(acompanhador.atualizar());
+    esperado = {{L"novo", 1}};
+    REQUIRE(acompanhador.contagem() == esperado);
+    truncado.close();
+    std::remove("acompanhado.txt");
+}
+
+/**
+ * \brief Testa a gravação e a leitura de um instantâneo de vocabulário.
+ * 
+ * Verifica se as contagens gravadas são recuperadas por busca e por iteração, inclusive entre blocos 
+ * de reinício da codificação por prefixo, e se o CRC-32 confere.
+ */
+TEST_CASE("Instantaneo de vocabulario ida e volta", "[vocabulario]") {
+    std::map<std::wstring, int> contagem = {{L"é", 3}, {L"será", 1}, {L"texto", 2}};
+    for (int i = 0; i < 1000; ++i) {
+        contagem[L"palavra" + std::to_wstring(i)] = i + 1;
+    }
+    gravar_vocabulario(contagem, "teste.voc");
+
+    Vocabulario vocabulario("teste.voc");
+    REQUIRE(vocabulario.verificar());
+    REQUIRE(vocabulario.tamanho() == contagem.size());
+    REQUIRE(vocabulario.configuracao() == CONFIGURACAO_PADRAO);
+    REQUIRE(vocabulario.contagem(L"será") == 1);
+    REQUIRE(vocabulario.contagem(L"palavra999") == 1000);
+    REQUIRE(vocabulario.contagem(L"palavra0") == 1);
+    REQUIRE(vocabulario.contagem(L"palavra") == 0);
+    REQUIRE(vocabulario.contagem(L"zzz") == 0);
+    REQUIRE(vocabulario.contagem(L"") == 0);
+    REQUIRE(vocabulario.chave_consulta("SERÁ") == "será");
+    REQUIRE(vocabulario.contagem(vocabulario.chave_consulta("Palavra7")) == 8);
+    REQUIRE(vocabulario.para_mapa() == contagem);
+
+    Vocabulario::Iterador iterador = vocabulario.limite_inferior("palavra99");
+    REQUIRE(iterador.valido());
+    REQUIRE(iterador.chave() == "palavra99");
+    iterador.avancar();
+    REQUIRE(iterador.chave() == "palavra990");
+    std::remove("teste.voc");
+}
+
+/**
+ * \brief Testa um instantâneo de vocabulário vazio.
+ * 
+ * Verifica se um vocabulário sem palavras é gravado e carregado corretamente.
+ */
+TEST_CASE("Instantaneo de vocabulario vazio", "[vocabulario]") {
+    gravar_vocabulario(std::map<std::wstring, int>(), "vazio.voc");
+    Vocabulario vocabulario("vazio.voc");
+    REQUIRE(vocabulario.tamanho() == 0);
+    REQUIRE_FALSE(vocabulario.inicio().valido());
+    REQUIRE(vocabulario.contagem(L"a") == 0);
+    std::remove("vazio.voc");
+}
+
+/**
+ * \brief Testa a rejeição de instantâneos inválidos ou corrompidos.
+ * 
+ * Verifica se um arquivo de texto é rejeitado e se a alteração de um byte das entradas ou do
+ * cabeçalho é detectada pelo CRC-32 ao carregar o instantâneo.
+ */
+TEST_CASE("Instantaneo de vocabulario invalido", "[vocabulario]") {
+    REQUIRE_THROWS_AS(Vocabulario("arquivo.txt"), const std::ios_base::failure&);
+
+    gravar_vocabulario({{L"alfa", 1}, {L"beta", 2}}, "corrompido.voc");
+    std::fstream arquivo("corrompido.voc", std::ios::in | std::ios::out | std::ios::binary);
+    arquivo.seekp(66);
+    arquivo.put('X');
+    arquivo.close();
+    REQUIRE_THROWS_AS(Vocabulario("corrompido.voc"), const std::ios_base::failure&);
+
+    // Campos do cabeçalho também são cobertos pelo CRC-32
+    gravar_vocabulario({{L"alfa", 1}, {L"beta", 2}}, "corrompido.voc");
+    arquivo.open("corrompido.voc", std::ios::in | std::ios::out | std::ios::binary);
+    arquivo.seekp(24);
+    arquivo.put('\x07');
+    arquivo.close();
+    REQUIRE_THROWS_AS(Vocabulario("corrompido.voc"), const std::ios_base::failure&);
+    std::remove("corrompido.voc");
+}
+
+/**
+ * \brief Testa a ordem exigida pelo gravador de vocabulário.
+ * 
+ * Verifica se palavras fora de ordem são rejeitadas e se nenhum arquivo incompleto é publicado.
+ */
+TEST_CASE("Gravador de vocabulario exige ordem crescente", "[vocabulario]") {
+    {
+        EscritorVocabulario escritor("ordem.voc", CONFIGURACAO_PADRAO);
+        escritor.adicionar("beta", 1);
+        REQUIRE_THROWS_AS(escritor.adicionar("alfa", 1), const std::invalid_argument&);
+    }
+    REQUIRE_THROWS_AS(abrir_arquivo("ordem.voc"), const std::ios_base::failure&);
+    REQUIRE_THROWS_AS(abrir_arquivo("ordem.voc.tmp"), const std::ios_base::failure&);
+}
+
+/**
+ * \brief Testa a mesclagem de instantâneos de vocabulário.
+ * 
+ * Verifica se as contagens de palavras presentes em mais de um instantâneo são somadas e se 
+ * instantâneos de configurações diferentes são rejeitados.
+ */
+TEST_CASE("Mesclagem de instantaneos de vocabulario", "[vocabulario]") {
+    gravar_vocabulario({{L"alfa", 1}, {L"beta", 2}}, "parte1.voc");
+    gravar_vocabulario({{L"beta", 3}, {L"gama", 4}}, "parte2.voc");
+    gravar_vocabulario(std::map<std::wstring, int>(), "parte3.voc");
+    REQUIRE(mesclar_vocabularios({"parte1.voc", "parte2.voc", "parte3.voc"}, "mesclado.voc") == 3);
+
+    Vocabulario mesclado("mesclado.voc");
+    REQUIRE(mesclado.verificar());
+    REQUIRE(mesclado.total_ocorrencias() == 10);
+    std::map<std::wstring, int> esperado = {{L"alfa", 1}, {L"beta", 5}, {L"gama", 4}};
+    REQUIRE(mesclado.para_mapa() == esperado);
+
+    gravar_vocabulario({{L"Alfa", 1}}, "parte3.voc", 0);
+    REQUIRE_THROWS_AS(mesclar_vocabularios({"parte1.voc", "parte3.voc"}, "mesclado.voc"),
+                      const std::invalid_argument&);
+    std::remove("parte1.voc");
+    std::remove("parte2.voc");
+    std::remove("parte3.voc");
+    std::remove("mesclado.voc");
+}
+
+/**
+ * \brief Testa a atualização incremental de um corpus.
+ * 
+ * Verifica se apenas arquivos novos ou alterados são recontados, se um arquivo com a data alterada 
+ * mas o mesmo conteúdo é reaproveitado, se arquivos retirados do corpus são esquecidos e se um 
+ * arquivo com UTF-8 inválido é contado como em `contar_palavras_arquivo`.
+ */
+TEST_CASE("Atualizacao incremental de corpus", "[corpus]") {
+    std::ofstream("corpus1.txt") << "um dois dois\n";
+    std::ofstream("corpus2.txt") << "dois tres\n";
+    std::vector<std::string> arquivos = {"corpus1.txt", "corpus2.txt"};
+
+    ResultadoCorpus resultado = atualizar_corpus(arquivos, "cache_corpus", "corpus.voc");
+    REQUIRE(resultado.recontados == 2);
+    REQUIRE(resultado.palavras == 3);
+    std::map<std::wstring, int> esperado = {{L"um", 1}, {L"dois", 3}, {L"tres", 1}};
+    REQUIRE(Vocabulario("corpus.voc").para_mapa() == esperado);
+
+    resultado = atualizar_corpus(arquivos, "cache_corpus", "corpus.voc");
+    REQUIRE(resultado.recontados == 0);
+    REQUIRE(resultado.reaproveitados == 2);
+
+    std::ofstream("corpus2.txt") << "quatro\n";
+    struct timespec datas[2] = {{0, UTIME_OMIT}, {1000000000, 0}};
+    ::utimensat(AT_FDCWD, "corpus1.txt", datas, 0);
+    resultado = atualizar_corpus(arquivos, "cache_corpus", "corpus.voc");
+    REQUIRE(resultado.recontados == 1);
+    REQUIRE(resultado.reaproveitados == 1);
+    esperado = {{L"um", 1}, {L"dois", 2}, {L"quatro", 1}};
+    REQUIRE(Vocabulario("corpus.voc").para_mapa() == esperado);
+
+    resultado = atualizar_corpus({"corpus2.txt"}, "cache_corpus", "corpus.voc");
+    REQUIRE(resultado.removidos == 1);
+    esperado = {{L"quatro", 1}};
+    REQUIRE(Vocabulario("corpus.voc").para_mapa() == esperado);
+
+    // Bytes inválidos são contados como U+FFFD, como em `contar_palavras_arquivo`
+    std::ofstream("corpus3.txt") << "ola mundo \xff\xfe teste\n";
+    resultado = atualizar_corpus({"corpus2.txt", "corpus3.txt"}, "cache_corpus", "corpus.voc");
+    REQUIRE(resultado.recontados == 1);
+    esperado = contar_palavras_arquivo("corpus3.txt");
+    REQUIRE(esperado.count(L"ola") == 1);
+    esperado[L"quatro"] += 1;
+    REQUIRE(Vocabulario("corpus.voc").para_mapa() == esperado);
+
+    atualizar_corpus({}, "cache_corpus", "corpus.voc");
+    std::remove("cache_corpus/manifesto.txt");
+    ::rmdir("cache_corpus");
+    std::remove("corpus1.txt");
+    std::remove("corpus2.txt");
+    std::remove("corpus3.txt");
+    std::remove("corpus.voc");
+}
+
+/**
+ * \brief Testa a contagem em memória limitada.
+ * 
+ * Verifica se a contagem é descarregada em várias rodadas quando o limite de memória é pequeno, se 
+ * a intercalação das rodadas produz a mesma contagem feita inteiramente em memória e se as rodadas 
+ * temporárias são apagadas.
+ */
+TEST_CASE("Contagem em memoria limitada", "[agregacao]") {
+    std::string texto;
+    for (int i = 0; i < 500; ++i) {
+        texto += "palavra" + std::to_string(i % 137) + " Repetida\n";
+    }
+    {
+        AgregadorExterno agregador(1024, ".");
+        agregador.contador().alimentar(texto.data(), texto.size());
+        REQUIRE(agregador.contador().memoria_estimada() <= 1024);
+        REQUIRE(agregador.rodadas() > 1);
+        REQUIRE(agregador.concluir("limitado.voc") == 138);
+        REQUIRE(agregador.rodadas() == 0);
+    }
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> convert;
+    REQUIRE(Vocabulario("limitado.voc").para_mapa() == contar_palavras(convert.from_bytes(texto)));
+    std::remove("limitado.voc");
+}
+
+/**
+ * \brief Testa as posições informadas pelo observador de palavras.
+ * 
+ * Verifica se o deslocamento de cada palavra aponta para o seu primeiro byte, inclusive quando a 
+ * palavra começa com um caractere de vários bytes e o texto chega um byte por vez, e se as partes
+ * de uma palavra dividida continuam certas depois de um byte inválido ou de um caractere que muda
+ * de tamanho ao passar para minúsculas.
+ */
+TEST_CASE("Posicoes das palavras no contador incremental", "[fluxo]") {
+    const std::string texto = "Um  ção\n\xC3\xA9 x";
+    std::vector<std::pair<std::wstring, std::uint64_t>> vistas;
+    ContadorIncremental contador;
+    contador.observar_palavras([&vistas](const std::wstring& palavra, std::uint64_t deslocamento) {
+        vistas.emplace_back(palavra, deslocamento);
+    });
+    for (char c : texto) {
+        contador.alimentar(&c, 1);
+    }
+    contador.finalizar();
+    std::vector<std::pair<std::wstring, std::uint64_t>> esperadas = {
+        {L"um", 0}, {L"ção", 4}, {L"é", 10}, {L"x", 13}};
+    REQUIRE(vistas == esperadas);
+    REQUIRE(contador.bytes_processados() == texto.size());
+
+    // Um byte inválido e o sinal de kelvin (três bytes, "k" em minúsculas) antes das partes
+    const std::string separado = "\xFF-casa \xE2\x84\xAA-gato";
+    vistas.clear();
+    ContadorIncremental divisor(CONFIGURACAO_PADRAO | TOKENIZADOR_SEPARAR_PONTUACAO);
+    divisor.observar_palavras([&vistas](const std::wstring& palavra, std::uint64_t deslocamento) {
+        vistas.emplace_back(palavra, deslocamento);
+    });
+    for (char c : separado) {
+        divisor.alimentar(&c, 1);
+    }
+    divisor.finalizar();
+    std::map<std::wstring, std::uint64_t> posicoes(vistas.begin(), vistas.end());
+    REQUIRE(posicoes.at(L"casa") == separado.find("casa"));
+    REQUIRE(posicoes.at(L"k") == separado.find("\xE2"));
+    REQUIRE(posicoes.at(L"gato") == separado.find("gato"));
+}
+
+/**
+ * \brief Testa a gravação e a consulta do índice de posições.
+ * 
+ * Verifica se as ocorrências de uma palavra em vários arquivos são recuperadas em ordem, com os 
+ * deslocamentos relativos a cada arquivo, e se palavras ausentes não têm ocorrências.
+ */
+TEST_CASE("Indice de posicoes", "[indice]") {
+    std::ofstream("indice1.txt") << "um dois um\ntres um\n";
+    std::ofstream("indice2.txt") << "quatro um\n";
+    {
+        IndexadorPosicoes indexador;
+        REQUIRE(indexador.adicionar_arquivo("indice1.txt") == 0);
+        REQUIRE(indexador.adicionar_arquivo("indice2.txt") == 1);
+        REQUIRE(indexador.contagem().at(L"um") == 4);
+        indexador.gravar("indice.voc", "indice.idx");
+    }
+
+    Vocabulario vocabulario("indice.voc");
+    IndicePosicoes indice("indice.idx");
+    REQUIRE(indice.verificar());
+    REQUIRE(indice.tamanho() == vocabulario.tamanho());
+    std::vector<std::string> arquivos = {"indice1.txt", "indice2.txt"};
+    REQUIRE(indice.arquivos() == arquivos);
+
+    std::vector<Ocorrencia> um = indice.ocorrencias(vocabulario, "um");
+    REQUIRE(um.size() == 4);
+    REQUIRE((um[0].arquivo == 0 && um[0].deslocamento == 0));
+    REQUIRE((um[1].arquivo == 0 && um[1].deslocamento == 8));
+    REQUIRE((um[2].arquivo == 0 && um[2].deslocamento == 16));
+    REQUIRE((um[3].arquivo == 1 && um[3].deslocamento == 7));
+    REQUIRE(indice.ocorrencias(vocabulario, "cinco").empty());
+    REQUIRE_THROWS_AS(indice.ocorrencias(indice.tamanho()), const std::out_of_range&);
+
+    std::remove("indice1.txt");
+    std::remove("indice2.txt");
+    std::remove("indice.voc");
+    std::remove("indice.idx");
+}
+
+/**
+ * \brief Testa o servidor de consultas com dois clientes conectados ao mesmo tempo.
+ * 
+ * Verifica as respostas de contagem e de prefixo (com a palavra e o prefixo normalizados pelo
+ * servidor) e de palavras mais frequentes, o limite de palavras das listas, se um cliente que não
+ * lê as respostas recebe todas elas e se o servidor para quando solicitado.
+ */
+TEST_CASE("Servidor de consultas", "[servidor]") {
+    gravar_vocabulario({{L"pro", 1}, {L"prova", 5}, {L"provas", 2}, {L"prumo", 3}, {L"zebra", 4}},
+                       "servidor.voc");
+    ServidorConsultas servidor("servidor.voc", "servidor.sock");
+    std::thread execucao([&servidor]() { servidor.executar(); });
+    {
+        ClienteConsultas primeiro("servidor.sock");
+        ClienteConsultas segundo("servidor.sock");
+        REQUIRE(primeiro.contagem("prova") == 5);
+        REQUIRE(segundo.contagem("ausente") == 0);
+        REQUIRE(segundo.contagem("PROVA") == 5);
+
+        std::vector<std::pair<std::string, std::uint64_t>> esperado = {{"prova", 5}, {"provas", 2}};
+        REQUIRE(segundo.prefixo("prov", 10) == esperado);
+        REQUIRE(primeiro.prefixo("pr", 2).size() == 2);
+        REQUIRE(primeiro.prefixo("x", 10).empty());
+        esperado = {{"pro", 1}, {"prova", 5}, {"provas", 2}};
+        REQUIRE(segundo.prefixo("PRO", 10) == esperado);
+        REQUIRE(primeiro.prefixo("pr", UINT32_MAX).size() == 4);
+
+        esperado = {{"prova", 5}, {"zebra", 4}, {"prumo", 3}};
+        REQUIRE(primeiro.mais_frequentes(3) == esperado);
+        REQUIRE(segundo.mais_frequentes(100).size() == 5);
+        REQUIRE(segundo.mais_frequentes(UINT32_MAX).size() == 5);
+        REQUIRE(primeiro.contagem("zebra") == 4);
+    }
+
+    // Um cliente que envia todas as requisições antes de ler: as respostas passam do limite de
+    // saída da conexão, mas todas chegam, em ordem, e a conexão é encerrada depois da última
+    sockaddr_un endereco;
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    std::strcpy(endereco.sun_path, "servidor.sock");
+    int descritor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE(::connect(descritor, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) == 0);
+    const std::size_t requisicoes = 20000;
+    std::string pedidos;
+    for (std::size_t i = 0; i < requisicoes; ++i) {
+        pedidos.append("T\x04\x00\x00\x00\xFF\xFF\xFF\xFF", 9);
+    }
+    std::thread envio([descritor, &pedidos]() {
+        std::size_t enviados = 0;
+        ssize_t n;
+        while (enviados < pedidos.size() &&
+               (n = ::send(descritor, pedidos.data() + enviados, pedidos.size() - enviados, MSG_NOSIGNAL)) > 0) {
+            enviados += static_cast<std::size_t>(n);
+        }
+        ::shutdown(descritor, SHUT_WR);
+    });
+    std::string recebido;
+    char buffer[1 << 16];
+    ssize_t lidos;
+    while ((lidos = ::read(descritor, buffer, sizeof(buffer))) > 0) {
+        recebido.append(buffer, static_cast<std::size_t>(lidos));
+    }
+    envio.join();
+    ::close(descritor);
+    const std::size_t tamanho = recebido.size() / requisicoes;
+    REQUIRE(tamanho * requisicoes == recebido.size());
+    REQUIRE(recebido.size() > (1u << 20));
+    REQUIRE(recebido[0] == static_cast<char>(RESPOSTA_OK));
+    std::size_t iguais = 0;
+    for (std::size_t i = 0; i < requisicoes; ++i) {
+        iguais += recebido.compare(i * tamanho, tamanho, recebido, 0, tamanho) == 0;
+    }
+    REQUIRE(iguais == requisicoes);
+    servidor.parar();
+    execucao.join();
+    std::remove("servidor.voc");
+}
+
+/**
+ * \brief Testa as consultas de `rank` e `select` do vetor de bits.
+ * 
+ * Compara os resultados com uma contagem direta em um vetor com vários blocos.
+ */
+TEST_CASE("Vetor de bits com rank e select", "[trie]") {
+    VetorBits bits;
+    std::vector<bool> referencia;
+    for (std::size_t i = 0; i < 3000; ++i) {
+        bool bit = (i * 7919) % 13 < 5;
+        bits.acrescentar(bit);
+        referencia.push_back(bit);
+    }
+    bits.preparar();
+    std::size_t uns = 0;
+    std::size_t zeros = 0;
+    for (std::size_t i = 0; i < referencia.size(); ++i) {
+        REQUIRE(bits[i] == referencia[i]);
+        REQUIRE(bits.rank1(i) == uns);
+        if (referencia[i]) {
+            ++uns;
+        } else {
+            REQUIRE(bits.select0(zeros) == i);
+            ++zeros;
+        }
+    }
+    REQUIRE(bits.rank1(referencia.size()) == uns);
+}
+
+/**
+ * \brief Testa a trie compacta do vocabulário.
+ * 
+ * Verifica a contagem de palavras presentes e ausentes, a enumeração por prefixo em ordem e com 
+ * limite, a busca sem acentos (inclusive com marcas combinantes em NFD), se a trie ocupa menos
+ * memória que um vetor de palavras e se a trie gravada ao lado do instantâneo é recarregada,
+ * recusada quando corrompida ou de outro vocabulário, e reconstruída nesse caso.
+ */
+TEST_CASE("Trie compacta do vocabulario", "[trie]") {
+    std::map<std::wstring, int> contagem = {{L"pro", 1}, {L"prova", 5}, {L"provas", 2}, {L"prumo", 3},
+                                            {L"café", 4}, {L"cafe", 6}, {L"cafés", 7}, {L"é", 8},
+                                            {L"cafe\u0301", 9}};
+    for (int i = 0; i < 1000; ++i) {
+        contagem[L"palavra" + std::to_wstring(i)] = i + 1;
+    }
+    TrieCompacta trie(contagem);
+    REQUIRE(trie.tamanho() == contagem.size());
+    REQUIRE(trie.contagem("prova") == 5);
+    REQUIRE(trie.contagem("café") == 4);
+    REQUIRE(trie.contagem("palavra999") == 1000);
+    REQUIRE(trie.contagem("prov") == 0);
+    REQUIRE(trie.contagem("provass") == 0);
+
+    TrieCompacta::Resultados esperado = {{"pro", 1}, {"prova", 5}, {"provas", 2}};
+    REQUIRE(trie.prefixo("pro") == esperado);
+    REQUIRE(trie.prefixo("pr", 2).size() == 2);
+    REQUIRE(trie.prefixo("x").empty());
+    REQUIRE(trie.prefixo("").size() == contagem.size());
+
+    // A forma NFD, com a marca combinante, é encontrada e também pode ser a procurada
+    esperado = {{"cafe", 6}, {"cafe\xCC\x81", 9}, {"café", 4}};
+    REQUIRE(trie.buscar_sem_acentos(L"cafe") == esperado);
+    REQUIRE(trie.buscar_sem_acentos(L"café") == esperado);
+    REQUIRE(trie.buscar_sem_acentos(L"cafe\u0301") == esperado);
+    TrieCompacta::Resultados acentuadas = {{"é", 8}};
+    REQUIRE(trie.buscar_sem_acentos(L"e") == acentuadas);
+
+    // A trie gravada ao lado do instantâneo é carregada sem ser reconstruída
+    gravar_vocabulario(contagem, "trie.voc");
+    {
+        Vocabulario vocabulario("trie.voc");
+        REQUIRE(carregar_trie(vocabulario, "trie.voc").prefixo("") == trie.prefixo(""));
+        TrieCompacta carregada("trie.voc.trie", vocabulario.crc());
+        REQUIRE(carregada.prefixo("") == trie.prefixo(""));
+        REQUIRE(carregada.buscar_sem_acentos(L"cafe") == esperado);
+        REQUIRE(carregada.contagem("palavra999") == 1000);
+        REQUIRE_THROWS_AS(TrieCompacta("trie.voc.trie", vocabulario.crc() + 1), const std::ios_base::failure&);
+
+        std::fstream arquivo("trie.voc.trie", std::ios::in | std::ios::out | std::ios::binary);
+        arquivo.seekp(60);
+        arquivo.put('\x55');
+        arquivo.close();
+        REQUIRE_THROWS_AS(TrieCompacta("trie.voc.trie", vocabulario.crc()), const std::ios_base::failure&);
+        REQUIRE(carregar_trie(vocabulario, "trie.voc").contagem("prova") == 5);
+        REQUIRE(TrieCompacta("trie.voc.trie", vocabulario.crc()).contagem("prova") == 5);
+    }
+    std::remove("trie.voc");
+    std::remove("trie.voc.trie");
+
+    std::size_t memoria_vetor = 0;
+    for (const auto& par : contagem) {
+        memoria_vetor += sizeof(std::wstring) + (par.first.size() + 1) * sizeof(wchar_t);
+    }
+    REQUIRE(trie.memoria() < memoria_vetor);
+}
+
+/**
+ * \brief Testa o gerador de corpus sintético.
+ * 
+ * Verifica se a mesma semente produz o mesmo texto, se o tamanho e as quebras de linha são
+ * respeitados, se as frequências seguem a ordem do vocabulário e se as sequências UTF-8 inválidas
+ * só aparecem quando pedidas.
+ */
+TEST_CASE("Gerador de corpus sintetico", "[gerador]") {
+    auto gerar = [](const ConfiguracaoCorpus& configuracao) {
+        GeradorCorpus gerador(configuracao);
+        std::string texto;
+        std::string bloco;
+        while (gerador.gerar(bloco, 1000)) {
+            texto += bloco;
+        }
+        REQUIRE(gerador.gerados() == texto.size());
+        return texto;
+    };
+
+    ConfiguracaoCorpus configuracao;
+    configuracao.tamanho = 200000;
+    configuracao.vocabulario = 2000;
+    const std::string texto = gerar(configuracao);
+    REQUIRE(texto.size() >= configuracao.tamanho);
+    REQUIRE(texto.size() < configuracao.tamanho + 100);
+    REQUIRE(texto.back() == '\n');
+    REQUIRE(gerar(configuracao) == texto);
+    configuracao.semente = 2;
+    REQUIRE(gerar(configuracao) != texto);
+
+    std::size_t linhas = 0;
+    std::size_t inicio = 0;
+    for (std::size_t fim = texto.find('\n'); fim != std::string::npos; fim = texto.find('\n', inicio)) {
+        REQUIRE(fim - inicio <= configuracao.linha_maxima + 64);
+        ++linhas;
+        inicio = fim + 1;
+    }
+    REQUIRE(linhas > configuracao.tamanho / (configuracao.linha_maxima + 64));
+
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> convert;
+    std::map<std::wstring, int> contagem;
+    REQUIRE_NOTHROW(contagem = contar_palavras(convert.from_bytes(texto)));
+    GeradorCorpus gerador(configuracao);
+    std::wstring primeira = convert.from_bytes(gerador.vocabulario()[0]);
+    std::wstring centesima = convert.from_bytes(gerador.vocabulario()[99]);
+    REQUIRE(contagem[primeira] > 10 * contagem[centesima]);
+
+    configuracao.densidade_acentos = 0.0;
+    for (char c : gerar(configuracao)) {
+        REQUIRE(static_cast<unsigned char>(c) < 0x80);
+    }
+
+    configuracao.taxa_invalidos = 0.05;
+    REQUIRE_THROWS(convert.from_bytes(gerar(configuracao)));
+
+    configuracao.linha_minima = configuracao.linha_maxima + 1;
+    REQUIRE_THROWS_AS(GeradorCorpus{configuracao}, const std::invalid_argument&);
+}
+
+/**
+ * \brief Testa a instrumentação por etapa.
+ * 
+ * Verifica se, com as estatísticas ativas, a leitura, a decodificação e a contagem de um arquivo
+ * aparecem no relatório com os bytes e as buscas esperados, se nada é registrado com elas
+ * inativas, se as sondagens das tabelas de n-gramas são registradas e se, sem o operador `new` de
+ * `alocacoes.cpp`, as alocações ficam fora dos contadores.
+ */
+TEST_CASE("Estatisticas por etapa", "[estatisticas]") {
+    REQUIRE(estatisticas_disponiveis());
+    {
+        std::ofstream arquivo("estatisticas.txt");
+        arquivo << "um dois dois tres tres tres\n";
+    }
+
+    ativar_estatisticas(true);
+    contar_palavras_arquivo("estatisticas.txt");
+    std::ostringstream relatorio;
+    imprimir_estatisticas(relatorio);
+    REQUIRE(relatorio.str().find("\"etapa\": \"leitura\", \"chamadas\": 1,") != std::string::npos);
+    REQUIRE(relatorio.str().find("\"etapa\": \"contagem\", \"chamadas\": 1,") != std::string::npos);
+    REQUIRE(relatorio.str().find("\"etapa\": \"decodificacao\"") == std::string::npos);
+    REQUIRE(relatorio.str().find("\"bytes\": 28,") != std::string::npos);
+    REQUIRE(relatorio.str().find("\"palavras\": 6,") != std::string::npos);
+    REQUIRE(relatorio.str().find("\"buscas\": 6, \"insercoes\": 3") != std::string::npos);
+    REQUIRE(relatorio.str().find("\"etapa\": \"ordenacao\"") == std::string::npos);
+    REQUIRE(relatorio.str().find("\"sondagens\": {\"buscas\": 0,") != std::string::npos);
+
+    // Seis palavras identificadas e cinco pares contados nas tabelas de dispersão aberta
+    ativar_estatisticas(true);
+    ContagemNgramas pares = contar_ngramas(L"a b a b a b", 2, CONFIGURACAO_PADRAO);
+    REQUIRE(pares.buscas() == 11);
+    REQUIRE(pares.sondagens() >= pares.buscas());
+    relatorio.str("");
+    imprimir_estatisticas(relatorio);
+    REQUIRE(relatorio.str().find("\"sondagens\": {\"buscas\": 11, \"posicoes\": " +
+                                 std::to_string(pares.sondagens())) != std::string::npos);
+
+    ativar_estatisticas(true);
+    ativar_estatisticas(false);
+    contar_palavras_arquivo("estatisticas.txt");
+    relatorio.str("");
+    imprimir_estatisticas(relatorio);
+    REQUIRE(relatorio.str().find("\"etapa\"") == std::string::npos);
+    REQUIRE(relatorio.str().find("\"buscas\": 0,") != std::string::npos);
+
+    std::uint64_t alocacoes = alocacoes_da_thread();
+    std::uint64_t bytes = bytes_alocados_da_thread();
+    std::unique_ptr<std::uint64_t> valor(new std::uint64_t(1));
+    REQUIRE(alocacoes_da_thread() == alocacoes);
+    REQUIRE(bytes_alocados_da_thread() == bytes);
+    std::remove("estatisticas.txt");
+}
+
+/**
+ * \brief Testa o tokenizador com regras de pontuação e de números.
+ * 
+ * Verifica a classe dos caracteres na tabela e nos intervalos, a remoção e a separação da
+ * pontuação, o descarte de números e se o contador incremental, alimentado byte a byte, produz a
+ * mesma contagem que `contar_palavras` com a mesma configuração.
+ */
+TEST_CASE("Tokenizador com pontuacao configuravel", "[tokenizador]") {
+    REQUIRE(classe_caractere(L'a') == CLASSE_LETRA);
+    REQUIRE(classe_caractere(L'ç') == CLASSE_LETRA);
+    REQUIRE(classe_caractere(L'7') == CLASSE_DIGITO);
+    REQUIRE(classe_caractere(L'.') == CLASSE_PONTUACAO);
+    REQUIRE(classe_caractere(L'\n') == CLASSE_ESPACO);
+    REQUIRE(classe_caractere(0x00A0) == CLASSE_PONTUACAO);
+    REQUIRE(classe_caractere(0x2014) == CLASSE_PONTUACAO);
+    REQUIRE(classe_caractere(0x3000) == CLASSE_ESPACO);
+    REQUIRE(classe_caractere(0xFF10) == CLASSE_DIGITO);
+    REQUIRE(classe_caractere(0x4E2D) == CLASSE_LETRA);
+
+    std::wstring texto = L"Teste. teste, \"TESTE\" guarda-chuva 2025 (d'água) ... 3,5";
+    REQUIRE(contar_palavras(texto).count(L"teste.") == 1);
+
+    std::map<std::wstring, int> removida = {{L"teste", 3}, {L"guarda-chuva", 1}, {L"2025", 1},
+                                            {L"d'água", 1}, {L"3,5", 1}};
+    REQUIRE(contar_palavras(texto, CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO) == removida);
+
+    std::map<std::wstring, int> separada = {{L"teste", 3}, {L"guarda", 1}, {L"chuva", 1}, {L"2025", 1},
+                                            {L"d", 1},     {L"água", 1},  {L"3", 1},     {L"5", 1}};
+    std::uint32_t separar = CONFIGURACAO_PADRAO | TOKENIZADOR_SEPARAR_PONTUACAO;
+    REQUIRE(contar_palavras(texto, separar) == separada);
+    REQUIRE(contar_palavras(texto, separar | TOKENIZADOR_IGNORAR_NUMEROS).count(L"2025") == 0);
+    REQUIRE(contar_palavras(texto, separar | TOKENIZADOR_IGNORAR_NUMEROS).size() == 5);
+    REQUIRE(tokenizar(L"Sim! Não?", TOKENIZADOR_REMOVER_PONTUACAO) == std::vector<std::wstring>({L"Sim", L"Não"}));
+
+    std::uint32_t configuracao = CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO;
+    ContadorIncremental contador(configuracao);
+    std::vector<std::uint64_t> deslocamentos;
+    contador.observar_palavras([&deslocamentos](const std::wstring&, std::uint64_t deslocamento) {
+        deslocamentos.push_back(deslocamento);
+    });
+    std::string utf8 = para_utf8(texto);
+    for (char byte : utf8) {
+        contador.alimentar(&byte, 1);
+    }
+    contador.finalizar();
+    REQUIRE(contador.contagem() == removida);
+    REQUIRE(deslocamentos.size() == 7);
+    REQUIRE(deslocamentos[2] == utf8.find("TESTE"));
+    REQUIRE(deslocamentos[5] == utf8.find("d'"));
+}
+
+/**
+ * \brief Testa o segmentador de palavras do UAX #29.
+ * 
+ * Verifica as fronteiras em casos das regras do UAX #29 (separadores internos, quebras de linha,
+ * marcas combinantes, emojis e bandeiras), se a concatenação dos segmentos é o texto original e se
+ * a contagem com `TOKENIZADOR_UAX29` é a mesma com o contador incremental alimentado byte a byte.
+ */
+TEST_CASE("Segmentador de palavras do UAX 29", "[segmentador]") {
+    REQUIRE(segmentar(L"d'água, 3,5.") == std::vector<std::wstring>({L"d'água", L",", L" ", L"3,5", L"."}));
+    REQUIRE(segmentar(L"www.exemplo.com") == std::vector<std::wstring>({L"www.exemplo.com"}));
+    REQUIRE(segmentar(L"guarda-chuva") == std::vector<std::wstring>({L"guarda-chuva"}));
+    REQUIRE(segmentar(L"2025-10-19") == std::vector<std::wstring>({L"2025", L"-", L"10", L"-", L"19"}));
+    REQUIRE(segmentar(L"a\r\n\nb") == std::vector<std::wstring>({L"a", L"\r\n", L"\n", L"b"}));
+    REQUIRE(segmentar(L"a\u0301gua  x") == std::vector<std::wstring>({L"a\u0301gua", L"  ", L"x"}));
+    REQUIRE(segmentar(L"\U0001F469\u200D\U0001F4BB!") ==
+            std::vector<std::wstring>({L"\U0001F469\u200D\U0001F4BB", L"!"}));
+    REQUIRE(segmentar(L"\U0001F1E7\U0001F1F7\U0001F1F5\U0001F1F9") ==
+            std::vector<std::wstring>({L"\U0001F1E7\U0001F1F7", L"\U0001F1F5\U0001F1F9"}));
+    REQUIRE(segmentar(L"\u05D0\"\u05D1 \u4E2D\u6587") ==
+            std::vector<std::wstring>({L"\u05D0\"\u05D1", L" ", L"\u4E2D", L"\u6587"}));
+
+    std::wstring texto = L"Ele disse: \"d'água\" (guarda-chuva), 3,5 e 2025-10-19... www.exemplo.com \U0001F600";
+    std::wstring concatenado;
+    for (const std::wstring& segmento : segmentar(texto)) {
+        concatenado += segmento;
+    }
+    REQUIRE(concatenado == texto);
+
+    std::uint32_t configuracao = CONFIGURACAO_PADRAO | TOKENIZADOR_UAX29;
+    std::map<std::wstring, int> esperada = {{L"ele", 1},  {L"disse", 1}, {L"d'água", 1}, {L"guarda-chuva", 1},
+                                            {L"3,5", 1},  {L"e", 1},     {L"2025", 1},   {L"10", 1},
+                                            {L"19", 1},   {L"www.exemplo.com", 1}};
+    REQUIRE(contar_palavras(texto, configuracao) == esperada);
+    REQUIRE(contar_palavras(texto, configuracao | TOKENIZADOR_IGNORAR_NUMEROS).size() == 6);
+    REQUIRE(contar_palavras(texto, configuracao | TOKENIZADOR_SEPARAR_PONTUACAO).count(L"guarda") == 1);
+
+    ContadorIncremental contador(configuracao);
+    std::string utf8 = para_utf8(texto);
+    for (char byte : utf8) {
+        contador.alimentar(&byte, 1);
+    }
+    contador.finalizar();
+    REQUIRE(contador.contagem() == esperada);
+}
+
+/**
+ * \brief Testa a contagem com chaves sem acentos.
+ * 
+ * Verifica a tabela de remoção de acentos, a contagem em memória e a de arquivo, que decodifica e
+ * normaliza na mesma passada, a ordenação de chaves já sem acentos e o deslocamento das partes de
+ * uma palavra dividida no contador incremental.
+ */
+TEST_CASE("Chaves sem acentos na mesma passada", "[tokenizador]") {
+    REQUIRE(remover_acento(L'é') == L'e');
+    REQUIRE(remover_acento(L'Ç') == L'C');
+    REQUIRE(remover_acento(L'ø') == L'ø');
+    REQUIRE(remover_acento(0x0301) == 0);
+    REQUIRE(remover_acentos(L"Ação e\u0301") == L"Acao e");
+
+    std::uint32_t configuracao = CONFIGURACAO_PADRAO | TOKENIZADOR_SEM_ACENTOS;
+    std::map<std::wstring, int> esperada = {{L"sera", 3}, {L"e", 2}, {L"\uFFFD", 1}};
+    REQUIRE(contar_palavras(L"Será sera SERÁ e\u0301 É \uFFFD", configuracao) == esperada);
+    {
+        std::ofstream arquivo("acentos.txt", std::ios::binary);
+        arquivo << "Ser\xc3\xa1 sera SER\xc3\x81\ne\xcc\x81 \xc3\x89 \xff";
+    }
+    REQUIRE(contar_palavras_arquivo("acentos.txt", configuracao) == esperada);
+    std::remove("acentos.txt");
+
+    std::map<std::wstring, int> contagem = {{L"zebra", 1}, {L"ovo", 1}, {L"ótimo", 1}};
+    REQUIRE(ordenar_palavras(contagem) == std::vector<std::wstring>({L"ótimo", L"ovo", L"zebra"}));
+    REQUIRE(ordenar_palavras(esperada, configuracao) == std::vector<std::wstring>({L"e", L"sera", L"\uFFFD"}));
+
+    ContadorIncremental contador(configuracao | TOKENIZADOR_REMOVER_PONTUACAO);
+    std::vector<std::uint64_t> deslocamentos;
+    contador.observar_palavras([&deslocamentos](const std::wstring&, std::uint64_t deslocamento) {
+        deslocamentos.push_back(deslocamento);
+    });
+    std::string utf8 = para_utf8(L"«Ação» é");
+    contador.alimentar(utf8.data(), utf8.size());
+    contador.finalizar();
+    std::map<std::wstring, int> partes = {{L"acao", 1}, {L"e", 1}};
+    REQUIRE(contador.contagem() == partes);
+    REQUIRE(deslocamentos == std::vector<std::uint64_t>({2, utf8.find("\xc3\xa9")}));
+}
+
+/**
+ * \brief Testa a conversão para minúsculas pelas tabelas geradas.
+ * 
+ * Verifica o Simple_Case_Folding fora do ASCII, sem nenhuma localidade configurada, e se o trecho
+ * ASCII convertido em grupos de quatro caracteres produz o mesmo resultado da conversão um a um.
+ */
+TEST_CASE("Minusculas independentes da localidade", "[tokenizador]") {
+    REQUIRE(converter_minuscula(L'Q') == L'q');
+    REQUIRE(converter_minuscula(L'Á') == L'á');
+    REQUIRE(converter_minuscula(L'Ç') == L'ç');
+    REQUIRE(converter_minuscula(0x03A3) == 0x03C3);  // Σ
+    REQUIRE(converter_minuscula(0x03C2) == 0x03C3);  // ς
+    REQUIRE(converter_minuscula(0x017F) == L's');    // ſ
+    REQUIRE(converter_minuscula(0x1E9E) == 0x00DF);  // ẞ
+    REQUIRE(converter_minuscula(0x10400) == 0x10428);
+    REQUIRE(converter_minuscula(0xAB70) == 0x13A0);
+    REQUIRE(converter_minuscula(0x4E2D) == 0x4E2D);
+    REQUIRE(converter_minuscula(static_cast<wchar_t>(0x110000)) == static_cast<wchar_t>(0x110000));
+
+    std::map<std::wstring, int> esperada = {{L"água", 3}, {L"σοφία", 2}};
+    REQUIRE(contar_palavras(L"ÁGUA Água água ΣΟΦΊΑ σοφία") == esperada);
+
+    std::wstring palavra = L"ABCDEFGHIJKLMNOPQRSTUVWXYZ@[`{abcXYZ0ÇÃO";
+    std::wstring convertida;
+    normalizar_chave(palavra.data(), palavra.data() + palavra.size(), TOKENIZADOR_MINUSCULAS, convertida);
+    REQUIRE(convertida == L"abcdefghijklmnopqrstuvwxyz@[`{abcxyz0ção");
+    std::wstring destino(palavra.size(), L' ');
+    std::size_t convertidos = copiar_minusculas_ascii(palavra.data(), palavra.data() + palavra.size(), &destino[0]);
+    REQUIRE(convertidos <= palavra.find(L'Ç'));
+    REQUIRE(destino.substr(0, convertidos) == convertida.substr(0, convertidos));
+}
+
+/**
+ * \brief Tarefa de teste para `despachar_normalizacao`: codifica a política escolhida em um número.
+ */
+template <typename Politica>
+struct PoliticaEscolhida {
+    static int executar(int base) { return base + (Politica::minusculas ? 1 : 0) + (Politica::sem_acentos ? 2 : 0); }
+};
+
+/**
+ * \brief Testa as políticas de normalização compiladas como modelos.
+ * 
+ * Verifica cada política isoladamente, a escolha da política pela configuração e se, para cada
+ * combinação de normalização e de regras de pontuação, a contagem em memória e a do contador
+ * incremental, alimentado byte a byte, são iguais.
+ */
+TEST_CASE("Politicas de normalizacao", "[tokenizador]") {
+    typedef PoliticaNormalizacao<false, false> Original;
+    typedef PoliticaNormalizacao<true, false> Minusculas;
+    typedef PoliticaNormalizacao<false, true> SemAcentos;
+    typedef PoliticaNormalizacao<true, true> Completa;
+    REQUIRE(Original::normalizar(L'É') == L'É');
+    REQUIRE(Minusculas::normalizar(L'É') == L'é');
+    REQUIRE(SemAcentos::normalizar(L'É') == L'E');
+    REQUIRE(Completa::normalizar(L'É') == L'e');
+    REQUIRE(Completa::normalizar(0x0301) == 0);
+    REQUIRE(Minusculas::normalizar_ascii(L'Q') == L'q');
+    REQUIRE(SemAcentos::normalizar_ascii(L'Q') == L'Q');
+
+    REQUIRE(despachar_normalizacao<PoliticaEscolhida>(0, 10) == 10);
+    REQUIRE(despachar_normalizacao<PoliticaEscolhida>(TOKENIZADOR_MINUSCULAS | TOKENIZADOR_UAX29, 10) == 11);
+    REQUIRE(despachar_normalizacao<PoliticaEscolhida>(TOKENIZADOR_SEM_ACENTOS, 10) == 12);
+    REQUIRE(despachar_normalizacao<PoliticaEscolhida>(TOKENIZADOR_MINUSCULAS | TOKENIZADOR_SEM_ACENTOS, 10) == 13);
+
+    std::wstring texto = L"Já JÁ já ja (Ação) ação, ACAO e\u0301 É 2025 d'água";
+    std::string utf8 = para_utf8(texto);
+    const std::uint32_t normalizacoes[] = {0, TOKENIZADOR_MINUSCULAS, TOKENIZADOR_SEM_ACENTOS,
+                                           TOKENIZADOR_MINUSCULAS | TOKENIZADOR_SEM_ACENTOS};
+    const std::uint32_t regras[] = {0, TOKENIZADOR_REMOVER_PONTUACAO, TOKENIZADOR_UAX29 | TOKENIZADOR_IGNORAR_NUMEROS};
+    std::size_t distintas[4];
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::uint32_t regra : regras) {
+            std::uint32_t configuracao = normalizacoes[i] | regra;
+            ContadorIncremental contador(configuracao);
+            for (char byte : utf8) {
+                contador.alimentar(&byte, 1);
+            }
+            contador.finalizar();
+            REQUIRE(contador.contagem() == contar_palavras(texto, configuracao));
+            REQUIRE(tokenizar(texto, configuracao).size() == static_cast<std::size_t>(
+                        std::accumulate(contador.contagem().begin(), contador.contagem().end(), 0,
+                                        [](int total, const std::pair<const std::wstring, int>& par) {
+                                            return total + par.second;
+                                        })));
+        }
+        distintas[i] = contar_palavras(texto, normalizacoes[i] | TOKENIZADOR_REMOVER_PONTUACAO).size();
+    }
+    REQUIRE(distintas[0] == 11);
+    REQUIRE(distintas[1] == 8);
+    REQUIRE(distintas[2] == 10);
+    REQUIRE(distintas[3] == 5);
+}
+
+/**
+ * \brief Testa a contagem agrupada sem acentos com as formas originais.
+ * 
+ * Verifica se as chaves e os totais são os da contagem sem acentos, se cada chave exibe a forma
+ * mais frequente (a primeira, em caso de empate) e se o contador incremental, alimentado byte a
+ * byte, chega à mesma contagem agrupada.
+ */
+TEST_CASE("Contagem agrupada com formas", "[formas]") {
+    std::wstring texto = L"Será sera será. SERA Café cafe (cafe) e\u0301 é pé pe";
+    for (std::uint32_t configuracao : {CONFIGURACAO_PADRAO, CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO}) {
+        ContagemFormas formas = contar_formas(texto, configuracao);
+        std::map<std::wstring, int> agrupada = contar_palavras(texto, configuracao | TOKENIZADOR_SEM_ACENTOS);
+        REQUIRE(formas.size() == agrupada.size());
+        for (const auto& par : agrupada) {
+            REQUIRE(formas.count(par.first) == 1);
+            REQUIRE(formas.at(par.first).total == par.second);
+        }
+
+        ContadorIncremental contador(configuracao);
+        contador.agrupar_formas();
+        std::string utf8 = para_utf8(texto);
+        for (char byte : utf8) {
+            contador.alimentar(&byte, 1);
+        }
+        contador.finalizar();
+        REQUIRE(contador.contagem().empty());
+        REQUIRE(contador.formas().size() == formas.size());
+        for (const auto& par : formas) {
+            REQUIRE(contador.formas().at(par.first).total == par.second.total);
+            REQUIRE(contador.formas().at(par.first).iguais == par.second.iguais);
+            REQUIRE(contador.formas().at(par.first).formas == par.second.formas);
+        }
+    }
+
+    ContagemFormas formas = contar_formas(texto, CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO);
+    REQUIRE(formas.at(L"sera").total == 4);
+    REQUIRE(formas.at(L"sera").forma(L"sera") == L"será");
+    REQUIRE(formas.at(L"cafe").forma(L"cafe") == L"cafe");
+    REQUIRE(formas.at(L"e").forma(L"e") == L"e\u0301");
+    REQUIRE(formas.at(L"pe").forma(L"pe") == L"pé");
+    REQUIRE(formas.at(L"pe").iguais == 1);
+    REQUIRE(formas.at(L"pe").formas.size() == 1);
+
+    std::vector<std::pair<std::wstring, int>> frequentes = mais_frequentes(formas, 2);
+    REQUIRE(frequentes.size() == 2);
+    REQUIRE(frequentes[0] == std::make_pair(std::wstring(L"será"), 4));
+    REQUIRE(frequentes[1] == std::make_pair(std::wstring(L"cafe"), 3));
+}
+
+/**
+ * \brief Testa a conversão para as formas normais NFC e NFD.
+ * 
+ * Verifica a composição e a decomposição de acentos, de sílabas do hangul e de marcas fora da
+ * ordem canônica, se a verificação rápida aceita o texto já normalizado e se a contagem e o
+ * contador incremental, alimentado byte a byte, juntam as duas grafias de "é".
+ */
+TEST_CASE("Formas normais NFC e NFD", "[forma_normal]") {
+    REQUIRE(converter_forma_normal(L"e\u0301", true) == L"\u00E9");
+    REQUIRE(converter_forma_normal(L"\u00E9", false) == L"e\u0301");
+    REQUIRE(converter_forma_normal(L"\uD55C", false) == L"\u1112\u1161\u11AB");
+    REQUIRE(converter_forma_normal(L"\u1112\u1161\u11AB", true) == L"\uD55C");
+    REQUIRE(converter_forma_normal(L"a\u0301\u0323", false) == L"a\u0323\u0301");
+    REQUIRE(converter_forma_normal(L"a\u0301\u0323", true) == L"\u1EA1\u0301");
+    REQUIRE(converter_forma_normal(L"\u0301e", true) == L"\u0301e");
+    REQUIRE(converter_forma_normal(L"\u212B", true) == L"\u00C5");
+
+    std::wstring normalizado = L"Ação, coração e café à 3,5 °C";
+    const wchar_t* fim = normalizado.data() + normalizado.size();
+    REQUIRE(fim_forma_normal(normalizado.data(), fim, true) == fim);
+    REQUIRE(converter_forma_normal(normalizado, true) == normalizado);
+
+    std::wstring texto = L"Café cafe\u0301 CAFE\u0301 é e\u0301 pé.";
+    for (std::uint32_t forma : {TOKENIZADOR_NFC, TOKENIZADOR_NFD}) {
+        for (std::uint32_t regras : {CONFIGURACAO_PADRAO, CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO,
+                                     CONFIGURACAO_PADRAO | TOKENIZADOR_SEM_ACENTOS}) {
+            std::uint32_t configuracao = regras | forma;
+            std::map<std::wstring, int> contagem = contar_palavras(texto, configuracao);
+            ContadorIncremental contador(configuracao);
+            std::string utf8 = para_utf8(texto);
+            for (char byte : utf8) {
+                contador.alimentar(&byte, 1);
+            }
+            contador.finalizar();
+            REQUIRE(contador.contagem() == contagem);
+        }
+    }
+    std::map<std::wstring, int> composta = contar_palavras(texto, CONFIGURACAO_PADRAO | TOKENIZADOR_NFC);
+    REQUIRE(composta.size() == 3);
+    REQUIRE(composta.at(L"caf\u00E9") == 3);
+    REQUIRE(composta.at(L"\u00E9") == 2);
+    std::map<std::wstring, int> decomposta = contar_palavras(texto, CONFIGURACAO_PADRAO | TOKENIZADOR_NFD);
+    REQUIRE(decomposta.at(L"cafe\u0301") == 3);
+    REQUIRE(contar_palavras(texto).size() == 5);
+
+    ContagemFormas formas = contar_formas(texto, CONFIGURACAO_PADRAO | TOKENIZADOR_NFC);
+    REQUIRE(formas.at(L"cafe").total == 3);
+    REQUIRE(formas.at(L"cafe").forma(L"cafe") == L"caf\u00E9");
+}
+
+/**
+ * \brief Testa o filtro de palavras vazias com hash perfeito mínimo.
+ * 
+ * Verifica se o filtro encontra todas as palavras da lista e nenhuma outra (e se o filtro vazio
+ * recusa até a chave vazia), se as palavras são normalizadas com a configuração da contagem, se o
+ * filtro de cada normalização é compilado uma vez, se a contagem e o contador incremental
+ * descartam as palavras vazias, se a lista pode ser lida de um arquivo e se trocar a lista não
+ * invalida o filtro de um contador em andamento.
+ */
+TEST_CASE("Filtro de palavras vazias", "[palavras_vazias]") {
+    FiltroPalavrasVazias vazio;
+    REQUIRE(vazio.tamanho() == 0);
+    REQUIRE_FALSE(vazio.contem(L"de"));
+    REQUIRE_FALSE(vazio.contem(std::wstring()));
+    REQUIRE_FALSE(FiltroPalavrasVazias({L"", L"\u0301"}, CONFIGURACAO_PADRAO | TOKENIZADOR_SEM_ACENTOS).contem(L""));
+
+    FiltroPalavrasVazias filtro(palavras_vazias(), CONFIGURACAO_PADRAO);
+    REQUIRE(filtro.tamanho() == palavras_vazias().size());
+    for (const std::wstring& palavra : palavras_vazias()) {
+        REQUIRE(filtro.contem(palavra));
+    }
+    for (const wchar_t* palavra : {L"casa", L"gato", L"des", L"q", L"", L"estivéssemoss", L"Que"}) {
+        REQUIRE_FALSE(filtro.contem(palavra));
+    }
+    FiltroPalavrasVazias sem_acentos(palavras_vazias(), CONFIGURACAO_PADRAO | TOKENIZADOR_SEM_ACENTOS);
+    REQUIRE(sem_acentos.tamanho() < filtro.tamanho());
+    REQUIRE(sem_acentos.contem(L"nao"));
+    REQUIRE_FALSE(sem_acentos.contem(L"não"));
+
+    const std::uint32_t com_filtro = CONFIGURACAO_PADRAO | TOKENIZADOR_SEM_PALAVRAS_VAZIAS;
+    REQUIRE(filtro_palavras_vazias(com_filtro) == filtro_palavras_vazias(com_filtro | TOKENIZADOR_UAX29));
+    REQUIRE(filtro_palavras_vazias(com_filtro) != filtro_palavras_vazias(com_filtro | TOKENIZADOR_SEM_ACENTOS));
+    REQUIRE(filtro_palavras_vazias(com_filtro | TOKENIZADOR_SEM_ACENTOS)->contem(L"nao"));
+    REQUIRE(filtro_palavras_vazias(CONFIGURACAO_PADRAO)->tamanho() == 0);
+
+    std::wstring texto = L"O gato e o rato. É que correm de Casa em casa, não?";
+    for (std::uint32_t regras : {CONFIGURACAO_PADRAO, CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO,
+                                 CONFIGURACAO_PADRAO | TOKENIZADOR_SEM_ACENTOS | TOKENIZADOR_UAX29}) {
+        std::uint32_t configuracao = regras | TOKENIZADOR_SEM_PALAVRAS_VAZIAS;
+        std::map<std::wstring, int> contagem = contar_palavras(texto, configuracao);
+        ContadorIncremental contador(configuracao);
+        std::string utf8 = para_utf8(texto);
+        for (char byte : utf8) {
+            contador.alimentar(&byte, 1);
+        }
+        contador.finalizar();
+        REQUIRE(contador.contagem() == contagem);
+    }
+    std::map<std::wstring, int> esperado = {{L"gato", 1}, {L"rato", 1}, {L"correm", 1}, {L"casa", 2}};
+    REQUIRE(contar_palavras(texto, CONFIGURACAO_PADRAO | TOKENIZADOR_UAX29 | TOKENIZADOR_SEM_PALAVRAS_VAZIAS) ==
+            esperado);
+
+    {
+        std::ofstream arquivo("vazias.txt", std::ios::binary);
+        arquivo << "# lista de teste\ngato\n\n  rato \r\ncasa\n";
+    }
+    std::vector<std::wstring> lista = ler_palavras_vazias("vazias.txt");
+    std::remove("vazias.txt");
+    REQUIRE(lista == std::vector<std::wstring>({L"gato", L"rato", L"casa"}));
+    std::vector<std::wstring> padrao = palavras_vazias();
+    ContadorIncremental em_andamento(com_filtro);
+    em_andamento.alimentar("o gato ", 7);
+    definir_palavras_vazias(lista);
+    REQUIRE(filtro_palavras_vazias(com_filtro)->contem(L"gato"));
+    // A contagem em andamento continua com o filtro da lista anterior
+    em_andamento.alimentar("e o rato", 8);
+    em_andamento.finalizar();
+    esperado = {{L"gato", 1}, {L"rato", 1}};
+    REQUIRE(em_andamento.contagem() == esperado);
+    esperado = {{L"o", 2}, {L"e", 1}, {L"é", 1}, {L"que", 1}, {L"correm", 1}, {L"de", 1}, {L"em", 1}, {L"não", 1}};
+    REQUIRE(contar_palavras(texto, CONFIGURACAO_PADRAO | TOKENIZADOR_UAX29 | TOKENIZADOR_SEM_PALAVRAS_VAZIAS) ==
+            esperado);
+    definir_palavras_vazias(padrao);
+    REQUIRE_THROWS_AS(ler_palavras_vazias("inexistente.txt"), const std::ios_base::failure&);
+}
+
+/**
+ * \brief Testa a extração de radicais do RSLP e a contagem por radical.
+ * 
+ * Verifica os radicais de palavras que passam por cada etapa, as exceções, a aplicação das regras
+ * às chaves sem acentos e se a contagem por radical soma as contagens das palavras.
+ */
+TEST_CASE("Radicais do RSLP", "[radicais]") {
+    ExtratorRadicais extrator(CONFIGURACAO_PADRAO);
+    REQUIRE(extrator.radical(L"casas") == L"cas");
+    REQUIRE(extrator.radical(L"gatinhos") == L"gat");
+    REQUIRE(extrator.radical(L"meninas") == L"menin");
+    REQUIRE(extrator.radical(L"felizmente") == L"feliz");
+    REQUIRE(extrator.radical(L"professora") == L"profes");
+    REQUIRE(extrator.radical(L"cantaríamos") == L"cant");
+    REQUIRE(extrator.radical(L"correndo") == L"corr");
+    REQUIRE(extrator.radical(L"organização") == L"organiz");
+    REQUIRE(extrator.radical(L"mães") == L"mae");
+    REQUIRE(extrator.radical(L"lápis") == L"lapis");
+    REQUIRE(extrator.radical(L"de") == L"de");
+    REQUIRE(extrator.radical(L"") == L"");
+
+    ExtratorRadicais sem_acentos(CONFIGURACAO_PADRAO | TOKENIZADOR_SEM_ACENTOS);
+    REQUIRE(sem_acentos.radical(L"cantariamos") == L"cant");
+    REQUIRE(sem_acentos.radical(L"lapis") == L"lapis");
+
+    std::wstring texto = L"O gato e os gatinhos. Casas, casa e casinha; cantava e cantaríamos.";
+    for (std::uint32_t configuracao : {CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO,
+                                       CONFIGURACAO_PADRAO | TOKENIZADOR_UAX29 | TOKENIZADOR_SEM_ACENTOS,
+                                       CONFIGURACAO_PADRAO | TOKENIZADOR_UAX29 | TOKENIZADOR_NFD}) {
+        std::map<std::wstring, int> radicais = contar_radicais(contar_palavras(texto, configuracao), configuracao);
+        REQUIRE(radicais.at(L"gat") == 2);
+        REQUIRE(radicais.at(L"cas") == 3);
+        REQUIRE(radicais.at(L"cant") == 2);
+        REQUIRE(radicais.at(L"e") == 3);
+    }
+}
+
+/**
+ * \brief Testa a contagem de bigramas e trigramas sobre identificadores de palavras.
+ * 
+ * Verifica as contagens contra a concatenação das janelas de `tokenizar`, a ordem dos mais
+ * frequentes, o crescimento da tabela, a interrupção da janela, se a leitura de um descritor
+ * chega à mesma contagem e se o contador que só entrega as palavras ao observador não as conta.
+ */
+TEST_CASE("Contagem de n-gramas", "[ngramas]") {
+    REQUIRE_THROWS_AS(ContagemNgramas(1), const std::invalid_argument&);
+    REQUIRE_THROWS_AS(ContagemNgramas(MAXIMO_NGRAMA + 1), const std::invalid_argument&);
+
+    std::wstring texto = L"O gato viu o rato. O gato viu o cão, e o rato viu o gato.";
+    const std::uint32_t configuracao = CONFIGURACAO_PADRAO | TOKENIZADOR_REMOVER_PONTUACAO;
+    std::vector<std::wstring> palavras = tokenizar(texto, configuracao);
+    for (std::size_t n = 2; n <= MAXIMO_NGRAMA; ++n) {
+        std::map<std::wstring, int> esperado;
+        for (std::size_t i = 0; i + n <= palavras.size(); ++i) {
+            std::wstring ngrama = palavras[i];
+            for (std::size_t j = 1; j < n; ++j) {
+                ngrama += L' ' + palavras[i + j];
+            }
+            ++esperado[ngrama];
+        }
+        ContagemNgramas contagem = contar_ngramas(texto, n, configuracao);
+        REQUIRE(contagem.para_mapa() == esperado);
+        REQUIRE(contagem.tamanho() == esperado.size());
+        REQUIRE(contagem.total() == palavras.size() - n + 1);
+        REQUIRE(contagem.mais_frequentes(0) == mais_frequentes(esperado, 0));
+        for (const auto& par : esperado) {
+            REQUIRE(contagem.contagem(par.first) == par.second);
+        }
+    }
+
+    ContagemNgramas bigramas = contar_ngramas(texto, 2, configuracao);
+    REQUIRE(bigramas.contagem(L"o gato") == 3);
+    REQUIRE(bigramas.contagem(L"gato o") == 0);
+    REQUIRE(bigramas.contagem(L"o") == 0);
+    REQUIRE(bigramas.contagem(L"o gato viu") == 0);
+    std::vector<std::pair<std::wstring, int>> frequentes = bigramas.mais_frequentes(2);
+    REQUIRE(frequentes.size() == 2);
+    REQUIRE(frequentes[0] == std::make_pair(std::wstring(L"o gato"), 3));
+    REQUIRE(frequentes[1] == std::make_pair(std::wstring(L"viu o"), 3));
+    REQUIRE(contar_ngramas(texto, 3, configuracao).contagem(L"o gato viu") == 2);
+
+    ContagemNgramas interrompida(2);
+    for (int i = 0; i < 5000; ++i) {
+        interrompida.adicionar(std::to_wstring(i));
+        interrompida.adicionar(std::to_wstring(i + 1));
+        interrompida.interromper();
+    }
+    REQUIRE(interrompida.tamanho() == 5000);
+    REQUIRE(interrompida.contagem(L"4999 5000") == 1);
+    REQUIRE(interrompida.contagem(L"1 1") == 0);
+
+    {
+        std::ofstream arquivo("ngramas.txt", std::ios::binary);
+        arquivo << para_utf8(texto);
+    }
+    {
+        Arquivo arquivo = abrir_arquivo("ngramas.txt");
+        REQUIRE(contar_ngramas_fluxo(arquivo.descritor(), 3, configuracao).para_mapa() ==
+                contar_ngramas(texto, 3, configuracao).para_mapa());
+    }
+
+    std::vector<std::wstring> observadas;
+    ContadorIncremental contador(configuracao);
+    contador.observar_palavras([&observadas](const std::wstring& palavra, std::uint64_t) {
+        observadas.push_back(palavra);
+    }, false);
+    std::string utf8 = para_utf8(texto);
+    contador.alimentar(utf8.data(), utf8.size());
+    contador.finalizar();
+    REQUIRE(observadas == palavras);
+    REQUIRE(contador.contagem().empty());
+    std::remove("ngramas.txt");
+}
+
 /**
  * \brief Testa as funções de contagem e ordenação de palavras com leitura de arquivo existente.
  * 
@@ -0,0 +1,110 @@
+/**
+ * \file tokenizador.cpp
+ * \brief Implementação do tokenizador configurável usado na contagem de palavras.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "tokenizador.hpp"
+
+#include <algorithm>
+#include <cwchar>
+#include <string>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * \brief Classifica um caractere acima de `LIMITE_TABELA_CLASSES` por busca binária nos intervalos.
+ *
+ * Os caracteres fora de todos os intervalos são letras.
+ *
+ * \param ponto_codigo O ponto de código a classificar.
+ * \return A classe do caractere.
+ */
+ClasseCaractere classe_caractere_extenso(std::uint32_t ponto_codigo) {
+    const IntervaloClasse* fim = INTERVALOS_CLASSES + NUMERO_INTERVALOS_CLASSES;
+    const IntervaloClasse* intervalo = std::upper_bound(
+        INTERVALOS_CLASSES, fim, ponto_codigo,
+        [](std::uint32_t ponto, const IntervaloClasse& atual) { return ponto < atual.inicio; });
+    if (intervalo == INTERVALOS_CLASSES || ponto_codigo > intervalo[-1].fim) {
+        return CLASSE_LETRA;
+    }
+    return intervalo[-1].classe;
+}
+
+/**
+ * \brief Copia para minúsculas o trecho inicial de uma palavra que só tem caracteres ASCII.
+ *
+ * Cada grupo de quatro caracteres de 32 bits é comparado de uma vez com o intervalo do ASCII e
+ * com o de "A" a "Z"; as maiúsculas recebem a diferença para as minúsculas por uma máscara, sem
+ * desvios por caractere.
+ *
+ * \param inicio O primeiro caractere da palavra.
+ * \param fim O caractere seguinte ao último.
+ * \param destino Recebe os caracteres convertidos; deve ter espaço para a palavra inteira.
+ * \return O número de caracteres convertidos, múltiplo de quatro.
+ */
+std::size_t copiar_minusculas_ascii(const wchar_t* inicio, const wchar_t* fim, wchar_t* destino) {
+    const wchar_t* atual = inicio;
+#if defined(__SSE2__) && WCHAR_MAX > 0xFFFF
+    const __m128i antes_de_a = _mm_set1_epi32(L'A' - 1);
+    const __m128i depois_de_z = _mm_set1_epi32(L'Z' + 1);
+    const __m128i maximo_ascii = _mm_set1_epi32(0x7F);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i diferenca = _mm_set1_epi32(L'a' - L'A');
+    for (; fim - atual >= 4; atual += 4, destino += 4) {
+        __m128i caracteres = _mm_loadu_si128(reinterpret_cast<const __m128i*>(atual));
+        __m128i fora = _mm_or_si128(_mm_cmpgt_epi32(caracteres, maximo_ascii), _mm_cmplt_epi32(caracteres, zero));
+        if (_mm_movemask_epi8(fora) != 0) {
+            break;
+        }
+        __m128i maiusculas = _mm_and_si128(_mm_cmpgt_epi32(caracteres, antes_de_a),
+                                           _mm_cmplt_epi32(caracteres, depois_de_z));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destino),
+                         _mm_add_epi32(caracteres, _mm_and_si128(maiusculas, diferenca)));
+    }
+#else
+    (void)fim;
+    (void)destino;
+#endif
+    return static_cast<std::size_t>(atual - inicio);
+}
+
+namespace {
+
+/**
+ * \brief Separação de um texto com a política de normalização fixa, para `despachar_normalizacao`.
+ */
+template <typename Politica>
+struct Tokenizacao {
+    static std::vector<std::wstring> executar(const std::wstring& texto, std::uint32_t configuracao) {
+        std::vector<std::wstring> palavras;
+        std::wstring palavra;
+        std::wstring normalizada;
+        percorrer_palavras(texto.data(), texto.data() + texto.size(), configuracao,
+                           [&](const wchar_t* inicio, const wchar_t* fim) {
+                               aplicar_forma_normal(inicio, fim, configuracao, normalizada);
+                               normalizar_chave<Politica>(inicio, fim, palavra);
+                               if (!palavra.empty()) {
+                                   palavras.push_back(palavra);
+                               }
+                           });
+        return palavras;
+    }
+};
+
+}  // namespace
+
+/**
+ * \brief Função para separar um texto em palavras conforme a configuração do tokenizador.
+ *
+ * \param texto O texto a ser separado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return As palavras, normalizadas por `normalizar_chave`.
+ */
+std::vector<std::wstring> tokenizar(const std::wstring& texto, std::uint32_t configuracao) {
+    return despachar_normalizacao<Tokenizacao>(configuracao, texto, configuracao);
+}
@@ -0,0 +1,407 @@
+/**
+ * \file tokenizador.hpp
+ * \brief Definições do tokenizador configurável usado na contagem de palavras.
+ *
+ * O texto é dividido em sequências sem espaços, e cada sequência é depois aparada ou dividida
+ * na pontuação ou segmentada pelas regras do UAX #29, conforme a configuração. A classe de cada
+ * caractere vem das tabelas geradas em `tabelas_unicode.cpp`, sem consultar a localidade: o mesmo
+ * texto produz as mesmas palavras em qualquer ambiente. As funções de divisão são modelos
+ * definidos no cabeçalho, para que a função que recebe cada palavra seja expandida em linha no
+ * laço de contagem.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef TOKENIZADOR_HPP_
+#define TOKENIZADOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "forma_normal.hpp"
+#include "segmentador.hpp"
+#include "tabelas_unicode.hpp"
+
+/**
+ * \brief Bits da configuração do tokenizador, gravada também no cabeçalho do instantâneo.
+ *
+ * Um instantâneo só é comparável a outro, ou a uma contagem nova, se ambos foram produzidos com
+ * a mesma configuração. Com `TOKENIZADOR_REMOVER_PONTUACAO` e `TOKENIZADOR_SEPARAR_PONTUACAO`
+ * ligados ao mesmo tempo, a separação prevalece. Com `TOKENIZADOR_UAX29`, as regras de pontuação
+ * e de números são aplicadas a cada palavra encontrada pelo segmentador. Com `TOKENIZADOR_NFC` e
+ * `TOKENIZADOR_NFD` ligados ao mesmo tempo, a composição prevalece. A lista de palavras vazias
+ * de `TOKENIZADOR_SEM_PALAVRAS_VAZIAS` não é gravada, apenas o bit.
+ */
+enum ConfiguracaoTokenizador : std::uint32_t {
+    TOKENIZADOR_MINUSCULAS = 1u << 0,         ///< Palavras convertidas para minúsculas.
+    TOKENIZADOR_REMOVER_PONTUACAO = 1u << 1,  ///< Pontuação no início e no fim da palavra é removida.
+    TOKENIZADOR_SEPARAR_PONTUACAO = 1u << 2,  ///< Pontuação separa palavras, como um espaço.
+    TOKENIZADOR_IGNORAR_NUMEROS = 1u << 3,    ///< Palavras sem nenhuma letra são descartadas.
+    TOKENIZADOR_UAX29 = 1u << 4,              ///< Palavras delimitadas pelas fronteiras do UAX #29.
+    TOKENIZADOR_SEM_ACENTOS = 1u << 5,        ///< Acentos removidos da chave ("será" conta como "sera").
+    TOKENIZADOR_NFC = 1u << 6,                ///< Palavras convertidas para a forma normal NFC (composta).
+    TOKENIZADOR_NFD = 1u << 7,                ///< Palavras convertidas para a forma normal NFD (decomposta).
+    TOKENIZADOR_SEM_PALAVRAS_VAZIAS = 1u << 8 ///< Palavras vazias ("de", "que"...) não são contadas.
+};
+
+/**
+ * \brief Configuração usada por `contar_palavras`: separação por espaços e minúsculas.
+ */
+const std::uint32_t CONFIGURACAO_PADRAO = TOKENIZADOR_MINUSCULAS;
+
+/**
+ * \brief Classifica um caractere acima de `LIMITE_TABELA_CLASSES` por busca binária nos intervalos.
+ */
+ClasseCaractere classe_caractere_extenso(std::uint32_t ponto_codigo);
+
+/**
+ * \brief Retorna a classe de um caractere para o tokenizador.
+ *
+ * Os caracteres abaixo de U+0800 custam uma leitura na tabela; os demais, uma busca binária.
+ */
+inline ClasseCaractere classe_caractere(wchar_t caractere) {
+    std::uint32_t ponto_codigo = static_cast<std::uint32_t>(caractere);
+    if (ponto_codigo < LIMITE_TABELA_CLASSES) {
+        return static_cast<ClasseCaractere>(TABELA_CLASSES[ponto_codigo]);
+    }
+    return classe_caractere_extenso(ponto_codigo);
+}
+
+/**
+ * \brief Converte um caractere para minúscula pelo Simple_Case_Folding do Unicode.
+ *
+ * Não consulta a localidade: o ASCII é convertido diretamente, e os demais caracteres somam a
+ * diferença guardada na tabela de dois níveis `BLOCOS_MINUSCULAS`.
+ */
+inline wchar_t converter_minuscula(wchar_t caractere) {
+    std::uint32_t ponto_codigo = static_cast<std::uint32_t>(caractere);
+    if (ponto_codigo < 0x80) {
+        return ponto_codigo - L'A' < 26u ? caractere + (L'a' - L'A') : caractere;
+    }
+    if (ponto_codigo >= MAXIMO_PONTO_CODIGO) {
+        return caractere;
+    }
+    return static_cast<wchar_t>(
+        ponto_codigo + BLOCOS_MINUSCULAS[INDICE_MINUSCULAS[ponto_codigo >> DESLOCAMENTO_BLOCO_MINUSCULAS]]
+                                        [ponto_codigo & ((1u << DESLOCAMENTO_BLOCO_MINUSCULAS) - 1)]);
+}
+
+/**
+ * \brief Copia para minúsculas o trecho inicial de uma palavra que só tem caracteres ASCII.
+ *
+ * Com SSE2, converte quatro caracteres por instrução e para no primeiro grupo de quatro com um
+ * caractere fora do ASCII; sem SSE2, não converte nenhum. O restante fica para `converter_minuscula`.
+ *
+ * \param inicio O primeiro caractere da palavra.
+ * \param fim O caractere seguinte ao último.
+ * \param destino Recebe os caracteres convertidos; deve ter espaço para a palavra inteira.
+ * \return O número de caracteres convertidos.
+ */
+std::size_t copiar_minusculas_ascii(const wchar_t* inicio, const wchar_t* fim, wchar_t* destino);
+
+/**
+ * \brief Remove o acento de um caractere, consultando `TABELA_SEM_ACENTOS`.
+ *
+ * \return A letra base, o próprio caractere se ele não tiver acento ou estiver acima da tabela, ou
+ * zero se for uma marca combinante, que deve ser descartada.
+ */
+inline wchar_t remover_acento(wchar_t caractere) {
+    std::uint32_t ponto_codigo = static_cast<std::uint32_t>(caractere);
+    if (ponto_codigo < LIMITE_TABELA_CLASSES) {
+        return static_cast<wchar_t>(TABELA_SEM_ACENTOS[ponto_codigo]);
+    }
+    return caractere;
+}
+
+/**
+ * \brief Política de normalização das chaves, fixada em tempo de compilação.
+ *
+ * Os laços que normalizam caractere a caractere recebem a política como parâmetro de modelo, de
+ * forma que as opções de `TOKENIZADOR_MINUSCULAS` e `TOKENIZADOR_SEM_ACENTOS` são resolvidas pelo
+ * compilador e não há desvios sobre a configuração dentro do laço. O acento é removido antes da
+ * conversão para minúsculas, de forma que as maiúsculas acentuadas do latim ficam na faixa ASCII.
+ *
+ * \tparam Minusculas Se as palavras são convertidas para minúsculas.
+ * \tparam SemAcentos Se os acentos e as marcas combinantes são removidos.
+ */
+template <bool Minusculas, bool SemAcentos>
+struct PoliticaNormalizacao {
+    static const bool minusculas = Minusculas;
+    static const bool sem_acentos = SemAcentos;
+
+    /**
+     * \brief Normaliza um caractere; zero indica uma marca combinante, que deve ser descartada.
+     */
+    static wchar_t normalizar(wchar_t caractere) {
+        if (SemAcentos && (caractere = remover_acento(caractere)) == 0) {
+            return 0;
+        }
+        return Minusculas ? converter_minuscula(caractere) : caractere;
+    }
+
+    /**
+     * \brief Normaliza um caractere ASCII, que nunca tem acento.
+     */
+    static wchar_t normalizar_ascii(wchar_t caractere) {
+        return Minusculas && static_cast<std::uint32_t>(caractere) - L'A' < 26u ? caractere + (L'a' - L'A')
+                                                                                 : caractere;
+    }
+};
+
+/**
+ * \brief Executa `Tarefa<Politica>::executar` com a política correspondente à configuração.
+ *
+ * As quatro políticas possíveis são instanciadas aqui, e a escolha é feita uma única vez, na
+ * entrada da tarefa, e não a cada caractere.
+ *
+ * \tparam Tarefa Modelo de classe com uma função estática `executar`.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \param argumentos Os argumentos repassados a `executar`.
+ * \return O valor retornado por `executar`.
+ */
+template <template <typename> class Tarefa, typename... Argumentos>
+inline auto despachar_normalizacao(std::uint32_t configuracao, Argumentos&&... argumentos)
+    -> decltype(Tarefa<PoliticaNormalizacao<false, false>>::executar(std::forward<Argumentos>(argumentos)...)) {
+    switch (configuracao & (TOKENIZADOR_MINUSCULAS | TOKENIZADOR_SEM_ACENTOS)) {
+        case TOKENIZADOR_MINUSCULAS:
+            return Tarefa<PoliticaNormalizacao<true, false>>::executar(std::forward<Argumentos>(argumentos)...);
+        case TOKENIZADOR_SEM_ACENTOS:
+            return Tarefa<PoliticaNormalizacao<false, true>>::executar(std::forward<Argumentos>(argumentos)...);
+        case TOKENIZADOR_MINUSCULAS | TOKENIZADOR_SEM_ACENTOS:
+            return Tarefa<PoliticaNormalizacao<true, true>>::executar(std::forward<Argumentos>(argumentos)...);
+        default:
+            return Tarefa<PoliticaNormalizacao<false, false>>::executar(std::forward<Argumentos>(argumentos)...);
+    }
+}
+
+/**
+ * \brief Copia uma palavra para a chave de contagem, normalizada pela política.
+ *
+ * A normalização é feita na mesma passada da cópia, e as marcas combinantes removidas não ocupam
+ * posição na chave. Com minúsculas, o trecho inicial ASCII é convertido por
+ * `copiar_minusculas_ascii`. A capacidade da chave é reaproveitada entre as palavras.
+ *
+ * \tparam Politica Uma instância de `PoliticaNormalizacao`.
+ * \param inicio O primeiro caractere da palavra.
+ * \param fim O caractere seguinte ao último.
+ * \param chave Recebe a palavra normalizada; pode ficar vazia se a palavra só tiver marcas.
+ */
+template <typename Politica>
+inline void normalizar_chave(const wchar_t* inicio, const wchar_t* fim, std::wstring& chave) {
+    if (!Politica::minusculas && !Politica::sem_acentos) {
+        chave.assign(inicio, fim);
+        return;
+    }
+    chave.resize(static_cast<std::size_t>(fim - inicio));
+    std::size_t tamanho = 0;
+    if (Politica::minusculas && inicio != fim) {
+        // Caracteres ASCII não têm acentos: o trecho ASCII só precisa da conversão de caixa
+        tamanho = copiar_minusculas_ascii(inicio, fim, &chave[0]);
+        inicio += tamanho;
+    }
+    for (; inicio != fim; ++inicio) {
+        wchar_t caractere = Politica::normalizar(*inicio);
+        if (caractere != 0) {
+            chave[tamanho++] = caractere;
+        }
+    }
+    chave.resize(tamanho);
+}
+
+/**
+ * \brief Tarefa de `despachar_normalizacao` que normaliza uma chave.
+ */
+template <typename Politica>
+struct NormalizacaoChave {
+    static void executar(const wchar_t* inicio, const wchar_t* fim, std::wstring& chave) {
+        normalizar_chave<Politica>(inicio, fim, chave);
+    }
+};
+
+/**
+ * \brief Copia uma palavra para a chave de contagem, normalizada conforme a configuração.
+ *
+ * Escolhe a política a cada chamada; os laços de contagem escolhem uma vez e chamam a versão
+ * com a política fixa.
+ *
+ * \param inicio O primeiro caractere da palavra.
+ * \param fim O caractere seguinte ao último.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \param chave Recebe a palavra normalizada; pode ficar vazia se a palavra só tiver marcas.
+ */
+inline void normalizar_chave(const wchar_t* inicio, const wchar_t* fim, std::uint32_t configuracao,
+                             std::wstring& chave) {
+    despachar_normalizacao<NormalizacaoChave>(configuracao, inicio, fim, chave);
+}
+
+/**
+ * \brief Converte uma palavra para a forma normal Unicode da configuração, se houver uma.
+ *
+ * A palavra já na forma normal, aceita pela verificação rápida, não é copiada: os ponteiros
+ * continuam apontando para ela. Caso contrário, passam a apontar para `normalizada`. A conversão
+ * vem antes de `normalizar_chave`, de forma que as maiúsculas e os acentos são tratados sobre a
+ * forma normal.
+ *
+ * \param inicio O primeiro caractere da palavra; recebe o primeiro da palavra normalizada.
+ * \param fim O caractere seguinte ao último; recebe o seguinte ao último da palavra normalizada.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \param normalizada Recebe a palavra convertida, quando ela não estiver na forma normal.
+ */
+inline void aplicar_forma_normal(const wchar_t*& inicio, const wchar_t*& fim, std::uint32_t configuracao,
+                                 std::wstring& normalizada) {
+    if ((configuracao & (TOKENIZADOR_NFC | TOKENIZADOR_NFD)) == 0) {
+        return;
+    }
+    const bool compor = (configuracao & TOKENIZADOR_NFC) != 0;
+    if (fim_forma_normal(inicio, fim, compor) == fim) {
+        return;
+    }
+    converter_forma_normal(inicio, fim, compor, normalizada);
+    inicio = normalizada.data();
+    fim = inicio + normalizada.size();
+}
+
+/**
+ * \brief Normaliza uma palavra de consulta como as chaves contadas com uma configuração.
+ *
+ * \param palavra A palavra, como digitada.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador` com que as palavras foram contadas.
+ * \return A chave, na forma normal, em minúsculas e sem acentos conforme a configuração.
+ */
+inline std::wstring normalizar_consulta(const std::wstring& palavra, std::uint32_t configuracao) {
+    const wchar_t* inicio = palavra.data();
+    const wchar_t* fim = inicio + palavra.size();
+    std::wstring normalizada;
+    std::wstring chave;
+    aplicar_forma_normal(inicio, fim, configuracao, normalizada);
+    normalizar_chave(inicio, fim, configuracao, chave);
+    return chave;
+}
+
+/**
+ * \brief Indica se a configuração aplica alguma regra além da separação por espaços.
+ */
+inline bool divide_na_pontuacao(std::uint32_t configuracao) {
+    return (configuracao & (TOKENIZADOR_REMOVER_PONTUACAO | TOKENIZADOR_SEPARAR_PONTUACAO |
+                            TOKENIZADOR_IGNORAR_NUMEROS | TOKENIZADOR_UAX29)) != 0;
+}
+
+/**
+ * \brief Aplica as regras de segmentação, de pontuação e de números a uma sequência sem espaços.
+ *
+ * Com `TOKENIZADOR_UAX29`, a sequência é dividida nos segmentos do UAX #29, e os segmentos que são
+ * palavras passam pelas demais regras.
+ *
+ * \param inicio O primeiro caractere da sequência.
+ * \param fim O caractere seguinte ao último.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \param emitir Função chamada com o início e o fim de cada palavra resultante.
+ */
+template <typename Emitir>
+inline void dividir_palavra(const wchar_t* inicio, const wchar_t* fim, std::uint32_t configuracao,
+                            Emitir&& emitir) {
+    if (configuracao & TOKENIZADOR_UAX29) {
+        const std::uint32_t demais = configuracao & ~static_cast<std::uint32_t>(TOKENIZADOR_UAX29);
+        const bool dividir = divide_na_pontuacao(demais);
+        while (inicio != fim) {
+            const wchar_t* final = fim_segmento(inicio, fim);
+            if (segmento_palavra(inicio, final)) {
+                if (dividir) {
+                    dividir_palavra(inicio, final, demais, emitir);
+                } else {
+                    emitir(inicio, final);
+                }
+            }
+            inicio = final;
+        }
+        return;
+    }
+    const bool ignorar_numeros = (configuracao & TOKENIZADOR_IGNORAR_NUMEROS) != 0;
+    if (configuracao & TOKENIZADOR_SEPARAR_PONTUACAO) {
+        while (inicio != fim) {
+            while (inicio != fim && classe_caractere(*inicio) == CLASSE_PONTUACAO) {
+                ++inicio;
+            }
+            const wchar_t* final = inicio;
+            bool letra = false;
+            ClasseCaractere classe;
+            while (final != fim && (classe = classe_caractere(*final)) != CLASSE_PONTUACAO) {
+                letra = letra || classe == CLASSE_LETRA;
+                ++final;
+            }
+            if (final != inicio && (letra || !ignorar_numeros)) {
+                emitir(inicio, final);
+            }
+            inicio = final;
+        }
+        return;
+    }
+    if (configuracao & TOKENIZADOR_REMOVER_PONTUACAO) {
+        while (inicio != fim && classe_caractere(*inicio) == CLASSE_PONTUACAO) {
+            ++inicio;
+        }
+        while (fim != inicio && classe_caractere(fim[-1]) == CLASSE_PONTUACAO) {
+            --fim;
+        }
+    }
+    if (inicio == fim) {
+        return;
+    }
+    if (ignorar_numeros) {
+        const wchar_t* caractere = inicio;
+        while (caractere != fim && classe_caractere(*caractere) != CLASSE_LETRA) {
+            ++caractere;
+        }
+        if (caractere == fim) {
+            return;
+        }
+    }
+    emitir(inicio, fim);
+}
+
+/**
+ * \brief Divide um texto em palavras conforme a configuração do tokenizador.
+ *
+ * \param inicio O primeiro caractere do texto.
+ * \param fim O caractere seguinte ao último.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \param emitir Função chamada com o início e o fim de cada palavra, sem conversão para minúsculas.
+ */
+template <typename Emitir>
+inline void percorrer_palavras(const wchar_t* inicio, const wchar_t* fim, std::uint32_t configuracao,
+                               Emitir&& emitir) {
+    const bool dividir = divide_na_pontuacao(configuracao);
+    while (inicio != fim) {
+        while (inicio != fim && classe_caractere(*inicio) == CLASSE_ESPACO) {
+            ++inicio;
+        }
+        const wchar_t* final = inicio;
+        while (final != fim && classe_caractere(*final) != CLASSE_ESPACO) {
+            ++final;
+        }
+        if (final == inicio) {
+            break;
+        }
+        if (dividir) {
+            dividir_palavra(inicio, final, configuracao, emitir);
+        } else {
+            emitir(inicio, final);
+        }
+        inicio = final;
+    }
+}
+
+/**
+ * \brief Função para separar um texto em palavras conforme a configuração do tokenizador.
+ *
+ * \param texto O texto a ser separado.
+ * \param configuracao Os bits de `ConfiguracaoTokenizador`.
+ * \return As palavras, normalizadas por `normalizar_chave`.
+ */
+std::vector<std::wstring> tokenizar(const std::wstring& texto,
+                                   std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+#endif  // TOKENIZADOR_HPP_
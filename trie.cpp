@@ -0,0 +1,569 @@
+/**
+ * \file trie.cpp
+ * \brief Implementação da trie compacta (LOUDS) para consultas por prefixo sobre o vocabulário.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "trie.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "codificacao.hpp"
+#include "conta_palavras.hpp"
+#include "tokenizador.hpp"
+#include "vocabulario.hpp"
+
+/**
+ * \brief Número de palavras de 64 bits por bloco da tabela de `rank`.
+ */
+static const std::size_t PALAVRAS_POR_BLOCO = 8;
+
+/**
+ * \brief Assinatura no início de todo arquivo de trie.
+ */
+static const char ASSINATURA_TRIE[8] = {'C', 'P', 'T', 'R', 'I', 'E', '0', '1'};
+
+/**
+ * \brief Versão do formato do arquivo de trie.
+ */
+static const std::uint32_t VERSAO_TRIE = 1;
+
+/**
+ * \brief Tamanho do cabeçalho do arquivo de trie, em bytes.
+ */
+static const std::size_t TAMANHO_CABECALHO_TRIE = 48;
+
+/**
+ * \brief Calcula o CRC-32 de um arquivo de trie: o conteúdo e o cabeçalho, com o campo do CRC zerado.
+ */
+static std::uint32_t crc_trie(const unsigned char* cabecalho, const unsigned char* conteudo, std::size_t tamanho) {
+    uLong crc = crc32(0, Z_NULL, 0);
+    // A zlib recebe tamanhos de 32 bits; conteúdos maiores são somados em partes
+    while (tamanho > 0) {
+        uInt parte = static_cast<uInt>(std::min<std::size_t>(tamanho, 1u << 30));
+        crc = crc32(crc, conteudo, parte);
+        conteudo += parte;
+        tamanho -= parte;
+    }
+    unsigned char copia[TAMANHO_CABECALHO_TRIE];
+    std::memcpy(copia, cabecalho, sizeof(copia));
+    escrever_u32(copia + 40, 0);
+    return static_cast<std::uint32_t>(crc32(crc, copia, sizeof(copia)));
+}
+
+VetorBits::VetorBits() : tamanho_(0) {}
+
+/**
+ * \brief Acrescenta um bit ao fim do vetor.
+ *
+ * \param bit O valor do bit.
+ */
+void VetorBits::acrescentar(bool bit) {
+    if ((tamanho_ & 63) == 0) {
+        palavras_.push_back(0);
+    }
+    if (bit) {
+        palavras_.back() |= std::uint64_t(1) << (tamanho_ & 63);
+    }
+    ++tamanho_;
+}
+
+/**
+ * \brief Monta a tabela com o número de bits 1 antes de cada bloco, e uma entrada final com o total.
+ */
+void VetorBits::preparar() {
+    palavras_.shrink_to_fit();
+    blocos_.clear();
+    std::uint32_t total = 0;
+    for (std::size_t i = 0; i < palavras_.size(); ++i) {
+        if (i % PALAVRAS_POR_BLOCO == 0) {
+            blocos_.push_back(total);
+        }
+        total += static_cast<std::uint32_t>(__builtin_popcountll(palavras_[i]));
+    }
+    blocos_.push_back(total);
+    blocos_.shrink_to_fit();
+}
+
+/**
+ * \brief Retorna o número de bits 1 nas posições anteriores a `posicao`.
+ *
+ * \param posicao A posição, de zero até o tamanho do vetor.
+ */
+std::size_t VetorBits::rank1(std::size_t posicao) const {
+    std::size_t palavra = posicao >> 6;
+    std::size_t resultado = blocos_[palavra / PALAVRAS_POR_BLOCO];
+    for (std::size_t i = palavra - palavra % PALAVRAS_POR_BLOCO; i < palavra; ++i) {
+        resultado += __builtin_popcountll(palavras_[i]);
+    }
+    if (posicao & 63) {
+        resultado += __builtin_popcountll(palavras_[palavra] & ((std::uint64_t(1) << (posicao & 63)) - 1));
+    }
+    return resultado;
+}
+
+/**
+ * \brief Retorna a posição do k-ésimo bit 0, contando a partir de zero.
+ *
+ * \param k O número do bit 0 procurado; deve existir no vetor.
+ */
+std::size_t VetorBits::select0(std::size_t k) const {
+    // Último bloco com no máximo k bits 0 antes dele
+    std::size_t inicio = 0;
+    std::size_t fim = blocos_.size() - 1;
+    while (fim - inicio > 1) {
+        std::size_t meio = (inicio + fim) / 2;
+        if (meio * PALAVRAS_POR_BLOCO * 64 - blocos_[meio] <= k) {
+            inicio = meio;
+        } else {
+            fim = meio;
+        }
+    }
+    k -= inicio * PALAVRAS_POR_BLOCO * 64 - blocos_[inicio];
+    for (std::size_t i = inicio * PALAVRAS_POR_BLOCO;; ++i) {
+        std::uint64_t zeros = ~palavras_[i];
+        std::size_t quantidade = __builtin_popcountll(zeros);
+        if (k < quantidade) {
+            for (; k > 0; --k) {
+                zeros &= zeros - 1;
+            }
+            return i * 64 + __builtin_ctzll(zeros);
+        }
+        k -= quantidade;
+    }
+}
+
+/**
+ * \brief Retorna a memória ocupada pelo vetor e pela tabela auxiliar, em bytes.
+ */
+std::size_t VetorBits::memoria() const {
+    return palavras_.capacity() * sizeof(std::uint64_t) + blocos_.capacity() * sizeof(std::uint32_t);
+}
+
+/**
+ * \brief Acrescenta as palavras de 64 bits do vetor a um buffer, em little-endian.
+ *
+ * \param destino O buffer.
+ */
+void VetorBits::serializar(std::string& destino) const {
+    for (std::uint64_t palavra : palavras_) {
+        acrescentar_u64(destino, palavra);
+    }
+}
+
+/**
+ * \brief Substitui o conteúdo do vetor pelas palavras de um buffer e prepara a tabela auxiliar.
+ *
+ * Os bits da última palavra depois do fim do vetor são zerados, como os deixa `acrescentar`.
+ *
+ * \param dados As palavras gravadas por `serializar`, `(tamanho + 63) / 64` ao todo.
+ * \param tamanho O número de bits do vetor.
+ */
+void VetorBits::carregar(const unsigned char* dados, std::size_t tamanho) {
+    palavras_.resize((tamanho + 63) / 64);
+    for (std::size_t i = 0; i < palavras_.size(); ++i) {
+        palavras_[i] = ler_u64(dados + 8 * i);
+    }
+    if (tamanho & 63) {
+        palavras_.back() &= (std::uint64_t(1) << (tamanho & 63)) - 1;
+    }
+    tamanho_ = tamanho;
+    preparar();
+}
+
+/**
+ * \brief Constrói a trie a partir de uma contagem.
+ *
+ * \param contagem O mapa contendo as palavras e suas contagens.
+ */
+TrieCompacta::TrieCompacta(const std::map<std::wstring, int>& contagem) {
+    std::vector<std::string> chaves;
+    std::vector<std::uint64_t> contagens;
+    chaves.reserve(contagem.size());
+    contagens.reserve(contagem.size());
+    for (const auto& par : contagem) {
+        chaves.push_back(para_utf8(par.first));
+        contagens.push_back(static_cast<std::uint64_t>(par.second));
+    }
+    construir(chaves, contagens);
+}
+
+/**
+ * \brief Constrói a trie a partir de um instantâneo de vocabulário.
+ *
+ * \param vocabulario O instantâneo.
+ */
+TrieCompacta::TrieCompacta(const Vocabulario& vocabulario) {
+    std::vector<std::string> chaves;
+    std::vector<std::uint64_t> contagens;
+    chaves.reserve(static_cast<std::size_t>(vocabulario.tamanho()));
+    contagens.reserve(static_cast<std::size_t>(vocabulario.tamanho()));
+    for (Vocabulario::Iterador iterador = vocabulario.inicio(); iterador.valido(); iterador.avancar()) {
+        chaves.push_back(iterador.chave());
+        contagens.push_back(iterador.contagem());
+    }
+    construir(chaves, contagens);
+}
+
+/**
+ * \brief Carrega uma trie gravada por `gravar`.
+ *
+ * Além do CRC-32, confere a coerência dos tamanhos: a estrutura tem dois bits por nó e mais um, um
+ * bit 1 por nó, e os terminais têm um bit 1 por palavra. Assim as consultas nunca saem dos vetores.
+ *
+ * \param nome_arquivo O nome do arquivo da trie.
+ * \param crc_vocabulario O CRC-32 do instantâneo de que a trie deve ter sido construída.
+ * \throws std::ios_base::failure Se o arquivo não puder ser lido, não for uma trie válida ou
+ *         tiver sido construído a partir de outro instantâneo.
+ */
+TrieCompacta::TrieCompacta(const std::string& nome_arquivo, std::uint32_t crc_vocabulario) {
+    std::string conteudo = ler_arquivo(nome_arquivo);
+    if (conteudo.size() < TAMANHO_CABECALHO_TRIE) {
+        throw std::ios_base::failure("Arquivo nao e uma trie valida.");
+    }
+    const unsigned char* base = reinterpret_cast<const unsigned char*>(conteudo.data());
+    std::uint64_t palavras = ler_u64(base + 16);
+    std::uint64_t bits_estrutura = ler_u64(base + 24);
+    std::uint64_t nos = ler_u64(base + 32);
+    std::uint64_t disponivel = conteudo.size() - TAMANHO_CABECALHO_TRIE;
+    bool valido = std::memcmp(base, ASSINATURA_TRIE, sizeof(ASSINATURA_TRIE)) == 0 &&
+                  ler_u32(base + 8) == VERSAO_TRIE && nos > 0 && nos <= disponivel &&
+                  bits_estrutura == 2 * nos + 1 && palavras <= nos &&
+                  disponivel == 8 * ((bits_estrutura + 63) / 64) + 8 * ((nos + 63) / 64) + (nos - 1) + 8 * palavras &&
+                  ler_u32(base + 40) == crc_trie(base, base + TAMANHO_CABECALHO_TRIE, disponivel);
+    if (!valido) {
+        throw std::ios_base::failure("Arquivo nao e uma trie valida.");
+    }
+    if (ler_u32(base + 12) != crc_vocabulario) {
+        throw std::ios_base::failure("A trie foi construida a partir de outro vocabulario.");
+    }
+
+    const unsigned char* cursor = base + TAMANHO_CABECALHO_TRIE;
+    estrutura_.carregar(cursor, static_cast<std::size_t>(bits_estrutura));
+    cursor += 8 * ((bits_estrutura + 63) / 64);
+    terminais_.carregar(cursor, static_cast<std::size_t>(nos));
+    cursor += 8 * ((nos + 63) / 64);
+    rotulos_.assign(reinterpret_cast<const char*>(cursor), static_cast<std::size_t>(nos - 1));
+    cursor += nos - 1;
+    contagens_.resize(static_cast<std::size_t>(palavras));
+    for (std::size_t i = 0; i < contagens_.size(); ++i) {
+        contagens_[i] = ler_u64(cursor + 8 * i);
+    }
+    if (estrutura_.rank1(estrutura_.tamanho()) != nos || terminais_.rank1(terminais_.tamanho()) != palavras) {
+        throw std::ios_base::failure("Arquivo nao e uma trie valida.");
+    }
+}
+
+/**
+ * \brief Grava a trie, para que seja carregada sem ser reconstruída.
+ *
+ * O arquivo é escrito em um nome temporário e renomeado, de forma que uma trie incompleta nunca
+ * substitui uma válida.
+ *
+ * \param nome_arquivo O nome do arquivo a ser gravado.
+ * \param crc_vocabulario O CRC-32 do instantâneo de que a trie foi construída.
+ * \throws std::ios_base::failure Se o arquivo não puder ser gravado.
+ */
+void TrieCompacta::gravar(const std::string& nome_arquivo, std::uint32_t crc_vocabulario) const {
+    std::string conteudo;
+    estrutura_.serializar(conteudo);
+    terminais_.serializar(conteudo);
+    conteudo += rotulos_;
+    for (std::uint64_t contagem : contagens_) {
+        acrescentar_u64(conteudo, contagem);
+    }
+
+    unsigned char cabecalho[TAMANHO_CABECALHO_TRIE] = {};
+    std::memcpy(cabecalho, ASSINATURA_TRIE, sizeof(ASSINATURA_TRIE));
+    escrever_u32(cabecalho + 8, VERSAO_TRIE);
+    escrever_u32(cabecalho + 12, crc_vocabulario);
+    escrever_u64(cabecalho + 16, contagens_.size());
+    escrever_u64(cabecalho + 24, estrutura_.tamanho());
+    escrever_u64(cabecalho + 32, terminais_.tamanho());
+    escrever_u32(cabecalho + 40, crc_trie(cabecalho, reinterpret_cast<const unsigned char*>(conteudo.data()),
+                                          conteudo.size()));
+
+    std::string temporario = nome_arquivo + ".tmp";
+    std::ofstream saida(temporario, std::ios::binary | std::ios::trunc);
+    if (!saida.is_open()) {
+        throw std::ios_base::failure("Nao foi possivel criar o arquivo.");
+    }
+    saida.write(reinterpret_cast<const char*>(cabecalho), sizeof(cabecalho));
+    saida.write(conteudo.data(), static_cast<std::streamsize>(conteudo.size()));
+    saida.close();
+    if (!saida || std::rename(temporario.c_str(), nome_arquivo.c_str()) != 0) {
+        std::remove(temporario.c_str());
+        throw std::ios_base::failure("Erro ao gravar a trie.");
+    }
+}
+
+/**
+ * \brief Monta a representação por níveis a partir das palavras em ordem crescente.
+ *
+ * Cada nó corresponde a um intervalo de palavras com um prefixo comum e é visitado em largura.
+ * Para cada nó são gravados um bit 1 por filho seguido de um bit 0; os filhos são os grupos de
+ * palavras do intervalo com o mesmo byte na posição seguinte ao prefixo. A estrutura começa com
+ * "10", a raiz fictícia que aponta para a raiz.
+ *
+ * \param chaves As palavras em UTF-8, em ordem estritamente crescente.
+ * \param contagens As contagens, na mesma ordem.
+ */
+void TrieCompacta::construir(const std::vector<std::string>& chaves,
+                             const std::vector<std::uint64_t>& contagens) {
+    struct Intervalo {
+        std::size_t inicio;
+        std::size_t fim;
+        std::size_t profundidade;
+    };
+    std::queue<Intervalo> fila;
+    fila.push({0, chaves.size(), 0});
+    estrutura_.acrescentar(true);
+    estrutura_.acrescentar(false);
+    while (!fila.empty()) {
+        Intervalo no = fila.front();
+        fila.pop();
+        std::size_t i = no.inicio;
+        // A palavra igual ao prefixo, se houver, é a primeira do intervalo
+        bool terminal = i < no.fim && chaves[i].size() == no.profundidade;
+        terminais_.acrescentar(terminal);
+        if (terminal) {
+            contagens_.push_back(contagens[i]);
+            ++i;
+        }
+        while (i < no.fim) {
+            char rotulo = chaves[i][no.profundidade];
+            std::size_t j = i + 1;
+            while (j < no.fim && chaves[j][no.profundidade] == rotulo) {
+                ++j;
+            }
+            estrutura_.acrescentar(true);
+            rotulos_ += rotulo;
+            fila.push({i, j, no.profundidade + 1});
+            i = j;
+        }
+        estrutura_.acrescentar(false);
+    }
+    estrutura_.preparar();
+    terminais_.preparar();
+    rotulos_.shrink_to_fit();
+    contagens_.shrink_to_fit();
+}
+
+/**
+ * \brief Localiza os filhos de um nó: seus números são consecutivos.
+ *
+ * \param no O número do nó, na ordem em largura (a raiz é zero).
+ * \param primeiro O número do primeiro filho.
+ * \param quantidade O número de filhos.
+ */
+void TrieCompacta::filhos(std::size_t no, std::size_t& primeiro, std::size_t& quantidade) const {
+    std::size_t inicio = estrutura_.select0(no) + 1;
+    primeiro = estrutura_.rank1(inicio);
+    quantidade = 0;
+    while (estrutura_[inicio + quantidade]) {
+        ++quantidade;
+    }
+}
+
+/**
+ * \brief Retorna o filho de um nó pela aresta com o rótulo informado, ou `NENHUM`.
+ *
+ * Os rótulos dos filhos estão em ordem crescente, então a busca para no primeiro rótulo maior.
+ */
+std::size_t TrieCompacta::filho(std::size_t no, unsigned char rotulo) const {
+    std::size_t primeiro;
+    std::size_t quantidade;
+    filhos(no, primeiro, quantidade);
+    for (std::size_t i = primeiro; i < primeiro + quantidade; ++i) {
+        unsigned char atual = static_cast<unsigned char>(rotulos_[i - 1]);
+        if (atual == rotulo) {
+            return i;
+        }
+        if (atual > rotulo) {
+            break;
+        }
+    }
+    return NENHUM;
+}
+
+/**
+ * \brief Retorna a contagem de uma palavra.
+ *
+ * \param chave A palavra em UTF-8.
+ * \return A contagem, ou zero se a palavra não estiver na trie.
+ */
+std::uint64_t TrieCompacta::contagem(const std::string& chave) const {
+    std::size_t no = 0;
+    for (char byte : chave) {
+        no = filho(no, static_cast<unsigned char>(byte));
+        if (no == NENHUM) {
+            return 0;
+        }
+    }
+    return terminais_[no] ? contagem_no(no) : 0;
+}
+
+/**
+ * \brief Enumera, em ordem crescente de bytes UTF-8, as palavras que começam com um prefixo.
+ *
+ * Desce até o nó do prefixo e percorre a subárvore em profundidade, com uma pilha explícita; como
+ * os filhos estão em ordem de rótulo, a pré-ordem é a ordem crescente das palavras.
+ *
+ * \param prefixo O prefixo em UTF-8; vazio enumera todas as palavras.
+ * \param limite O número máximo de palavras; zero não limita.
+ * \return As palavras, em UTF-8, e suas contagens.
+ */
+TrieCompacta::Resultados TrieCompacta::prefixo(const std::string& prefixo, std::size_t limite) const {
+    Resultados resultados;
+    std::size_t no = 0;
+    for (char byte : prefixo) {
+        no = filho(no, static_cast<unsigned char>(byte));
+        if (no == NENHUM) {
+            return resultados;
+        }
+    }
+
+    std::string chave = prefixo;
+    std::vector<std::pair<std::size_t, std::size_t>> pilha;  // (nó, tamanho da chave sem o rótulo)
+    pilha.emplace_back(no, chave.size());
+    bool raiz = true;
+    while (!pilha.empty() && (limite == 0 || resultados.size() < limite)) {
+        no = pilha.back().first;
+        chave.resize(pilha.back().second);
+        pilha.pop_back();
+        if (!raiz) {
+            chave += rotulos_[no - 1];
+        }
+        raiz = false;
+        if (terminais_[no]) {
+            resultados.emplace_back(chave, contagem_no(no));
+        }
+        std::size_t primeiro;
+        std::size_t quantidade;
+        filhos(no, primeiro, quantidade);
+        for (std::size_t i = primeiro + quantidade; i > primeiro; --i) {
+            pilha.emplace_back(i - 1, chave.size());
+        }
+    }
+    return resultados;
+}
+
+/**
+ * \brief Busca as palavras iguais a uma palavra quando os acentos são ignorados.
+ *
+ * A trie é percorrida caractere a caractere: as arestas de um caractere de vários bytes são
+ * seguidas até completá-lo, e só então ele é comparado, sem acentos, com o caractere procurado.
+ * As marcas combinantes da trie são puladas, como `remover_acentos` as retira da palavra.
+ *
+ * \param palavra A palavra procurada, com ou sem acentos.
+ * \return As palavras encontradas, em ordem, e suas contagens.
+ */
+TrieCompacta::Resultados TrieCompacta::buscar_sem_acentos(const std::wstring& palavra) const {
+    Resultados resultados;
+    std::string chave;
+    buscar_sem_acentos(0, remover_acentos(palavra), 0, chave, resultados);
+    return resultados;
+}
+
+/**
+ * \brief Continua a busca sem acentos a partir de um nó no início de um caractere.
+ *
+ * Depois do último caractere procurado, só as marcas combinantes que o seguem na trie ainda são
+ * percorridas.
+ */
+void TrieCompacta::buscar_sem_acentos(std::size_t no, const std::wstring& alvo, std::size_t indice,
+                                      std::string& chave, Resultados& resultados) const {
+    if (indice == alvo.size() && terminais_[no]) {
+        resultados.emplace_back(chave, contagem_no(no));
+    }
+    std::size_t primeiro;
+    std::size_t quantidade;
+    filhos(no, primeiro, quantidade);
+    for (std::size_t i = primeiro; i < primeiro + quantidade; ++i) {
+        unsigned char byte = static_cast<unsigned char>(rotulos_[i - 1]);
+        chave += static_cast<char>(byte);
+        if (byte < 0x80) {
+            // Caracteres ASCII não têm acento: a comparação é direta
+            if (indice < alvo.size() && static_cast<wchar_t>(byte) == alvo[indice]) {
+                buscar_sem_acentos(i, alvo, indice + 1, chave, resultados);
+            }
+        } else if (byte >= 0xC0) {
+            int restantes = byte >= 0xF0 ? 3 : byte >= 0xE0 ? 2 : 1;
+            buscar_caractere(i, byte & (0x3F >> restantes), restantes, alvo, indice, chave, resultados);
+        }
+        chave.pop_back();
+    }
+}
+
+/**
+ * \brief Segue os bytes de continuação de um caractere e o compara, sem acentos, com o procurado.
+ *
+ * Uma marca combinante, que `remover_acento` descarta, não consome nenhum caractere procurado.
+ */
+void TrieCompacta::buscar_caractere(std::size_t no, std::uint32_t ponto, int restantes,
+                                    const std::wstring& alvo, std::size_t indice, std::string& chave,
+                                    Resultados& resultados) const {
+    if (restantes == 0) {
+        wchar_t base = remover_acento(static_cast<wchar_t>(ponto));
+        if (base == 0) {
+            buscar_sem_acentos(no, alvo, indice, chave, resultados);
+        } else if (indice < alvo.size() && base == alvo[indice]) {
+            buscar_sem_acentos(no, alvo, indice + 1, chave, resultados);
+        }
+        return;
+    }
+    std::size_t primeiro;
+    std::size_t quantidade;
+    filhos(no, primeiro, quantidade);
+    for (std::size_t i = primeiro; i < primeiro + quantidade; ++i) {
+        unsigned char byte = static_cast<unsigned char>(rotulos_[i - 1]);
+        chave += static_cast<char>(byte);
+        buscar_caractere(i, (ponto << 6) | (byte & 0x3F), restantes - 1, alvo, indice, chave, resultados);
+        chave.pop_back();
+    }
+}
+
+/**
+ * \brief Retorna a memória ocupada pela trie, em bytes.
+ */
+std::size_t TrieCompacta::memoria() const {
+    return sizeof(*this) + estrutura_.memoria() + terminais_.memoria() + rotulos_.capacity() +
+           contagens_.capacity() * sizeof(std::uint64_t);
+}
+
+/**
+ * \brief Carrega a trie gravada ao lado de um instantâneo, ou a constrói e a grava.
+ *
+ * \param vocabulario O instantâneo.
+ * \param nome_vocabulario O nome do arquivo do instantâneo.
+ * \return A trie do instantâneo.
+ */
+TrieCompacta carregar_trie(const Vocabulario& vocabulario, const std::string& nome_vocabulario) {
+    const std::string nome_trie = nome_vocabulario + ".trie";
+    try {
+        return TrieCompacta(nome_trie, vocabulario.crc());
+    } catch (const std::ios_base::failure&) {
+        // Trie ausente, corrompida ou de outro conteúdo: reconstruída abaixo
+    }
+    TrieCompacta trie(vocabulario);
+    try {
+        trie.gravar(nome_trie, vocabulario.crc());
+    } catch (const std::ios_base::failure&) {
+        // Sem a trie gravada, a próxima consulta apenas a reconstrói
+    }
+    return trie;
+}
@@ -0,0 +1,212 @@
+/**
+ * \file trie.hpp
+ * \brief Definições da trie compacta (LOUDS) para consultas por prefixo sobre o vocabulário.
+ *
+ * Este arquivo contém as declarações de um vetor de bits com `rank` e `select` e da trie compacta
+ * construída a partir do vocabulário ordenado. A trie é representada por níveis (LOUDS: Level-Order
+ * Unary Degree Sequence): cada nó ocupa dois bits da estrutura e um byte de rótulo, e os prefixos
+ * comuns às palavras são guardados uma única vez. As arestas são os bytes UTF-8 das palavras.
+ *
+ * A trie de um instantâneo pode ser gravada ao lado dele, para que as consultas seguintes a
+ * carreguem em vez de reconstruí-la. Layout do arquivo (inteiros em little-endian):
+ * - Cabeçalho de 48 bytes: assinatura "CPTRIE01", versão, CRC-32 do instantâneo de origem, número
+ *   de palavras, bits da estrutura, bits dos terminais e CRC-32 do restante do arquivo e do próprio
+ *   cabeçalho (com o campo do CRC zerado).
+ * - Palavras de 64 bits da estrutura e dos terminais, os rótulos (um byte por nó, exceto a raiz) e
+ *   as contagens, 8 bytes por palavra, na ordem dos nós terminais.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef TRIE_HPP_
+#define TRIE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vocabulario.hpp"
+
+/**
+ * \brief Vetor de bits somente de acréscimo, com consultas de `rank` e `select` após `preparar`.
+ *
+ * Guarda, a cada 512 bits, o número de bits 1 anteriores: `rank1` custa uma consulta à tabela e
+ * até oito contagens de população, e `select0` uma busca binária na tabela seguida de uma
+ * varredura de no máximo oito palavras.
+ */
+class VetorBits {
+ public:
+    VetorBits();
+
+    /**
+     * \brief Acrescenta um bit ao fim do vetor.
+     */
+    void acrescentar(bool bit);
+
+    /**
+     * \brief Monta a tabela auxiliar; deve ser chamada depois do último acréscimo.
+     */
+    void preparar();
+
+    /**
+     * \brief Retorna o bit em uma posição.
+     */
+    bool operator[](std::size_t posicao) const { return (palavras_[posicao >> 6] >> (posicao & 63)) & 1; }
+
+    /**
+     * \brief Retorna o número de bits no vetor.
+     */
+    std::size_t tamanho() const { return tamanho_; }
+
+    /**
+     * \brief Retorna o número de bits 1 nas posições anteriores a `posicao`.
+     */
+    std::size_t rank1(std::size_t posicao) const;
+
+    /**
+     * \brief Retorna a posição do k-ésimo bit 0, contando a partir de zero.
+     */
+    std::size_t select0(std::size_t k) const;
+
+    /**
+     * \brief Retorna a memória ocupada pelo vetor e pela tabela auxiliar, em bytes.
+     */
+    std::size_t memoria() const;
+
+    /**
+     * \brief Acrescenta as palavras de 64 bits do vetor a um buffer, em little-endian.
+     */
+    void serializar(std::string& destino) const;
+
+    /**
+     * \brief Substitui o conteúdo do vetor pelas palavras de um buffer e prepara a tabela auxiliar.
+     *
+     * \param dados As palavras gravadas por `serializar`.
+     * \param tamanho O número de bits do vetor.
+     */
+    void carregar(const unsigned char* dados, std::size_t tamanho);
+
+ private:
+    std::vector<std::uint64_t> palavras_;
+    std::vector<std::uint32_t> blocos_;
+    std::size_t tamanho_;
+};
+
+/**
+ * \brief Trie compacta e imutável sobre um vocabulário ordenado.
+ *
+ * Responde à contagem de uma palavra, enumera em ordem as palavras que começam com um prefixo e
+ * busca palavras ignorando acentos, conforme `remover_acentos`. Ocupa uma fração da memória de
+ * um vetor de `std::wstring`, pois cada prefixo comum é guardado uma só vez e cada nó custa um
+ * byte de rótulo e pouco mais de dois bits de estrutura.
+ */
+class TrieCompacta {
+ public:
+    typedef std::vector<std::pair<std::string, std::uint64_t>> Resultados;
+
+    /**
+     * \brief Constrói a trie a partir de uma contagem.
+     *
+     * \param contagem O mapa contendo as palavras e suas contagens.
+     */
+    explicit TrieCompacta(const std::map<std::wstring, int>& contagem);
+
+    /**
+     * \brief Constrói a trie a partir de um instantâneo de vocabulário.
+     *
+     * \param vocabulario O instantâneo.
+     */
+    explicit TrieCompacta(const Vocabulario& vocabulario);
+
+    /**
+     * \brief Carrega uma trie gravada por `gravar`.
+     *
+     * \param nome_arquivo O nome do arquivo da trie.
+     * \param crc_vocabulario O CRC-32 do instantâneo de que a trie deve ter sido construída.
+     * \throws std::ios_base::failure Se o arquivo não puder ser lido, não for uma trie válida ou
+     *         tiver sido construído a partir de outro instantâneo.
+     */
+    TrieCompacta(const std::string& nome_arquivo, std::uint32_t crc_vocabulario);
+
+    /**
+     * \brief Grava a trie, para que seja carregada sem ser reconstruída.
+     *
+     * \param nome_arquivo O nome do arquivo a ser gravado.
+     * \param crc_vocabulario O CRC-32 do instantâneo de que a trie foi construída.
+     * \throws std::ios_base::failure Se o arquivo não puder ser gravado.
+     */
+    void gravar(const std::string& nome_arquivo, std::uint32_t crc_vocabulario) const;
+
+    /**
+     * \brief Retorna o número de palavras na trie.
+     */
+    std::size_t tamanho() const { return contagens_.size(); }
+
+    /**
+     * \brief Retorna a contagem de uma palavra.
+     *
+     * \param chave A palavra em UTF-8.
+     * \return A contagem, ou zero se a palavra não estiver na trie.
+     */
+    std::uint64_t contagem(const std::string& chave) const;
+
+    /**
+     * \brief Enumera, em ordem crescente de bytes UTF-8, as palavras que começam com um prefixo.
+     *
+     * \param prefixo O prefixo em UTF-8; vazio enumera todas as palavras.
+     * \param limite O número máximo de palavras; zero não limita.
+     * \return As palavras, em UTF-8, e suas contagens.
+     */
+    Resultados prefixo(const std::string& prefixo, std::size_t limite = 0) const;
+
+    /**
+     * \brief Busca as palavras iguais a uma palavra quando os acentos são ignorados.
+     *
+     * Acentos pré-compostos e marcas combinantes (as palavras na forma NFD) são ignorados tanto na
+     * palavra procurada quanto nas palavras da trie.
+     *
+     * \param palavra A palavra procurada, com ou sem acentos.
+     * \return As palavras encontradas, em ordem, e suas contagens.
+     */
+    Resultados buscar_sem_acentos(const std::wstring& palavra) const;
+
+    /**
+     * \brief Retorna a memória ocupada pela trie, em bytes.
+     */
+    std::size_t memoria() const;
+
+ private:
+    void construir(const std::vector<std::string>& chaves, const std::vector<std::uint64_t>& contagens);
+    std::size_t filho(std::size_t no, unsigned char rotulo) const;
+    void filhos(std::size_t no, std::size_t& primeiro, std::size_t& quantidade) const;
+    std::uint64_t contagem_no(std::size_t no) const { return contagens_[terminais_.rank1(no)]; }
+    void buscar_sem_acentos(std::size_t no, const std::wstring& alvo, std::size_t indice,
+                            std::string& chave, Resultados& resultados) const;
+    void buscar_caractere(std::size_t no, std::uint32_t ponto, int restantes, const std::wstring& alvo,
+                          std::size_t indice, std::string& chave, Resultados& resultados) const;
+
+    static const std::size_t NENHUM = static_cast<std::size_t>(-1);
+
+    VetorBits estrutura_;
+    VetorBits terminais_;
+    std::string rotulos_;
+    std::vector<std::uint64_t> contagens_;
+};
+
+/**
+ * \brief Carrega a trie gravada ao lado de um instantâneo, ou a constrói e a grava.
+ *
+ * A trie fica em `nome_vocabulario` seguido de ".trie" e é reconstruída quando não existe, está
+ * corrompida ou foi construída a partir de outro conteúdo do instantâneo. Uma falha ao gravá-la,
+ * como em um diretório somente de leitura, não impede a consulta.
+ *
+ * \param vocabulario O instantâneo.
+ * \param nome_vocabulario O nome do arquivo do instantâneo.
+ * \return A trie do instantâneo.
+ */
+TrieCompacta carregar_trie(const Vocabulario& vocabulario, const std::string& nome_vocabulario);
+
+#endif  // TRIE_HPP_
@@ -0,0 +1,561 @@
+/**
+ * \file vocabulario.cpp
+ * \brief Implementação do formato binário para gravar e carregar a contagem de palavras.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#include "vocabulario.hpp"
+
+#include <sys/mman.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ios>
+#include <map>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "codificacao.hpp"
+#include "conta_palavras.hpp"
+
+/**
+ * \brief Assinatura gravada no início de todo instantâneo.
+ */
+static const char ASSINATURA_VOCABULARIO[8] = {'C', 'P', 'V', 'O', 'C', 'A', 'B', '1'};
+
+/**
+ * \brief Versão do formato gravada no cabeçalho.
+ */
+static const std::uint32_t VERSAO_VOCABULARIO = 2;
+
+/**
+ * \brief Tamanho do cabeçalho, em bytes.
+ */
+static const std::size_t TAMANHO_CABECALHO = 64;
+
+/**
+ * \brief Quantidade de bytes acumulada antes de uma escrita no arquivo.
+ */
+static const std::size_t TAMANHO_BUFFER_ESCRITA = 1 << 20;
+
+/**
+ * \brief Função para converter uma palavra para UTF-8.
+ *
+ * \param palavra A palavra em caracteres largos.
+ * \return A palavra codificada em UTF-8.
+ */
+std::string para_utf8(const std::wstring& palavra) {
+    std::string resultado;
+    resultado.reserve(palavra.size());
+    for (wchar_t caractere : palavra) {
+        std::uint32_t c = static_cast<std::uint32_t>(caractere);
+        if (c < 0x80) {
+            resultado += static_cast<char>(c);
+        } else if (c < 0x800) {
+            resultado += static_cast<char>(0xC0 | (c >> 6));
+            resultado += static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            resultado += static_cast<char>(0xE0 | (c >> 12));
+            resultado += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            resultado += static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            resultado += static_cast<char>(0xF0 | (c >> 18));
+            resultado += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            resultado += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            resultado += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return resultado;
+}
+
+/**
+ * \brief Função para converter uma palavra de UTF-8 para caracteres largos.
+ *
+ * Segue as mesmas regras de `ContadorIncremental`: bytes de continuação soltos, inícios
+ * inexistentes, sequências interrompidas, formas longas demais, substitutos e pontos acima de
+ * U+10FFFF viram o caractere de substituição U+FFFD.
+ *
+ * \param palavra A palavra em UTF-8.
+ * \return A palavra em caracteres largos.
+ */
+std::wstring de_utf8(const std::string& palavra) {
+    std::wstring resultado;
+    resultado.reserve(palavra.size());
+    std::size_t i = 0;
+    while (i < palavra.size()) {
+        unsigned char c = static_cast<unsigned char>(palavra[i++]);
+        if (c < 0x80) {
+            resultado += static_cast<wchar_t>(c);
+            continue;
+        }
+        int restantes;
+        std::uint32_t ponto;
+        std::uint32_t minimo;
+        if (c >= 0xC2 && c <= 0xDF) {
+            restantes = 1;
+            ponto = c & 0x1F;
+            minimo = 0x80;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            restantes = 2;
+            ponto = c & 0x0F;
+            minimo = 0x800;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            restantes = 3;
+            ponto = c & 0x07;
+            minimo = 0x10000;
+        } else {
+            // Byte de continuação solto ou início que não existe no UTF-8
+            resultado += static_cast<wchar_t>(0xFFFD);
+            continue;
+        }
+        // Uma sequência interrompida vira um U+FFFD, e o byte que a interrompeu é lido de novo
+        for (; restantes > 0 && i < palavra.size() && (palavra[i] & 0xC0) == 0x80; --restantes, ++i) {
+            ponto = (ponto << 6) | (palavra[i] & 0x3F);
+        }
+        bool invalido = restantes > 0 || ponto < minimo || ponto > 0x10FFFF || (ponto >= 0xD800 && ponto <= 0xDFFF);
+        resultado += invalido ? static_cast<wchar_t>(0xFFFD) : static_cast<wchar_t>(ponto);
+    }
+    return resultado;
+}
+
+/**
+ * \brief Começa a gravar um instantâneo.
+ *
+ * O espaço do cabeçalho é reservado agora e preenchido em `concluir`, quando os totais são
+ * conhecidos.
+ *
+ * \param nome_arquivo O nome do arquivo a ser gravado.
+ * \param configuracao A configuração do tokenizador que produziu a contagem.
+ * \throws std::ios_base::failure Se o arquivo não puder ser criado.
+ */
+EscritorVocabulario::EscritorVocabulario(const std::string& nome_arquivo, std::uint32_t configuracao)
+    : nome_(nome_arquivo), nome_temporario_(nome_arquivo + ".tmp"), configuracao_(configuracao),
+      crc_(crc32(0, Z_NULL, 0)), entradas_(0), ocorrencias_(0), bytes_entradas_(0),
+      concluido_(false) {
+    saida_.open(nome_temporario_, std::ios::binary | std::ios::trunc);
+    if (!saida_.is_open()) {
+        throw std::ios_base::failure("Nao foi possivel criar o arquivo.");
+    }
+    char cabecalho[TAMANHO_CABECALHO] = {};
+    saida_.write(cabecalho, sizeof(cabecalho));
+    buffer_.reserve(TAMANHO_BUFFER_ESCRITA + 64);
+}
+
+EscritorVocabulario::~EscritorVocabulario() {
+    if (!concluido_) {
+        saida_.close();
+        std::remove(nome_temporario_.c_str());
+    }
+}
+
+/**
+ * \brief Adiciona uma entrada ao instantâneo.
+ *
+ * \param chave A palavra em UTF-8, maior que a da entrada anterior.
+ * \param contagem O número de ocorrências da palavra.
+ * \throws std::invalid_argument Se a palavra não estiver em ordem crescente.
+ * \throws std::ios_base::failure Se ocorrer um erro de escrita.
+ */
+void EscritorVocabulario::adicionar(const std::string& chave, std::uint64_t contagem) {
+    if (entradas_ > 0 && chave <= chave_anterior_) {
+        throw std::invalid_argument("Palavras fora de ordem no vocabulario.");
+    }
+
+    std::size_t compartilhado = 0;
+    if (entradas_ % INTERVALO_REINICIO_PADRAO == 0) {
+        reinicios_.push_back(bytes_entradas_);
+    } else {
+        std::size_t limite = std::min(chave.size(), chave_anterior_.size());
+        while (compartilhado < limite && chave[compartilhado] == chave_anterior_[compartilhado]) {
+            ++compartilhado;
+        }
+    }
+
+    std::size_t antes = buffer_.size();
+    acrescentar_varint(buffer_, compartilhado);
+    acrescentar_varint(buffer_, chave.size() - compartilhado);
+    buffer_.append(chave, compartilhado, std::string::npos);
+    acrescentar_varint(buffer_, contagem);
+    bytes_entradas_ += buffer_.size() - antes;
+
+    chave_anterior_ = chave;
+    ++entradas_;
+    ocorrencias_ += contagem;
+    if (buffer_.size() >= TAMANHO_BUFFER_ESCRITA) {
+        descarregar();
+    }
+}
+
+/**
+ * \brief Escreve o conteúdo acumulado no arquivo, atualizando o CRC-32.
+ *
+ * \throws std::ios_base::failure Se ocorrer um erro de escrita.
+ */
+void EscritorVocabulario::descarregar() {
+    crc_ = crc32(crc_, reinterpret_cast<const Bytef*>(buffer_.data()),
+                 static_cast<uInt>(buffer_.size()));
+    saida_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    if (!saida_) {
+        throw std::ios_base::failure("Erro ao gravar o vocabulario.");
+    }
+    buffer_.clear();
+}
+
+/**
+ * \brief Grava o índice e o cabeçalho e publica o arquivo com o nome definitivo.
+ *
+ * \throws std::ios_base::failure Se ocorrer um erro de escrita.
+ */
+void EscritorVocabulario::concluir() {
+    unsigned char valor[8];
+    for (std::uint64_t deslocamento : reinicios_) {
+        escrever_u64(valor, deslocamento);
+        buffer_.append(reinterpret_cast<const char*>(valor), sizeof(valor));
+    }
+    descarregar();
+
+    unsigned char cabecalho[TAMANHO_CABECALHO] = {};
+    std::memcpy(cabecalho, ASSINATURA_VOCABULARIO, sizeof(ASSINATURA_VOCABULARIO));
+    escrever_u32(cabecalho + 8, VERSAO_VOCABULARIO);
+    escrever_u32(cabecalho + 12, configuracao_);
+    escrever_u64(cabecalho + 16, entradas_);
+    escrever_u64(cabecalho + 24, ocorrencias_);
+    escrever_u64(cabecalho + 32, bytes_entradas_);
+    escrever_u32(cabecalho + 40, INTERVALO_REINICIO_PADRAO);
+    // O CRC-32 termina no cabeçalho, com o próprio campo do CRC ainda zerado
+    crc_ = crc32(crc_, cabecalho, sizeof(cabecalho));
+    escrever_u32(cabecalho + 44, crc_);
+    saida_.seekp(0);
+    saida_.write(reinterpret_cast<const char*>(cabecalho), sizeof(cabecalho));
+    saida_.close();
+    if (!saida_ || std::rename(nome_temporario_.c_str(), nome_.c_str()) != 0) {
+        throw std::ios_base::failure("Erro ao gravar o vocabulario.");
+    }
+    concluido_ = true;
+}
+
+/**
+ * \brief Função para gravar uma contagem de palavras como instantâneo de vocabulário.
+ *
+ * A ordem do mapa (por ponto de código) coincide com a ordem dos bytes UTF-8, então as entradas
+ * são gravadas na ordem em que são percorridas.
+ *
+ * \param contagem O mapa contendo as palavras e suas contagens.
+ * \param nome_arquivo O nome do arquivo a ser gravado.
+ * \param configuracao A configuração do tokenizador que produziu a contagem.
+ * \throws std::ios_base::failure Se o arquivo não puder ser gravado.
+ */
+void gravar_vocabulario(const std::map<std::wstring, int>& contagem, const std::string& nome_arquivo,
+                        std::uint32_t configuracao) {
+    EscritorVocabulario escritor(nome_arquivo, configuracao);
+    for (const auto& par : contagem) {
+        escritor.adicionar(para_utf8(par.first), static_cast<std::uint64_t>(par.second));
+    }
+    escritor.concluir();
+}
+
+/**
+ * \brief Mapeia um instantâneo na memória.
+ *
+ * O cabeçalho é conferido (assinatura, versão e a coerência dos tamanhos com o tamanho do
+ * arquivo) e o CRC-32 é recalculado, de forma que um instantâneo corrompido nunca é consultado,
+ * servido ou mesclado. As entradas são decodificadas sob demanda.
+ *
+ * \param nome_arquivo O nome do arquivo do instantâneo.
+ * \throws std::ios_base::failure Se o arquivo não puder ser aberto, não for um instantâneo válido
+ *         ou estiver corrompido.
+ */
+Vocabulario::Vocabulario(const std::string& nome_arquivo)
+    : mapeamento_(MAP_FAILED), tamanho_mapeamento_(0) {
+    Arquivo arquivo = abrir_arquivo(nome_arquivo);
+    tamanho_mapeamento_ = arquivo.tamanho();
+    if (tamanho_mapeamento_ < TAMANHO_CABECALHO) {
+        throw std::ios_base::failure("Arquivo nao e um vocabulario valido.");
+    }
+    mapeamento_ = ::mmap(nullptr, tamanho_mapeamento_, PROT_READ, MAP_PRIVATE,
+                         arquivo.descritor(), 0);
+    if (mapeamento_ == MAP_FAILED) {
+        throw std::ios_base::failure("Nao foi possivel mapear o vocabulario.");
+    }
+
+    const unsigned char* base = static_cast<const unsigned char*>(mapeamento_);
+    entradas_ = ler_u64(base + 16);
+    ocorrencias_ = ler_u64(base + 24);
+    std::uint64_t bytes_entradas = ler_u64(base + 32);
+    configuracao_ = ler_u32(base + 12);
+    intervalo_reinicio_ = ler_u32(base + 40);
+    crc_ = ler_u32(base + 44);
+
+    bool valido = std::memcmp(base, ASSINATURA_VOCABULARIO, sizeof(ASSINATURA_VOCABULARIO)) == 0 &&
+                  ler_u32(base + 8) == VERSAO_VOCABULARIO && intervalo_reinicio_ > 0 &&
+                  bytes_entradas <= tamanho_mapeamento_ - TAMANHO_CABECALHO;
+    if (valido) {
+        blocos_ = (entradas_ + intervalo_reinicio_ - 1) / intervalo_reinicio_;
+        valido = (tamanho_mapeamento_ - TAMANHO_CABECALHO - bytes_entradas) / 8 == blocos_ &&
+                 (tamanho_mapeamento_ - TAMANHO_CABECALHO - bytes_entradas) % 8 == 0;
+    }
+    if (!valido) {
+        ::munmap(mapeamento_, tamanho_mapeamento_);
+        throw std::ios_base::failure("Arquivo nao e um vocabulario valido.");
+    }
+    entradas_inicio_ = base + TAMANHO_CABECALHO;
+    entradas_fim_ = entradas_inicio_ + bytes_entradas;
+    indice_ = entradas_fim_;
+    if (!verificar()) {
+        ::munmap(mapeamento_, tamanho_mapeamento_);
+        throw std::ios_base::failure("Instantaneo de vocabulario corrompido.");
+    }
+}
+
+Vocabulario::~Vocabulario() {
+    ::munmap(mapeamento_, tamanho_mapeamento_);
+}
+
+/**
+ * \brief Confere o CRC-32 de todo o instantâneo.
+ *
+ * O CRC-32 cobre as entradas e o índice, seguidos do cabeçalho com o campo do CRC zerado.
+ *
+ * \return Verdadeiro se o conteúdo corresponde ao CRC-32 do cabeçalho.
+ */
+bool Vocabulario::verificar() const {
+    const unsigned char* base = static_cast<const unsigned char*>(mapeamento_);
+    uLong crc = crc32(0, Z_NULL, 0);
+    std::size_t restante = tamanho_mapeamento_ - TAMANHO_CABECALHO;
+    const unsigned char* cursor = base + TAMANHO_CABECALHO;
+    // A zlib recebe tamanhos de 32 bits; arquivos maiores são conferidos em partes
+    while (restante > 0) {
+        uInt parte = static_cast<uInt>(std::min<std::size_t>(restante, 1u << 30));
+        crc = crc32(crc, cursor, parte);
+        cursor += parte;
+        restante -= parte;
+    }
+    unsigned char cabecalho[TAMANHO_CABECALHO];
+    std::memcpy(cabecalho, base, sizeof(cabecalho));
+    escrever_u32(cabecalho + 44, 0);
+    crc = crc32(crc, cabecalho, sizeof(cabecalho));
+    return static_cast<std::uint32_t>(crc) == crc_;
+}
+
+/**
+ * \brief Retorna o deslocamento da primeira entrada de um bloco de reinício.
+ *
+ * \throws std::ios_base::failure Se o deslocamento estiver fora da seção de entradas.
+ */
+std::uint64_t Vocabulario::reinicio(std::uint64_t bloco) const {
+    std::uint64_t deslocamento = ler_u64(indice_ + 8 * bloco);
+    if (deslocamento >= static_cast<std::uint64_t>(entradas_fim_ - entradas_inicio_)) {
+        throw std::ios_base::failure("Instantaneo de vocabulario corrompido.");
+    }
+    return deslocamento;
+}
+
+/**
+ * \brief Retorna a contagem de uma palavra.
+ *
+ * \param chave A palavra em UTF-8.
+ * \return A contagem da palavra, ou zero se ela não estiver no vocabulário.
+ */
+std::uint64_t Vocabulario::contagem(const std::string& chave) const {
+    Iterador iterador = limite_inferior(chave);
+    return iterador.valido() && iterador.chave() == chave ? iterador.contagem() : 0;
+}
+
+/**
+ * \brief Retorna um iterador para a primeira entrada maior ou igual à chave.
+ *
+ * A busca binária usa apenas a primeira palavra de cada bloco, que é gravada por inteiro e pode
+ * ser comparada sem decodificar as anteriores.
+ *
+ * \param chave A palavra em UTF-8.
+ */
+Vocabulario::Iterador Vocabulario::limite_inferior(const std::string& chave) const {
+    // Último bloco cuja primeira palavra é menor ou igual à chave
+    std::uint64_t baixo = 0;
+    std::uint64_t alto = blocos_;
+    while (alto - baixo > 1) {
+        std::uint64_t meio = baixo + (alto - baixo) / 2;
+        const unsigned char* cursor = entradas_inicio_ + reinicio(meio);
+        ler_varint(cursor, entradas_fim_);
+        std::uint64_t tamanho = ler_varint(cursor, entradas_fim_);
+        if (tamanho > static_cast<std::uint64_t>(entradas_fim_ - cursor)) {
+            throw std::ios_base::failure("Instantaneo de vocabulario corrompido.");
+        }
+        std::size_t comparar = std::min<std::size_t>(tamanho, chave.size());
+        int ordem = std::memcmp(cursor, chave.data(), comparar);
+        if (ordem < 0 || (ordem == 0 && tamanho <= chave.size())) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+
+    Iterador iterador(this, baixo);
+    while (iterador.valido() && iterador.chave() < chave) {
+        iterador.avancar();
+    }
+    return iterador;
+}
+
+/**
+ * \brief Converte o instantâneo de volta para um mapa de contagens.
+ */
+std::map<std::wstring, int> Vocabulario::para_mapa() const {
+    std::map<std::wstring, int> contagem;
+    for (Iterador iterador = inicio(); iterador.valido(); iterador.avancar()) {
+        contagem.emplace_hint(contagem.end(), de_utf8(iterador.chave()),
+                              static_cast<int>(iterador.contagem()));
+    }
+    return contagem;
+}
+
+/**
+ * \brief Posiciona o iterador na primeira entrada de um bloco de reinício.
+ */
+Vocabulario::Iterador::Iterador(const Vocabulario* vocabulario, std::uint64_t bloco)
+    : vocabulario_(vocabulario), cursor_(nullptr), contagem_(0),
+      posicao_(bloco * vocabulario->intervalo_reinicio_), valido_(false) {
+    if (bloco < vocabulario_->blocos_) {
+        cursor_ = vocabulario_->entradas_inicio_ + vocabulario_->reinicio(bloco);
+        decodificar();
+    }
+}
+
+/**
+ * \brief Avança para a próxima entrada.
+ *
+ * \throws std::ios_base::failure Se a entrada estiver corrompida.
+ */
+void Vocabulario::Iterador::avancar() {
+    ++posicao_;
+    decodificar();
+}
+
+/**
+ * \brief Decodifica a entrada na posição atual a partir do prefixo compartilhado e do sufixo.
+ *
+ * \throws std::ios_base::failure Se a entrada estiver corrompida.
+ */
+void Vocabulario::Iterador::decodificar() {
+    valido_ = posicao_ < vocabulario_->entradas_;
+    if (!valido_) {
+        return;
+    }
+    const unsigned char* fim = vocabulario_->entradas_fim_;
+    std::uint64_t compartilhado = ler_varint(cursor_, fim);
+    std::uint64_t sufixo = ler_varint(cursor_, fim);
+    if (compartilhado > chave_.size() || sufixo > static_cast<std::uint64_t>(fim - cursor_)) {
+        throw std::ios_base::failure("Instantaneo de vocabulario corrompido.");
+    }
+    chave_.resize(compartilhado);
+    chave_.append(reinterpret_cast<const char*>(cursor_), sufixo);
+    cursor_ += sufixo;
+    contagem_ = ler_varint(cursor_, fim);
+}
+
+/**
+ * \brief Função para mesclar vários instantâneos de vocabulário em um só.
+ *
+ * Um heap mínimo guarda o índice do instantâneo cuja entrada atual é a menor. A cada passo, todas
+ * as entradas com a menor palavra são somadas e seus iteradores avançam.
+ *
+ * \param entradas Os nomes dos instantâneos a serem mesclados.
+ * \param nome_arquivo O nome do instantâneo resultante.
+ * \return O número de palavras distintas do instantâneo resultante.
+ * \throws std::ios_base::failure Se algum instantâneo não puder ser lido ou o resultado gravado.
+ * \throws std::invalid_argument Se os instantâneos foram produzidos com configurações diferentes.
+ */
+std::uint64_t mesclar_vocabularios(const std::vector<std::string>& entradas,
+                                   const std::string& nome_arquivo) {
+    std::vector<std::unique_ptr<Vocabulario>> vocabularios;
+    std::vector<Vocabulario::Iterador> iteradores;
+    std::uint32_t configuracao = CONFIGURACAO_PADRAO;
+    for (const auto& entrada : entradas) {
+        vocabularios.emplace_back(new Vocabulario(entrada));
+        if (vocabularios.size() == 1) {
+            configuracao = vocabularios.back()->configuracao();
+        } else if (vocabularios.back()->configuracao() != configuracao) {
+            throw std::invalid_argument("Vocabularios com configuracoes diferentes.");
+        }
+        iteradores.push_back(vocabularios.back()->inicio());
+    }
+
+    auto maior = [&iteradores](std::size_t a, std::size_t b) {
+        return iteradores[a].chave() > iteradores[b].chave();
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(maior)> heap(maior);
+    for (std::size_t i = 0; i < iteradores.size(); ++i) {
+        if (iteradores[i].valido()) {
+            heap.push(i);
+        }
+    }
+
+    EscritorVocabulario escritor(nome_arquivo, configuracao);
+    std::string chave;
+    while (!heap.empty()) {
+        std::size_t menor = heap.top();
+        heap.pop();
+        chave = iteradores[menor].chave();
+        std::uint64_t soma = iteradores[menor].contagem();
+        iteradores[menor].avancar();
+        if (iteradores[menor].valido()) {
+            heap.push(menor);
+        }
+        while (!heap.empty() && iteradores[heap.top()].chave() == chave) {
+            std::size_t igual = heap.top();
+            heap.pop();
+            soma += iteradores[igual].contagem();
+            iteradores[igual].avancar();
+            if (iteradores[igual].valido()) {
+                heap.push(igual);
+            }
+        }
+        escritor.adicionar(chave, soma);
+    }
+    escritor.concluir();
+    return escritor.entradas();
+}
+
+/**
+ * \brief Função para obter as palavras mais frequentes de um instantâneo.
+ *
+ * Usa um heap com as k melhores entradas vistas até o momento, cujo topo é a pior delas.
+ *
+ * \param vocabulario O instantâneo.
+ * \param k O número de palavras desejado; zero retorna todas.
+ * \return As palavras, em UTF-8, e suas contagens.
+ */
+std::vector<std::pair<std::string, std::uint64_t>> mais_frequentes(const Vocabulario& vocabulario,
+                                                                   std::size_t k) {
+    typedef std::pair<std::string, std::uint64_t> Entrada;
+    if (k == 0 || k > vocabulario.tamanho()) {
+        k = static_cast<std::size_t>(vocabulario.tamanho());
+    }
+    // Maior contagem primeiro; empates em ordem alfabética
+    auto melhor = [](const Entrada& a, const Entrada& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+
+    std::vector<Entrada> heap;
+    heap.reserve(k);
+    for (Vocabulario::Iterador iterador = vocabulario.inicio(); k > 0 && iterador.valido();
+         iterador.avancar()) {
+        if (heap.size() < k) {
+            heap.emplace_back(iterador.chave(), iterador.contagem());
+            std::push_heap(heap.begin(), heap.end(), melhor);
+        } else if (iterador.contagem() > heap.front().second) {
+            // Chaves crescem na iteração: um empate nunca supera a pior entrada do heap
+            std::pop_heap(heap.begin(), heap.end(), melhor);
+            heap.back() = Entrada(iterador.chave(), iterador.contagem());
+            std::push_heap(heap.begin(), heap.end(), melhor);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), melhor);
+    return heap;
+}
@@ -0,0 +1,313 @@
+/**
+ * \file vocabulario.hpp
+ * \brief Definições do formato binário para gravar e carregar a contagem de palavras.
+ *
+ * Este arquivo contém as declarações do gravador e do leitor do instantâneo de vocabulário: um
+ * arquivo compacto com as palavras em ordem, codificadas com prefixo compartilhado, e as contagens
+ * em varint. O arquivo é mapeado na memória ao ser carregado, de forma que consultas repetidas
+ * sobre o mesmo corpus não precisam ler, decodificar e contar o texto de novo.
+ *
+ * Layout do arquivo (inteiros em little-endian):
+ * - Cabeçalho de 64 bytes: assinatura "CPVOCAB1", versão, configuração do tokenizador, número de
+ *   entradas, total de ocorrências, tamanho da seção de entradas, intervalo de reinício e CRC-32
+ *   das seções seguintes e do próprio cabeçalho (com o campo do CRC zerado).
+ * - Entradas, em ordem crescente de bytes UTF-8: varint do prefixo compartilhado com a palavra
+ *   anterior, varint do tamanho do sufixo, bytes do sufixo e varint da contagem. A cada
+ *   `intervalo_reinicio` entradas o prefixo compartilhado é zero.
+ * - Índice de reinício: deslocamento de 64 bits, dentro da seção de entradas, de cada entrada em
+ *   que o prefixo é zero, usado na busca binária.
+ *
+ * \copyright 2025 Alexandre
+ */
+
+#ifndef VOCABULARIO_HPP_
+#define VOCABULARIO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tokenizador.hpp"
+
+/**
+ * \brief Número de entradas entre dois pontos de reinício da codificação por prefixo.
+ */
+const std::uint32_t INTERVALO_REINICIO_PADRAO = 16;
+
+/**
+ * \brief Função para converter uma palavra para UTF-8.
+ *
+ * \param palavra A palavra em caracteres largos.
+ * \return A palavra codificada em UTF-8.
+ */
+std::string para_utf8(const std::wstring& palavra);
+
+/**
+ * \brief Função para converter uma palavra de UTF-8 para caracteres largos.
+ *
+ * \param palavra A palavra em UTF-8.
+ * \return A palavra em caracteres largos.
+ */
+std::wstring de_utf8(const std::string& palavra);
+
+/**
+ * \brief Gravador em fluxo de um instantâneo de vocabulário.
+ *
+ * As entradas devem ser adicionadas em ordem estritamente crescente de bytes UTF-8. O arquivo é
+ * escrito em um nome temporário e renomeado em `concluir`, de forma que um instantâneo
+ * incompleto nunca substitui um válido. A memória usada não depende do número de entradas, exceto
+ * pelo índice de reinício (8 bytes a cada `INTERVALO_REINICIO_PADRAO` entradas).
+ */
+class EscritorVocabulario {
+ public:
+    /**
+     * \brief Começa a gravar um instantâneo.
+     *
+     * \param nome_arquivo O nome do arquivo a ser gravado.
+     * \param configuracao A configuração do tokenizador que produziu a contagem.
+     * \throws std::ios_base::failure Se o arquivo não puder ser criado.
+     */
+    EscritorVocabulario(const std::string& nome_arquivo, std::uint32_t configuracao);
+    ~EscritorVocabulario();
+
+    EscritorVocabulario(const EscritorVocabulario&) = delete;
+    EscritorVocabulario& operator=(const EscritorVocabulario&) = delete;
+
+    /**
+     * \brief Adiciona uma entrada ao instantâneo.
+     *
+     * \param chave A palavra em UTF-8, maior que a da entrada anterior.
+     * \param contagem O número de ocorrências da palavra.
+     * \throws std::invalid_argument Se a palavra não estiver em ordem crescente.
+     * \throws std::ios_base::failure Se ocorrer um erro de escrita.
+     */
+    void adicionar(const std::string& chave, std::uint64_t contagem);
+
+    /**
+     * \brief Grava o índice e o cabeçalho e publica o arquivo com o nome definitivo.
+     *
+     * \throws std::ios_base::failure Se ocorrer um erro de escrita.
+     */
+    void concluir();
+
+    /**
+     * \brief Retorna o número de entradas adicionadas até o momento.
+     */
+    std::uint64_t entradas() const { return entradas_; }
+
+ private:
+    void descarregar();
+
+    std::string nome_;
+    std::string nome_temporario_;
+    std::ofstream saida_;
+    std::string buffer_;
+    std::string chave_anterior_;
+    std::vector<std::uint64_t> reinicios_;
+    std::uint32_t configuracao_;
+    std::uint32_t crc_;
+    std::uint64_t entradas_;
+    std::uint64_t ocorrencias_;
+    std::uint64_t bytes_entradas_;
+    bool concluido_;
+};
+
+/**
+ * \brief Função para gravar uma contagem de palavras como instantâneo de vocabulário.
+ *
+ * \param contagem O mapa contendo as palavras e suas contagens.
+ * \param nome_arquivo O nome do arquivo a ser gravado.
+ * \param configuracao A configuração do tokenizador que produziu a contagem.
+ * \throws std::ios_base::failure Se o arquivo não puder ser gravado.
+ */
+void gravar_vocabulario(const std::map<std::wstring, int>& contagem, const std::string& nome_arquivo,
+                        std::uint32_t configuracao = CONFIGURACAO_PADRAO);
+
+/**
+ * \brief Instantâneo de vocabulário mapeado na memória, somente para leitura.
+ *
+ * Carregar o instantâneo mapeia o arquivo e confere o cabeçalho e o CRC-32; as entradas são
+ * decodificadas sob demanda. Buscas usam o índice de reinício para uma busca binária seguida de
+ * uma varredura de no máximo `intervalo_reinicio` entradas.
+ */
+class Vocabulario {
+ public:
+    /**
+     * \brief Posição de leitura sequencial das entradas, em ordem crescente.
+     */
+    class Iterador {
+     public:
+        /**
+         * \brief Indica se o iterador aponta para uma entrada.
+         */
+        bool valido() const { return valido_; }
+
+        /**
+         * \brief Avança para a próxima entrada.
+         */
+        void avancar();
+
+        /**
+         * \brief Retorna a palavra da entrada atual, em UTF-8.
+         */
+        const std::string& chave() const { return chave_; }
+
+        /**
+         * \brief Retorna a contagem da entrada atual.
+         */
+        std::uint64_t contagem() const { return contagem_; }
+
+        /**
+         * \brief Retorna a posição (ordem) da entrada atual no vocabulário.
+         */
+        std::uint64_t posicao() const { return posicao_; }
+
+     private:
+        friend class Vocabulario;
+        Iterador(const Vocabulario* vocabulario, std::uint64_t bloco);
+        void decodificar();
+
+        const Vocabulario* vocabulario_;
+        const unsigned char* cursor_;
+        std::string chave_;
+        std::uint64_t contagem_;
+        std::uint64_t posicao_;
+        bool valido_;
+    };
+
+    /**
+     * \brief Mapeia um instantâneo na memória.
+     *
+     * \param nome_arquivo O nome do arquivo do instantâneo.
+     * \throws std::ios_base::failure Se o arquivo não puder ser aberto ou não for um instantâneo válido.
+     */
+    explicit Vocabulario(const std::string& nome_arquivo);
+    ~Vocabulario();
+
+    Vocabulario(const Vocabulario&) = delete;
+    Vocabulario& operator=(const Vocabulario&) = delete;
+
+    /**
+     * \brief Confere o CRC-32 de todo o instantâneo, incluindo o cabeçalho.
+     *
+     * O construtor já faz essa conferência; ela fica disponível para instantâneos que possam ter
+     * sido alterados depois de mapeados.
+     *
+     * \return Verdadeiro se o conteúdo corresponde ao CRC-32 do cabeçalho.
+     */
+    bool verificar() const;
+
+    /**
+     * \brief Retorna o número de palavras distintas.
+     */
+    std::uint64_t tamanho() const { return entradas_; }
+
+    /**
+     * \brief Retorna a soma das contagens de todas as palavras.
+     */
+    std::uint64_t total_ocorrencias() const { return ocorrencias_; }
+
+    /**
+     * \brief Retorna a configuração do tokenizador gravada no cabeçalho.
+     */
+    std::uint32_t configuracao() const { return configuracao_; }
+
+    /**
+     * \brief Retorna o CRC-32 gravado no cabeçalho, que identifica o conteúdo do instantâneo.
+     */
+    std::uint32_t crc() const { return crc_; }
+
+    /**
+     * \brief Retorna a contagem de uma palavra.
+     *
+     * \param chave A palavra em UTF-8.
+     * \return A contagem da palavra, ou zero se ela não estiver no vocabulário.
+     */
+    std::uint64_t contagem(const std::string& chave) const;
+
+    /**
+     * \brief Retorna a contagem de uma palavra.
+     *
+     * \param palavra A palavra em caracteres largos.
+     * \return A contagem da palavra, ou zero se ela não estiver no vocabulário.
+     */
+    std::uint64_t contagem(const std::wstring& palavra) const { return contagem(para_utf8(palavra)); }
+
+    /**
+     * \brief Converte uma palavra de consulta para a chave do instantâneo.
+     *
+     * \param palavra A palavra em UTF-8, como digitada.
+     * \return A chave em UTF-8, normalizada com a configuração gravada no cabeçalho.
+     */
+    std::string chave_consulta(const std::string& palavra) const {
+        return para_utf8(normalizar_consulta(de_utf8(palavra), configuracao_));
+    }
+
+    /**
+     * \brief Retorna um iterador para a primeira entrada.
+     */
+    Iterador inicio() const { return Iterador(this, 0); }
+
+    /**
+     * \brief Retorna um iterador para a primeira entrada maior ou igual à chave.
+     *
+     * \param chave A palavra em UTF-8.
+     */
+    Iterador limite_inferior(const std::string& chave) const;
+
+    /**
+     * \brief Converte o instantâneo de volta para um mapa de contagens.
+     */
+    std::map<std::wstring, int> para_mapa() const;
+
+ private:
+    std::uint64_t reinicio(std::uint64_t bloco) const;
+
+    void* mapeamento_;
+    std::size_t tamanho_mapeamento_;
+    const unsigned char* entradas_inicio_;
+    const unsigned char* entradas_fim_;
+    const unsigned char* indice_;
+    std::uint64_t entradas_;
+    std::uint64_t ocorrencias_;
+    std::uint64_t blocos_;
+    std::uint32_t configuracao_;
+    std::uint32_t intervalo_reinicio_;
+    std::uint32_t crc_;
+};
+
+/**
+ * \brief Função para mesclar vários instantâneos de vocabulário em um só.
+ *
+ * Faz uma intercalação de k vias sobre os instantâneos já ordenados, somando as contagens das
+ * palavras repetidas, e grava o resultado em fluxo. O tempo é proporcional ao total de entradas e
+ * a memória usada depende apenas do número de instantâneos, não do tamanho do vocabulário.
+ *
+ * \param entradas Os nomes dos instantâneos a serem mesclados.
+ * \param nome_arquivo O nome do instantâneo resultante.
+ * \return O número de palavras distintas do instantâneo resultante.
+ * \throws std::ios_base::failure Se algum instantâneo não puder ser lido ou o resultado gravado.
+ * \throws std::invalid_argument Se os instantâneos foram produzidos com configurações diferentes.
+ */
+std::uint64_t mesclar_vocabularios(const std::vector<std::string>& entradas,
+                                   const std::string& nome_arquivo);
+
+/**
+ * \brief Função para obter as palavras mais frequentes de um instantâneo.
+ *
+ * Percorre o instantâneo uma vez mantendo apenas as k melhores entradas, de forma que a memória
+ * usada depende de k e não do tamanho do vocabulário. A ordem é a de `mais_frequentes`: maior
+ * contagem primeiro e, em caso de empate, ordem alfabética.
+ *
+ * \param vocabulario O instantâneo.
+ * \param k O número de palavras desejado; zero retorna todas.
+ * \return As palavras, em UTF-8, e suas contagens.
+ */
+std::vector<std::pair<std::string, std::uint64_t>> mais_frequentes(const Vocabulario& vocabulario,
+                                                                   std::size_t k);
+
+#endif  // VOCABULARIO_HPP_